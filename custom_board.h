@@ -9,8 +9,14 @@
 extern "C" {
 #endif
     
+/// Name of device, it is in GAP service and scan response
+#define DEVICE_NAME                     "sq device"
+
 /**< TX Power Level value. */
 #define TX_POWER_LEVEL  (-8)  
+
+/// Count of centrals connected at the same time, RAM of SoftDevice is reserved for every link
+#define PERIPHERAL_LINK_MAX             3
     
     
 #define ADC_INPUT_CHANNEL_NUM        NRF_SAADC_INPUT_AIN3    
@@ -19,6 +25,22 @@ extern "C" {
 #define LEDS_ACTIVE_STATE               1
 /// Flag, that indicates using led
 #define LED_INDICATE                    1
+/// Flag, that enables counters of energy accounting, see my_energy_manager.h
+#define ENERGY_ACCOUNTING               1
+/// Flag, that enables binary log of hot handlers, see my_log_manager.h
+#define BINARY_LOG                      1
+/// Flag, that enables event trace in retained RAM, see my_trace_manager.h
+#define EVENT_TRACE                     1
+/// Flag, that enables runtime statistics characteristic, see my_stats_manager.h
+#define RUNTIME_STATS                   1
+/// Flag, that enables broadcast of sensor values in advertising, see my_broadcast_manager.h
+#define ADV_BROADCAST                   1
+/// Flag, that enables control of TX power by RSSI of links, see my_link_manager.h
+#define TX_POWER_CONTROL                1
+/// Flag, that enables sampling before connection events, see my_radio_manager.h
+#define RADIO_SYNC                      1
+/// Flag, that enables sync of time with central and stamps of samples, see my_time_manager.h
+#define TIME_SYNC                       1
     
 /// LED status stored in this bit in OUT_REG2    
 #define LED_BIT_NUMBER               (1 << 4)
@@ -26,10 +48,14 @@ extern "C" {
 /// BUTTON status stored in this bit in INPUT_REG
 #define BUT_SHORT_BIT_NUMBER               (1 << 0)
 #define BUT_LONG_BIT_NUMBER                (1 << 1)
+#define BUT_DOUBLE_BIT_NUMBER              (1 << 2)
+#define BUT_REPEAT_BIT_NUMBER              (1 << 3)
 
     
 /// USED PIN NUMBERS, other pins defined in @ref out_reg1_pin_numbers and @ref out_reg2_pin_numbers
 #define BUTTON_PIN_NUMBER               26
+/// Level of button pin in pressed state
+#define BUTTON_ACTIVE_STATE             0
 #define LED_PIN_NUMBER                  25
 
 #define ADC_INPUT_HIGH_SIDE_PIN_NUMBER  24
@@ -37,12 +63,17 @@ extern "C" {
         
     
 #define APP_TIMER_PRESCALER             0                                           /**< Value of the RTC1 PRESCALER register. */
-#define APP_TIMER_OP_QUEUE_SIZE         5                                           /**< Size of timer operation queues. */
+#define APP_TIMER_OP_QUEUE_SIZE         8                                           /**< Size of timer operation queues. */
         // 1 - adc_timer
-        // 2 - bat_notification_timer
-        // 3 - led_timer
-        // 4 - button timer
+        // 2 - led_timer
+        // 3 - input debounce timer
+        // 4 - storage delayed write timer
+        // 5 - boot deferred init timer
+        // 6 - broadcast rate limit timer
+        // 7 - time wrap timer
+        // 8 - connection parameters update timer of ble_conn_params
 #define BATTERY_LEVEL_MEAS_INTERVAL       APP_TIMER_TICKS(120000, APP_TIMER_PRESCALER) /**< Battery level measurement interval (ticks). This value corresponds to 120 seconds. */
+#define BROADCAST_MEAS_INTERVAL           APP_TIMER_TICKS(10000, APP_TIMER_PRESCALER)  /**< ADC measurement interval for broadcast in advertising (ticks). This value corresponds to 10 seconds. */
     
 // Low frequency clock source to be used by the SoftDevice
 #define NRF_CLOCK_LFCLKSRC      {.source        = NRF_CLOCK_LF_SRC_XTAL,            \
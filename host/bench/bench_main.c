@@ -0,0 +1,662 @@
+/**
+    @brief Micro-benchmarks of hot paths of application on fake SoftDevice.
+
+    Usage: nrfblesq_bench [options]
+        --json FILE         write results in format of Google Benchmark
+        --baseline FILE     compare estimated M4 cycles with results in FILE
+        --threshold PCT     allowed slowdown against baseline, percent (25),
+                            slowdown less than BENCH_GATE_MIN_CYCLES is always allowed
+        --min-time-ms N     min time of one repetition (50)
+        --filter TEXT       run only benchmarks with TEXT in name
+        --recheck NAMES     names of regressions found by previous process, comma separated
+        --run N             number of process in gate (1)
+
+    Boot phases of main() are measured first, on several starts of application
+    from reset. Every other benchmark runs on initialized and connected
+    application, so paths go through the same modules as on target. Iterations are doubled until
+    repetition takes min time, the median of BENCH_REPETITIONS is reported.
+
+    Gate fails only on regression found again by every of BENCH_GATE_RUNS
+    processes, each measures all benchmarks (--recheck). Speed of memory of
+    shared host differs between processes, cold paths as boot follow it.
+
+    Host time is related to Cortex-M4 cycles by linear model:
+        m4_cycles = (host_ns - calls * fake_call_ns) * m4_cycles_per_ns + calls * M4_SVC_CYCLES
+    where calls are recorded calls of SoftDevice and drivers, fake_call_ns is
+    host cost of recording one call and m4_cycles_per_ns is calibrated by
+    kernel with known count of M4 cycles.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <getopt.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sdk_stub.h"
+#include "nrf_drv_saadc.h"
+#include "my_boot_manager.h"
+#include "my_gpio_manager.h"
+#include "my_log_manager.h"
+#include "my_ring_manager.h"
+#include "my_rssi_manager.h"
+#include "my_stats_manager.h"
+#include "my_trace_manager.h"
+#include "sq_service_handler.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define BENCH_TICKS_PER_MS(MS)  ((uint32_t)(((uint64_t)(MS) * 32768U) / 1000U))
+#define BENCH_CONN_HANDLE       0U
+#define BENCH_REPETITIONS       15U
+#define BENCH_GATE_MIN_CYCLES   50U     /**< slowdown below 1 us on target is host noise */
+#define BENCH_GATE_RUNS         3U      /**< processes which must find regression */
+#define BENCH_MAX_COUNT         32U
+#define BENCH_NAME_MAX          48U
+
+/// UUIDs of characteristics of sq_service.c
+#define BENCH_OUT1_UUID         0x02
+#define BENCH_ADC_UUID          0x0F
+#define BENCH_IN_EVT_UUID       0x40
+
+/// Cortex-M4 cost model
+#define M4_CALIB_CYCLES_PER_ITER    4U      /**< MLA 1, SUBS 1, BNE taken 2 (1 + refill from cache) */
+#define M4_SVC_CYCLES               40U     /**< SVC entry and return, dispatch in SoftDevice */
+#define M4_CALIB_ITERATIONS         (50U * 1000U * 1000U)
+#define M4_CYCLES_PER_US            64U
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/**@brief Body of benchmark, it runs given count of iterations. */
+typedef void (*bench_fn_t)(uint64_t iterations);
+
+typedef struct {
+    const char * name;
+    bench_fn_t   fn;
+} bench_t;
+
+/**
+    @brief Result of one benchmark
+*/
+typedef struct {
+    char     name[BENCH_NAME_MAX];
+    uint64_t iterations;
+    double   ns;                        /**< host time of iteration */
+    double   calls;                     /**< recorded calls of SoftDevice and drivers in iteration */
+    double   m4_cycles;                 /**< estimate for target */
+} bench_result_t;
+
+static uint16_t m_out1_handle;
+static uint32_t m_min_time_ms = 50;
+static const char * mp_filter = NULL;
+
+static double m_m4_cycles_per_ns;
+static double m_fake_call_ns;
+
+/// Names of boot phases of my_boot_manager.h in results
+static const char * const m_boot_phase_names[] = {
+    "Log", "Timers", "Gpio", "Input", "Stack", "Storage", "PeerManager",
+    "Gap", "Advertising", "Services", "ConnParams", "AdvStart", "Deferred"
+};
+STATIC_ASSERT(ARRAY_SIZE(m_boot_phase_names) == BOOT_PHASE_COUNT);
+
+static bench_result_t m_results[BENCH_MAX_COUNT];
+static uint32_t       m_result_count = 0;
+static bool           m_regressed[BENCH_MAX_COUNT];     /**< regression found by previous processes */
+
+static jmp_buf m_run_end;
+static bool    m_run_done = false;
+
+/// keeps results of benchmarks alive
+static volatile uint32_t m_sink;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+int app_main(void);
+
+static uint64_t now_ns(void);
+static uint32_t calib_kernel(uint32_t iterations);
+static void cost_model_calibrate(void);
+static void result_print(bench_result_t const * p_result);
+static void bench_run(bench_t const * p_bench);
+static int value_compare(void const * p_a, void const * p_b);
+static int ns_compare(void const * p_a, void const * p_b);
+static void boot_idle(void);
+static void boot_run(void);
+static void bench_session(void);
+static bool json_write(const char * p_file_name);
+static bool baseline_check(const char * p_file_name, uint32_t threshold_pct, bool recheck);
+static void regressed_mark(const char * p_names);
+static void recheck_exec(int argc, char * argv[], uint32_t run);
+
+static uint64_t now_ns(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+/** @brief Chain of dependent multiply-adds, one MLA per iteration on M4
+*/
+static __attribute__((noinline)) uint32_t calib_kernel(uint32_t iterations) {
+
+    uint32_t x = iterations;
+
+    while (iterations-- != 0) {
+        x = x * 1664525U + 1013904223U;
+        __asm__ volatile("" : "+r"(x));
+    }
+    return x;
+}
+
+/**
+    @brief Scale of host time to M4 cycles and host cost of recorded call
+*/
+static void cost_model_calibrate(void) {
+
+    double best = 0;
+
+    for (uint32_t r = 0; r < BENCH_REPETITIONS; r++) {
+        uint64_t start = now_ns();
+        m_sink = calib_kernel(M4_CALIB_ITERATIONS);
+        double ns = (double)(now_ns() - start);
+        if ((best == 0) || (ns < best))
+            best = ns;
+    }
+    m_m4_cycles_per_ns = (double)M4_CALIB_ITERATIONS * M4_CALIB_CYCLES_PER_ITER / best;
+
+    best = 0;
+    for (uint32_t r = 0; r < BENCH_REPETITIONS; r++) {
+        uint8_t  data[4] = {0};
+        uint64_t start   = now_ns();
+        for (uint32_t i = 0; i < 100000U; i++)
+            fake_call_record("bench", BENCH_CONN_HANDLE, 0, data, sizeof(data), NRF_SUCCESS);
+        double ns = (double)(now_ns() - start) / 100000U;
+        if ((best == 0) || (ns < best))
+            best = ns;
+    }
+    m_fake_call_ns = best;
+    fake_calls_clear();
+}
+
+/* ==================================================================== */
+/* ============================ benchmarks ============================ */
+/* ==================================================================== */
+
+static void bm_rssi_push_get(uint64_t iterations) {
+
+    uint32_t sum = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        my_rssi_push_value(BENCH_CONN_HANDLE, (int8_t)(-40 - (int8_t)(i & 0x1F)));
+        sum += (uint8_t)my_rssi_get_value(BENCH_CONN_HANDLE);
+    }
+    m_sink = sum;
+}
+
+/** @brief Conversion as on target: sample, DONE event, handler converts and notifies
+*/
+static void bm_saadc_conversion(uint64_t iterations) {
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        int16_t values[2] = {853, (int16_t)(i & 0x3FF)};
+        fake_saadc_values_set(values, 2);
+        m_sink = nrf_drv_saadc_sample();
+        fake_events_process();
+        fake_ble_evt_tx_complete(BENCH_CONN_HANDLE, 0);
+        fake_events_process();
+    }
+}
+
+static void bm_gpio_out_change_state(uint64_t iterations) {
+
+    for (uint64_t i = 0; i < iterations; i++)
+        my_gpio_out_change_state(GPIO_OUT_REG1, (uint8_t)(i & 0x01));
+}
+
+/** @brief Write of output register decoded by sq service
+*/
+static void bm_sqs_write_decode(uint64_t iterations) {
+
+    ble_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                       = BLE_GATTS_EVT_WRITE;
+    evt.evt.gatts_evt.conn_handle           = BENCH_CONN_HANDLE;
+    evt.evt.gatts_evt.params.write.handle   = m_out1_handle;
+    evt.evt.gatts_evt.params.write.op       = BLE_GATTS_OP_WRITE_REQ;
+    evt.evt.gatts_evt.params.write.len      = 1;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        evt.evt.gatts_evt.params.write.data[0] = (uint8_t)(i & 0x01);
+        sq_on_ble_evt(&evt);
+    }
+}
+
+/** @brief Event passed by ble_evt_dispatch() to every module
+*/
+static void bm_ble_evt_dispatch(uint64_t iterations) {
+
+    ble_evt_handler_t handler = fake_ble_evt_handler_get();
+    ble_evt_t         evt;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                           = BLE_EVT_TX_COMPLETE;
+    evt.evt.common_evt.conn_handle              = BENCH_CONN_HANDLE;
+    evt.evt.common_evt.params.tx_complete.count = 1;
+
+    for (uint64_t i = 0; i < iterations; i++)
+        handler(&evt);
+}
+
+/** @brief Input event pushed to FIFO and sent in notification
+*/
+static void bm_input_event_notify(uint64_t iterations) {
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        sq_service_push_input_event((uint8_t)(i & 0x01), SQ_INPUT_EVT_CODE(0, 1));
+        sq_service_input_events_flush();
+        fake_ble_evt_tx_complete(BENCH_CONN_HANDLE, 0);
+        fake_events_process();
+    }
+}
+
+/** @brief Record of binary log with 2 arguments, ring is emptied without sending
+*/
+static void bm_log_write(uint64_t iterations) {
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        if ((i & 0x7F) == 0)
+            my_log_init();
+        MY_LOG("bench %d %d", (uint32_t)i, 1);
+    }
+}
+
+/** @brief Record of event trace with id and value
+*/
+static void bm_trace_record(uint64_t iterations) {
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        MY_TRACE_VALUE(TRACE_POINT_ADC_MV, (uint32_t)i);
+    }
+}
+
+/** @brief Exclusive increment of counter of runtime statistics
+*/
+static void bm_stats_increment(uint64_t iterations) {
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        MY_STATS_INC(STATS_COUNTER_BLE_EVENTS);
+    }
+}
+
+/** @brief Bulk push of 4 words and pop of them, as record of binary log
+*/
+static void bm_ring_push_pop(uint64_t iterations) {
+
+    static uint32_t buf[64];
+    uint32_t        words[4] = {0};
+    my_ring_t       ring;
+
+    (void)my_ring_init(&ring, buf, sizeof(uint32_t), 64);
+    for (uint64_t i = 0; i < iterations; i++) {
+        words[0] = (uint32_t)i;
+        (void)my_ring_push(&ring, words, 4);
+        (void)my_ring_pop(&ring, words, 4);
+    }
+    m_sink = words[0];
+}
+
+static const bench_t m_benchmarks[] = {
+    {"BM_RssiPushGet",          bm_rssi_push_get},
+    {"BM_SaadcConversion",      bm_saadc_conversion},
+    {"BM_GpioOutChangeState",   bm_gpio_out_change_state},
+    {"BM_SqsWriteDecode",       bm_sqs_write_decode},
+    {"BM_BleEvtDispatch",       bm_ble_evt_dispatch},
+    {"BM_InputEventNotify",     bm_input_event_notify},
+    {"BM_LogWrite",             bm_log_write},
+    {"BM_TraceRecord",          bm_trace_record},
+    {"BM_StatsIncrement",       bm_stats_increment},
+    {"BM_RingPushPop",          bm_ring_push_pop},
+};
+
+/* ==================================================================== */
+/* ============================== runner ============================== */
+/* ==================================================================== */
+
+static void bench_run(bench_t const * p_bench) {
+
+    bench_result_t * p_result = &m_results[m_result_count++];
+    uint64_t         iterations = 1;
+    double           ns[BENCH_REPETITIONS];
+    double           calls = 0;
+
+    /// iterations for min time
+    for (;;) {
+        uint64_t start = now_ns();
+        p_bench->fn(iterations);
+        if ((now_ns() - start) >= (uint64_t)m_min_time_ms * 1000000U)
+            break;
+        iterations *= 2;
+    }
+
+    for (uint32_t r = 0; r < BENCH_REPETITIONS; r++) {
+        uint32_t calls_start = fake_calls_total();
+        uint64_t start       = now_ns();
+        p_bench->fn(iterations);
+        ns[r] = (double)(now_ns() - start) / (double)iterations;
+
+        calls = (double)(fake_calls_total() - calls_start) / (double)iterations;
+    }
+    qsort(ns, BENCH_REPETITIONS, sizeof(double), ns_compare);
+
+    double median_ns = ns[BENCH_REPETITIONS / 2];
+    double app_ns    = median_ns - calls * m_fake_call_ns;
+    if (app_ns < 0)
+        app_ns = 0;
+
+    snprintf(p_result->name, sizeof(p_result->name), "%s", p_bench->name);
+    p_result->iterations = iterations;
+    p_result->ns         = median_ns;
+    p_result->calls      = calls;
+    p_result->m4_cycles  = app_ns * m_m4_cycles_per_ns + calls * M4_SVC_CYCLES;
+
+    result_print(p_result);
+}
+
+static void result_print(bench_result_t const * p_result) {
+
+    printf("%-28s %12.1f ns %8.2f calls %10.0f M4 cycles %12llu iterations\n", p_result->name,
+           p_result->ns, p_result->calls, p_result->m4_cycles, (unsigned long long)p_result->iterations);
+}
+
+static int value_compare(void const * p_a, void const * p_b) {
+
+    uint32_t a = *(uint32_t const *)p_a;
+    uint32_t b = *(uint32_t const *)p_b;
+    return (a > b) - (a < b);
+}
+
+static int ns_compare(void const * p_a, void const * p_b) {
+
+    double a = *(double const *)p_a;
+    double b = *(double const *)p_b;
+    return (a > b) - (a < b);
+}
+
+/**
+    @brief Boot ends by deferred init after first advertising event
+*/
+static void boot_idle(void) {
+
+    fake_time_advance(BENCH_TICKS_PER_MS(1500));
+    longjmp(m_run_end, 1);
+}
+
+/**
+    @brief Boot phases of main() from reset on fake SoftDevice, reported by
+           my_boot_phase_us_get() as on target. DWT counts host time of code
+           scaled by cost model, recorded calls aren't separated. Median of
+           repetitions is reported, time is from start of main().
+*/
+static void boot_run(void) {
+
+    static uint32_t us[BOOT_PHASE_COUNT][BENCH_REPETITIONS];
+
+    fake_dwt_host_clock_set(m_m4_cycles_per_ns);
+    for (uint32_t r = 0; r < BENCH_REPETITIONS; r++) {
+        fake_reset();
+        fake_idle_hook_set(boot_idle);
+        if (setjmp(m_run_end) == 0)
+            app_main();
+        for (uint32_t phase = 0; phase < BOOT_PHASE_COUNT; phase++)
+            us[phase][r] = my_boot_phase_us_get(my_boot_record_get(), (boot_phase_t)phase);
+    }
+    fake_dwt_host_clock_set(0);
+
+    for (uint32_t phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        bench_result_t result;
+
+        snprintf(result.name, sizeof(result.name), "BM_Boot/%s", m_boot_phase_names[phase]);
+        if ((mp_filter != NULL) && (strstr(result.name, mp_filter) == NULL))
+            continue;
+
+        qsort(us[phase], BENCH_REPETITIONS, sizeof(uint32_t), value_compare);
+        result.iterations = BENCH_REPETITIONS;
+        result.ns         = us[phase][BENCH_REPETITIONS / 2] * 1000.0;
+        result.calls      = 0;
+        result.m4_cycles  = (double)us[phase][BENCH_REPETITIONS / 2] * M4_CYCLES_PER_US;
+        m_results[m_result_count++] = result;
+        result_print(&result);
+    }
+    printf("\n");
+}
+
+/**
+    @brief Benchmarks are run when application waits for events first time
+*/
+static void bench_session(void) {
+
+    if (m_run_done)
+        longjmp(m_run_end, 1);
+    m_run_done = true;
+
+    fake_time_advance(BENCH_TICKS_PER_MS(1500));
+    fake_ble_evt_connected(BENCH_CONN_HANDLE);
+    fake_events_process();
+    fake_gatts_notify_enable(BENCH_CONN_HANDLE, BENCH_ADC_UUID, true);
+    fake_gatts_notify_enable(BENCH_CONN_HANDLE, BENCH_IN_EVT_UUID, true);
+    fake_events_process();
+
+    m_out1_handle = fake_gatts_value_handle_find(BENCH_OUT1_UUID);
+
+    for (uint32_t i = 0; i < ARRAY_SIZE(m_benchmarks); i++) {
+        if ((mp_filter == NULL) || (strstr(m_benchmarks[i].name, mp_filter) != NULL))
+            bench_run(&m_benchmarks[i]);
+    }
+
+    longjmp(m_run_end, 1);
+}
+
+static bool json_write(const char * p_file_name) {
+
+    FILE * p_file = fopen(p_file_name, "w");
+    if (p_file == NULL) {
+        perror(p_file_name);
+        return false;
+    }
+
+    fprintf(p_file, "{\n  \"context\": {\n");
+    fprintf(p_file, "    \"executable\": \"nrfblesq_bench\",\n");
+    fprintf(p_file, "    \"m4_cycles_per_host_ns\": %.4f,\n", m_m4_cycles_per_ns);
+    fprintf(p_file, "    \"fake_call_ns\": %.2f,\n", m_fake_call_ns);
+    fprintf(p_file, "    \"m4_svc_cycles\": %u\n", M4_SVC_CYCLES);
+    fprintf(p_file, "  },\n  \"benchmarks\": [\n");
+    for (uint32_t i = 0; i < m_result_count; i++) {
+        bench_result_t const * p_result = &m_results[i];
+        fprintf(p_file, "    {\n");
+        fprintf(p_file, "      \"name\": \"%s\",\n", p_result->name);
+        fprintf(p_file, "      \"iterations\": %llu,\n", (unsigned long long)p_result->iterations);
+        fprintf(p_file, "      \"real_time\": %.2f,\n", p_result->ns);
+        fprintf(p_file, "      \"cpu_time\": %.2f,\n", p_result->ns);
+        fprintf(p_file, "      \"time_unit\": \"ns\",\n");
+        fprintf(p_file, "      \"sd_calls\": %.2f,\n", p_result->calls);
+        fprintf(p_file, "      \"m4_cycles\": %.0f\n", p_result->m4_cycles);
+        fprintf(p_file, "    }%s\n", (i + 1 < m_result_count) ? "," : "");
+    }
+    fprintf(p_file, "  ]\n}\n");
+    fclose(p_file);
+    return true;
+}
+
+/**
+    @brief Estimated M4 cycles are compared, they depend less on speed of host than time.
+           Regressions are marked in m_regressed, on recheck only regressions
+           marked by previous process fail.
+*/
+static bool baseline_check(const char * p_file_name, uint32_t threshold_pct, bool recheck) {
+
+    FILE * p_file = fopen(p_file_name, "r");
+    if (p_file == NULL) {
+        perror(p_file_name);
+        return false;
+    }
+
+    static char text[64 * 1024];
+    size_t      len = fread(text, 1, sizeof(text) - 1, p_file);
+    bool        passed = true;
+    text[len] = '\0';
+    fclose(p_file);
+
+    printf("\nregression gate, threshold %u%% and %u cycles:\n", threshold_pct, BENCH_GATE_MIN_CYCLES);
+    for (uint32_t i = 0; i < m_result_count; i++) {
+        char   key[BENCH_NAME_MAX + 16];
+        double base = 0;
+
+        snprintf(key, sizeof(key), "\"name\": \"%s\"", m_results[i].name);
+        char const * p_entry = strstr(text, key);
+        char const * p_value = (p_entry != NULL) ? strstr(p_entry, "\"m4_cycles\":") : NULL;
+        if (p_value == NULL) {
+            printf("  %-28s no baseline\n", m_results[i].name);
+            continue;
+        }
+        base = atof(p_value + strlen("\"m4_cycles\":"));
+
+        double change = (base > 0) ? (m_results[i].m4_cycles - base) * 100.0 / base : 0;
+        bool   ok     = (change <= (double)threshold_pct) ||
+                        ((m_results[i].m4_cycles - base) < BENCH_GATE_MIN_CYCLES);
+        if (recheck)
+            ok = ok || (m_regressed[i] == false);
+        m_regressed[i] = (ok == false);
+        printf("  %-28s %10.0f -> %10.0f cycles %+7.1f%% %s\n", m_results[i].name, base,
+               m_results[i].m4_cycles, change, ok ? "ok" : "REGRESSION");
+        if (ok == false)
+            passed = false;
+    }
+    return passed;
+}
+
+static void regressed_mark(const char * p_names) {
+
+    for (uint32_t i = 0; i < m_result_count; i++) {
+        size_t       len = strlen(m_results[i].name);
+        char const * p_name = p_names;
+
+        m_regressed[i] = false;
+        while ((p_name = strstr(p_name, m_results[i].name)) != NULL) {
+            if (((p_name == p_names) || (p_name[-1] == ',')) &&
+                ((p_name[len] == ',') || (p_name[len] == '\0'))) {
+                m_regressed[i] = true;
+                break;
+            }
+            p_name += len;
+        }
+    }
+}
+
+/**
+    @brief Process is replaced by new one with same options and regressed names
+*/
+static void recheck_exec(int argc, char * argv[], uint32_t run) {
+
+    static char   names[BENCH_MAX_COUNT * BENCH_NAME_MAX];
+    static char   run_text[12];
+    static char * args[32];
+    size_t        len = 0;
+    int           count = 0;
+
+    for (uint32_t i = 0; i < m_result_count; i++) {
+        if (m_regressed[i])
+            len += snprintf(&names[len], sizeof(names) - len, "%s%s", (len != 0) ? "," : "", m_results[i].name);
+    }
+    /// options of previous recheck are replaced
+    for (int i = 0; (i < argc) && (count < (int)ARRAY_SIZE(args) - 5); i++) {
+        if ((strcmp(argv[i], "--recheck") == 0) || (strcmp(argv[i], "--run") == 0))
+            i++;
+        else
+            args[count++] = argv[i];
+    }
+    snprintf(run_text, sizeof(run_text), "%u", run + 1);
+    args[count++] = "--recheck";
+    args[count++] = names;
+    args[count++] = "--run";
+    args[count++] = run_text;
+    args[count]   = NULL;
+
+    printf("\nregressions are measured again by new process:\n\n");
+    fflush(stdout);
+    execv("/proc/self/exe", args);
+    perror("execv");
+}
+
+int main(int argc, char * argv[]) {
+
+    static const struct option options[] = {
+        {"json",        required_argument, NULL, 'j'},
+        {"baseline",    required_argument, NULL, 'b'},
+        {"threshold",   required_argument, NULL, 't'},
+        {"min-time-ms", required_argument, NULL, 'm'},
+        {"filter",      required_argument, NULL, 'f'},
+        {"recheck",     required_argument, NULL, 'r'},
+        {"run",         required_argument, NULL, 'n'},
+        {NULL, 0, NULL, 0}
+    };
+    const char * p_json = NULL;
+    const char * p_baseline = NULL;
+    const char * p_recheck = NULL;
+    uint32_t     threshold = 25;
+    uint32_t     run = 1;
+    int          opt;
+
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt)
+        {
+            case 'j': p_json        = optarg; break;
+            case 'b': p_baseline    = optarg; break;
+            case 't': threshold     = (uint32_t)atoi(optarg); break;
+            case 'm': m_min_time_ms = (uint32_t)atoi(optarg); break;
+            case 'f': mp_filter     = optarg; break;
+            case 'r': p_recheck     = optarg; break;
+            case 'n': run           = (uint32_t)atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: %s [--json FILE] [--baseline FILE] [--threshold PCT] "
+                                "[--min-time-ms N] [--filter TEXT]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    cost_model_calibrate();
+    printf("cost model: %.3f M4 cycles per host ns, %.1f ns per recorded call, %u cycles per SVC\n\n",
+           m_m4_cycles_per_ns, m_fake_call_ns, M4_SVC_CYCLES);
+
+    boot_run();
+
+    fake_reset();
+    fake_idle_hook_set(bench_session);
+
+    if (setjmp(m_run_end) == 0)
+        app_main();
+
+    if (fake_app_error_count() != 0)
+        return 1;
+    if ((p_json != NULL) && (json_write(p_json) == false))
+        return 1;
+    if (p_baseline == NULL)
+        return 0;
+
+    if (p_recheck != NULL)
+        regressed_mark(p_recheck);
+    if (baseline_check(p_baseline, threshold, p_recheck != NULL))
+        return 0;
+    if (run < BENCH_GATE_RUNS)
+        recheck_exec(argc, argv, run);
+    return 1;
+}
@@ -0,0 +1,146 @@
+/**
+    @brief Current budget of application on fake SoftDevice.
+
+    Usage: nrfblesq_energy [options]
+        --adv-s N           time of advertising phase, 1..170 s (60)
+        --conn-s N          time of connected phase (60)
+        --battery-mah N     capacity of battery (220)
+
+    Application runs unchanged with energy accounting counters. Advertising
+    phase waits for central, connected phase subscribes to input, ADC and
+    RSSI notifications, RSSI is reported every second and button is clicked
+    every 10 seconds. Counters of every phase are turned to currents by
+    energy_model.c.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <getopt.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sdk_stub.h"
+#include "energy_model.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define ENERGY_TICKS_PER_MS(MS) ((uint32_t)(((uint64_t)(MS) * 32768U) / 1000U))
+#define ENERGY_CONN_HANDLE      0U
+#define ENERGY_BOOT_MS          1500U       /**< deferred init and first samples of application */
+#define ENERGY_ADV_MAX_S        170U        /**< burst and fast phases of advertising schedule */
+#define ENERGY_CLICK_PERIOD_S   10U
+#define ENERGY_BUTTON_PIN       26U
+
+/// UUIDs of characteristics of sq_service.c
+#define ENERGY_IN_UUID          0x08
+#define ENERGY_ADC_UUID         0x0F
+#define ENERGY_RSSI_UUID        0x20
+#define ENERGY_IN_EVT_UUID      0x40
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+static uint32_t m_adv_s = 60;
+static uint32_t m_conn_s = 60;
+static double   m_battery_mah = 220.0;
+
+static jmp_buf  m_run_end;
+static bool     m_run_done = false;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+int app_main(void);
+
+static void energy_session(void);
+static void usage(const char * p_name);
+
+/**
+    @brief Phases are played when application waits for events first time
+*/
+static void energy_session(void) {
+
+    my_energy_counters_t start;
+    my_energy_counters_t end;
+
+    if (m_run_done)
+        longjmp(m_run_end, 1);
+    m_run_done = true;
+
+    fake_time_advance(ENERGY_TICKS_PER_MS(ENERGY_BOOT_MS));
+
+    my_energy_counters_get(&start);
+    fake_time_advance(ENERGY_TICKS_PER_MS(m_adv_s * 1000U));
+    my_energy_counters_get(&end);
+    energy_model_report(stdout, "advertising", &start, &end, m_battery_mah);
+
+    fake_ble_evt_connected(ENERGY_CONN_HANDLE);
+    fake_events_process();
+    fake_gatts_notify_enable(ENERGY_CONN_HANDLE, ENERGY_IN_UUID, true);
+    fake_gatts_notify_enable(ENERGY_CONN_HANDLE, ENERGY_ADC_UUID, true);
+    fake_gatts_notify_enable(ENERGY_CONN_HANDLE, ENERGY_RSSI_UUID, true);
+    fake_gatts_notify_enable(ENERGY_CONN_HANDLE, ENERGY_IN_EVT_UUID, true);
+    fake_events_process();
+
+    my_energy_counters_get(&start);
+    for (uint32_t s = 0; s < m_conn_s; s++) {
+        fake_ble_evt_rssi(ENERGY_CONN_HANDLE, (int8_t)(-60 - (int8_t)(s % 8)));
+        if ((s % ENERGY_CLICK_PERIOD_S) == 0) {
+            fake_gpio_input_set(ENERGY_BUTTON_PIN, 0);
+            fake_time_advance(ENERGY_TICKS_PER_MS(100));
+            fake_gpio_input_set(ENERGY_BUTTON_PIN, 1);
+            fake_time_advance(ENERGY_TICKS_PER_MS(900));
+        } else {
+            fake_time_advance(ENERGY_TICKS_PER_MS(1000));
+        }
+        /// notifications of last second are sent
+        fake_ble_evt_tx_complete(ENERGY_CONN_HANDLE, 0);
+    }
+    my_energy_counters_get(&end);
+    energy_model_report(stdout, "connected", &start, &end, m_battery_mah);
+
+    longjmp(m_run_end, 1);
+}
+
+static void usage(const char * p_name) {
+
+    fprintf(stderr, "usage: %s [--adv-s N] [--conn-s N] [--battery-mah N]\n", p_name);
+    exit(2);
+}
+
+int main(int argc, char * argv[]) {
+
+    static const struct option options[] = {
+        {"adv-s",       required_argument, NULL, 'a'},
+        {"conn-s",      required_argument, NULL, 'c'},
+        {"battery-mah", required_argument, NULL, 'b'},
+        {NULL, 0, NULL, 0}
+    };
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt)
+        {
+            case 'a': m_adv_s       = (uint32_t)atoi(optarg); break;
+            case 'c': m_conn_s      = (uint32_t)atoi(optarg); break;
+            case 'b': m_battery_mah = atof(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if ((m_adv_s == 0) || (m_adv_s > ENERGY_ADV_MAX_S) || (m_conn_s == 0) || (m_battery_mah <= 0.0))
+        usage(argv[0]);
+
+    fake_reset();
+    fake_idle_hook_set(energy_session);
+
+    if (setjmp(m_run_end) == 0)
+        app_main();
+
+    return (fake_app_error_count() == 0) ? 0 : 1;
+}
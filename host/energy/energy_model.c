@@ -0,0 +1,107 @@
+/**
+    @brief Current estimator, see energy_model.h
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <string.h>
+#include "energy_model.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define ENERGY_RTC_HZ       32768.0
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+static char const * const m_feature_names[ENERGY_FEATURE_COUNT] = {
+    [ENERGY_FEATURE_BLE]     = "ble",
+    [ENERGY_FEATURE_ADC]     = "adc",
+    [ENERGY_FEATURE_LED]     = "led",
+    [ENERGY_FEATURE_INPUT]   = "input",
+    [ENERGY_FEATURE_RSSI]    = "rssi",
+    [ENERGY_FEATURE_STORAGE] = "storage",
+};
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+char const * energy_feature_name(energy_feature_t feature) {
+    return (feature < ENERGY_FEATURE_COUNT) ? m_feature_names[feature] : "?";
+}
+
+/**
+    @brief Average currents from difference of two snapshots of counters
+*/
+void energy_model_estimate(my_energy_counters_t const * p_from,
+                           my_energy_counters_t const * p_to,
+                           energy_estimate_t * p_estimate) {
+
+    memset(p_estimate, 0, sizeof(*p_estimate));
+
+    p_estimate->seconds = (double)(p_to->total_ticks - p_from->total_ticks) / ENERGY_RTC_HZ;
+    if (p_estimate->seconds <= 0.0)
+        return;
+
+    double const s = p_estimate->seconds;
+
+    for (uint32_t i = 0; i < ENERGY_FEATURE_COUNT; i++) {
+        double q = (p_to->wakeups[i] - p_from->wakeups[i]) * ENERGY_Q_WAKEUP_UC +
+                   (p_to->tx_packets[i] - p_from->tx_packets[i]) * ENERGY_Q_TX_PACKET_UC;
+        p_estimate->feature_ua[i] = q / s;
+    }
+
+    p_estimate->feature_ua[ENERGY_FEATURE_ADC] +=
+        (p_to->saadc_conversions - p_from->saadc_conversions) * ENERGY_Q_SAADC_UC / s;
+
+    p_estimate->feature_ua[ENERGY_FEATURE_LED] +=
+        (double)(p_to->led_on_ticks - p_from->led_on_ticks) / ENERGY_RTC_HZ * ENERGY_I_LED_UA / s;
+
+    p_estimate->feature_ua[ENERGY_FEATURE_STORAGE] +=
+        ((p_to->flash_words - p_from->flash_words) * ENERGY_Q_FLASH_WORD_UC +
+         (p_to->flash_gc_runs - p_from->flash_gc_runs) * ENERGY_Q_FLASH_GC_UC) / s;
+
+    p_estimate->adv_ua   = (p_to->adv_events - p_from->adv_events) * ENERGY_Q_ADV_EVENT_UC / s;
+    p_estimate->conn_ua  = (p_to->conn_events - p_from->conn_events) * ENERGY_Q_CONN_EVENT_UC / s;
+    p_estimate->sleep_ua = ENERGY_I_SLEEP_UA;
+
+    p_estimate->total_ua = p_estimate->adv_ua + p_estimate->conn_ua + p_estimate->sleep_ua;
+    for (uint32_t i = 0; i < ENERGY_FEATURE_COUNT; i++)
+        p_estimate->total_ua += p_estimate->feature_ua[i];
+}
+
+/**
+    @brief Table of currents and life of battery
+*/
+void energy_model_report(FILE * p_file, char const * p_title,
+                         my_energy_counters_t const * p_from,
+                         my_energy_counters_t const * p_to,
+                         double battery_mah) {
+
+    energy_estimate_t est;
+
+    energy_model_estimate(p_from, p_to, &est);
+
+    fprintf(p_file, "%s: %.1f s\n", p_title, est.seconds);
+    fprintf(p_file, "  %-12s %10s %10s %10s %7s\n", "source", "wakeups", "packets", "uA", "%");
+
+    for (uint32_t i = 0; i < ENERGY_FEATURE_COUNT; i++) {
+        fprintf(p_file, "  %-12s %10u %10u %10.2f %6.1f%%\n", energy_feature_name((energy_feature_t)i),
+                p_to->wakeups[i] - p_from->wakeups[i], p_to->tx_packets[i] - p_from->tx_packets[i],
+                est.feature_ua[i], (est.total_ua > 0.0) ? 100.0 * est.feature_ua[i] / est.total_ua : 0.0);
+    }
+    fprintf(p_file, "  %-12s %10u %10s %10.2f %6.1f%%\n", "advertising",
+            p_to->adv_events - p_from->adv_events, "-", est.adv_ua, 100.0 * est.adv_ua / est.total_ua);
+    fprintf(p_file, "  %-12s %10u %10s %10.2f %6.1f%%\n", "connection",
+            p_to->conn_events - p_from->conn_events, "-", est.conn_ua, 100.0 * est.conn_ua / est.total_ua);
+    fprintf(p_file, "  %-12s %10s %10s %10.2f %6.1f%%\n", "sleep",
+            "-", "-", est.sleep_ua, 100.0 * est.sleep_ua / est.total_ua);
+    fprintf(p_file, "  %-12s %10s %10s %10.2f\n", "total", "", "", est.total_ua);
+    fprintf(p_file, "  battery %.0f mAh: %.0f days\n\n", battery_mah,
+            battery_mah * 1000.0 / est.total_ua / 24.0);
+}
@@ -0,0 +1,51 @@
+/*!
+    @brief Model of current consumption of nRF52840 (3 V, DC/DC on, 0 dBm).
+           Counters of my_energy_manager for some time are turned to average
+           current of every feature, radio activity and sleep.
+
+           Charges of operations are estimates from nRF52840 product
+           specification and online power profiler, they are changed here
+           when device is measured.
+*/
+
+#ifndef ENERGY_MODEL_H__
+#define ENERGY_MODEL_H__
+
+#include <stdio.h>
+#include "my_energy_manager.h"
+
+/// Constants of model, charge in uC, current in uA
+#define ENERGY_I_SLEEP_UA           3.0     /**< System ON, RTC and RAM retention */
+#define ENERGY_Q_WAKEUP_UC          0.05    /**< CPU start from sleep and short handler */
+#define ENERGY_Q_ADV_EVENT_UC       10.0    /**< 3 channels, 31 bytes of data, scan request */
+#define ENERGY_Q_CONN_EVENT_UC      2.5     /**< empty packets of connection event */
+#define ENERGY_Q_TX_PACKET_UC       1.0     /**< one more packet in connection event */
+#define ENERGY_Q_SAADC_UC           0.1     /**< conversion of 2 channels with 10 us acquisition */
+#define ENERGY_Q_FLASH_WORD_UC      0.3     /**< 41 us write of word at 7.5 mA */
+#define ENERGY_Q_FLASH_GC_UC        640.0   /**< 85 ms page erase at 7.5 mA */
+#define ENERGY_I_LED_UA             2000.0  /**< LED on board */
+
+/**
+    @brief Average currents for time of counters
+*/
+typedef struct {
+    double seconds;
+    double feature_ua[ENERGY_FEATURE_COUNT];    /**< CPU, packets and peripherals of feature */
+    double adv_ua;                              /**< advertising events */
+    double conn_ua;                             /**< empty connection events */
+    double sleep_ua;
+    double total_ua;
+} energy_estimate_t;
+
+char const * energy_feature_name(energy_feature_t feature);
+
+void energy_model_estimate(my_energy_counters_t const * p_from,
+                           my_energy_counters_t const * p_to,
+                           energy_estimate_t * p_estimate);
+
+void energy_model_report(FILE * p_file, char const * p_title,
+                         my_energy_counters_t const * p_from,
+                         my_energy_counters_t const * p_to,
+                         double battery_mah);
+
+#endif
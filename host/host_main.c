@@ -0,0 +1,483 @@
+/**
+    @brief Host run of application on fake SoftDevice.
+
+    main() of application (compiled as app_main) runs unchanged. When it has
+    nothing to do and waits in sd_app_evt_wait(), the idle hook plays a session
+    of two centrals: connect, enable notifications, write output register,
+    press button, read statistics, disconnect. Then recorded calls are checked,
+    advertising schedule runs without centrals and summary is printed.
+
+    Usage: nrfblesq_host [--log <file>] [--trace <file>]
+        --log <file>    records of binary log are saved for nrfblesq_log_decode
+        --trace <file>  event trace of session is saved for nrfblesq_trace_decode,
+                        it is value of trace characteristic after next reset
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include "sdk_stub.h"
+#include "my_link_manager.h"
+#include "my_log_manager.h"
+#include "my_stats_manager.h"
+#include "my_trace_manager.h"
+#include "my_time_manager.h"
+#include "my_ring_manager.h"
+#include "my_storage_manager.h"
+#include "sq_service.h"
+#include "my_rssi_manager.h"
+#include "my_adv_manager.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define HOST_TICKS_PER_MS(MS)   ((uint32_t)(((uint64_t)(MS) * 32768U) / 1000U))
+
+#define HOST_CONN_HANDLE        0U
+#define HOST_CONN_HANDLE2       1U      /**< second central */
+#define HOST_BUTTON_PIN         26U
+#define HOST_OUT_REG1_PIN       28U
+#define HOST_NAME_LEN           (sizeof(DEVICE_NAME) - 1)
+/// Connection interval of fake SoftDevice, connection events follow it from connection
+#define HOST_CONN_EVT_TICKS     HOST_TICKS_PER_MS(30)
+
+/// UUIDs of characteristics of sq_service.c
+#define HOST_OUT1_UUID          0x02
+#define HOST_IN_UUID            0x08
+#define HOST_ADC_UUID           0x0F
+#define HOST_RSSI_UUID          0x20
+#define HOST_IN_EVT_UUID        0x40
+#define HOST_TRACE_DIAG_UUID    0x0100
+#define HOST_STATS_UUID         0x0200
+#define HOST_TIME_SYNC_UUID     0x0400
+#define HOST_ADC_INTERVAL_UUID  0x0800
+#define HOST_ADC_INTERVAL_MS    2000U
+
+/// Time of central at the first sync, us, its clock runs 10 ppm faster than device
+#define HOST_CENTRAL_US         1000000ULL
+#define HOST_SYNC_INTERVAL_MS   20000U
+#define HOST_CENTRAL_FAST_US    200U
+
+/// High duty directed advertising of fake SoftDevice lasts 1.28 s
+#define HOST_DIRECTED_MS        1300U
+/// Time of beacon phase in schedule check
+#define HOST_BEACON_S           1200U
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+static jmp_buf  m_session_end;
+static bool     m_session_done = false;
+static uint32_t m_failures = 0;
+static my_stats_t m_stats;                      /**< statistics read by central */
+static uint16_t m_stats_len = 0;
+static uint32_t m_link_notifications[2];        /**< notifications accepted for every central */
+static uint64_t m_connected_ticks = 0;          /**< time of the first connection */
+static uint64_t m_sample_ticks = 0;             /**< time of the last ADC sample while connected */
+static uint8_t  m_sync[TIME_SYNC_REPLY_LEN];    /**< reply to the second sync of time */
+static uint16_t m_sync_len = 0;
+static uint64_t m_sync_ticks = 0;               /**< time of the second sync */
+static uint8_t  m_adc_interval[2];              /**< ADC interval in database after rejected write */
+static int8_t   m_link_rssi[2];                 /**< RSSI read by every central */
+static uint32_t m_blob_replies = 0;             /**< replies to Read Blob of statistics */
+static fake_call_t m_reconnect_adv[3];          /**< advertising after link loss: directed, whitelist, burst */
+static fake_call_t m_schedule_adv[ADV_PHASE_COUNT - ADV_PHASE_CONFIG_FIRST];   /**< the first advertising of every configured phase */
+static fake_call_t m_beacon_adv;                /**< the last advertising, long after beacon started */
+static fake_call_t m_wakeup_adv;                /**< advertising after click of button */
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+int app_main(void);
+
+static void host_check(bool condition, const char * p_what);
+static void hvx_count(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len);
+static void time_sync_write(uint16_t handle, uint64_t central_us);
+static bool ring_check(void);
+static void session_run(void);
+static void schedule_run(void);
+static int log_save(const char * p_path);
+static int trace_save(const char * p_path);
+
+static void host_check(bool condition, const char * p_what) {
+
+    printf("%-48s %s\n", p_what, condition ? "ok" : "FAILED");
+    if (condition == false)
+        m_failures++;
+}
+
+static void hvx_count(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len) {
+
+    UNUSED_PARAMETER(handle);
+    UNUSED_PARAMETER(p_data);
+    UNUSED_PARAMETER(len);
+    if (conn_handle < ARRAY_SIZE(m_link_notifications))
+        m_link_notifications[conn_handle]++;
+}
+
+/**
+    @brief Central writes its time to sync characteristic
+*/
+static void time_sync_write(uint16_t handle, uint64_t central_us) {
+
+    uint8_t data[TIME_SYNC_WRITE_LEN];
+
+    for (uint32_t i = 0; i < sizeof(data); i++)
+        data[i] = (uint8_t)(central_us >> (8 * i));
+    fake_ble_evt_write(HOST_CONN_HANDLE, handle, data, sizeof(data));
+    fake_events_process();
+}
+
+/**
+    @brief Ring keeps order over wrap, rejects push without place and gives wrapped spans
+           to consumer and producer
+*/
+static bool ring_check(void) {
+
+    uint16_t  buf[8];
+    uint16_t  values[8];
+    my_ring_t ring;
+    my_ring_span_t spans[2];
+
+    if (my_ring_init(&ring, buf, sizeof(uint16_t), 6) != NRF_ERROR_INVALID_PARAM)
+        return false;
+    (void)my_ring_init(&ring, buf, sizeof(uint16_t), 8);
+
+    for (uint16_t i = 0; i < 8; i++)
+        values[i] = i;
+    if (!my_ring_push(&ring, values, 5) || (my_ring_pop(&ring, values, 3) != 3) || (values[2] != 2))
+        return false;
+    for (uint16_t i = 0; i < 6; i++)
+        values[i] = 5 + i;
+    if (!my_ring_push(&ring, values, 6) || my_ring_push(&ring, values, 1) || (my_ring_free(&ring) != 0))
+        return false;
+
+    /// tail is at position 3: 5 elements to the end, 3 wrapped
+    if ((my_ring_peek(&ring, spans) != 8) || (spans[0].count != 5) || (spans[1].count != 3) ||
+        (((uint16_t *)spans[1].p_data)[2] != 10))
+        return false;
+
+    if (my_ring_pop(&ring, values, 8) != 8)
+        return false;
+    for (uint16_t i = 0; i < 8; i++) {
+        if (values[i] != 3 + i)
+            return false;
+    }
+    if (my_ring_count(&ring) != 0)
+        return false;
+
+    /// head is at position 3: reserved place wraps, it is seen only after commit
+    if (my_ring_reserve(&ring, 9, spans) || !my_ring_reserve(&ring, 7, spans) ||
+        (spans[0].count != 5) || (spans[1].count != 2))
+        return false;
+    for (uint16_t i = 0; i < 7; i++)
+        ((uint16_t *)spans[i / 5].p_data)[i % 5] = 20 + i;
+    if (my_ring_count(&ring) != 0)
+        return false;
+    my_ring_commit(&ring, 7);
+    return (my_ring_pop(&ring, values, 8) == 7) && (values[0] == 20) && (values[6] == 26);
+}
+
+/**
+    @brief Session of central, it is played when application waits for events first time
+*/
+static void session_run(void) {
+
+    uint8_t out_reg1 = 0x01;
+
+    if (m_session_done)
+        longjmp(m_session_end, 1);
+    m_session_done = true;
+
+    /// deferred init after first advertising event, the first ADC samples
+    fake_time_advance(HOST_TICKS_PER_MS(1500));
+
+    fake_ble_evt_connected(HOST_CONN_HANDLE);
+    fake_events_process();
+    m_connected_ticks = fake_time_ticks();
+    (void)fake_pm_bond(HOST_CONN_HANDLE);
+    fake_events_process();
+
+    fake_gatts_notify_enable(HOST_CONN_HANDLE, HOST_IN_UUID, true);
+    fake_gatts_notify_enable(HOST_CONN_HANDLE, HOST_ADC_UUID, true);
+    fake_gatts_notify_enable(HOST_CONN_HANDLE, HOST_RSSI_UUID, true);
+    fake_gatts_notify_enable(HOST_CONN_HANDLE, HOST_IN_EVT_UUID, true);
+    fake_events_process();
+
+    fake_ble_evt_write(HOST_CONN_HANDLE, fake_gatts_value_handle_find(HOST_OUT1_UUID), &out_reg1, sizeof(out_reg1));
+    /// new ADC interval is stored, interval shorter than timer allows is rejected
+    uint16_t adc_interval_handle = fake_gatts_value_handle_find(HOST_ADC_INTERVAL_UUID);
+    uint8_t  adc_interval[2] = {(uint8_t)HOST_ADC_INTERVAL_MS, (uint8_t)(HOST_ADC_INTERVAL_MS >> 8)};
+    fake_ble_evt_write(HOST_CONN_HANDLE, adc_interval_handle, adc_interval, sizeof(adc_interval));
+    fake_events_process();
+    memset(adc_interval, 0, sizeof(adc_interval));
+    fake_ble_evt_write(HOST_CONN_HANDLE, adc_interval_handle, adc_interval, sizeof(adc_interval));
+    fake_events_process();
+    (void)fake_gatts_value_read(adc_interval_handle, m_adc_interval, sizeof(m_adc_interval));
+    fake_ble_evt_rssi(HOST_CONN_HANDLE, -60);
+    fake_events_process();
+
+    /// second central connects while the first one stays
+    fake_ble_evt_connected(HOST_CONN_HANDLE2);
+    fake_events_process();
+    fake_gatts_notify_enable(HOST_CONN_HANDLE2, HOST_IN_UUID, true);
+    fake_gatts_notify_enable(HOST_CONN_HANDLE2, HOST_IN_EVT_UUID, true);
+    fake_ble_evt_rssi(HOST_CONN_HANDLE2, -75);
+    fake_events_process();
+    /// the second central moves away
+    for (uint32_t i = 0; i < LINK_SETTLE_SAMPLES + 1; i++) {
+        fake_ble_evt_rssi(HOST_CONN_HANDLE2, -90);
+        fake_events_process();
+    }
+
+    /// click of button
+    fake_gpio_input_set(HOST_BUTTON_PIN, 0);
+    fake_time_advance(HOST_TICKS_PER_MS(100));
+    fake_gpio_input_set(HOST_BUTTON_PIN, 1);
+    fake_time_advance(HOST_TICKS_PER_MS(600));
+    fake_ble_evt_tx_complete(HOST_CONN_HANDLE, 0);
+    fake_ble_evt_tx_complete(HOST_CONN_HANDLE2, 0);
+
+    /// delayed write of output registers to flash
+    fake_time_advance(HOST_TICKS_PER_MS(3000));
+
+    /// two syncs of time, drift is measured between them
+    uint16_t sync_handle = fake_gatts_value_handle_find(HOST_TIME_SYNC_UUID);
+    time_sync_write(sync_handle, HOST_CENTRAL_US);
+    fake_time_advance(HOST_TICKS_PER_MS(HOST_SYNC_INTERVAL_MS));
+    m_sync_ticks = fake_time_ticks();
+    time_sync_write(sync_handle, HOST_CENTRAL_US + HOST_SYNC_INTERVAL_MS * 1000ULL + HOST_CENTRAL_FAST_US);
+    m_sync_len = fake_gatts_value_read(sync_handle, m_sync, sizeof(m_sync));
+
+    /// read of statistics is authorized, application replies by snapshot
+    uint16_t stats_handle = fake_gatts_value_handle_find(HOST_STATS_UUID);
+    fake_ble_evt_read(HOST_CONN_HANDLE, stats_handle, 0);
+    fake_events_process();
+    m_stats_len = fake_gatts_value_read(stats_handle, (uint8_t *)&m_stats, sizeof(m_stats));
+    /// offset of Read Blob shares place with op of write request
+    uint32_t replies = fake_call_count("sd_ble_gatts_rw_authorize_reply");
+    fake_ble_evt_read(HOST_CONN_HANDLE, stats_handle, BLE_GATTS_OP_PREP_WRITE_REQ);
+    fake_events_process();
+    m_blob_replies = fake_call_count("sd_ble_gatts_rw_authorize_reply") - replies;
+
+    /// every central reads RSSI of own link
+    uint16_t rssi_handle = fake_gatts_value_handle_find(HOST_RSSI_UUID);
+    for (uint16_t conn_handle = HOST_CONN_HANDLE; conn_handle <= HOST_CONN_HANDLE2; conn_handle++) {
+        uint8_t rssi[SQS_RSSI_LEN];
+        fake_ble_evt_read(conn_handle, rssi_handle, 0);
+        fake_events_process();
+        (void)fake_gatts_value_read(rssi_handle, rssi, sizeof(rssi));
+        m_link_rssi[conn_handle] = (int8_t)rssi[0];
+    }
+
+    fake_call_t const * p_sample = fake_call_last("nrf_drv_saadc_sample");
+    if (p_sample != NULL)
+        m_sample_ticks = p_sample->ticks;
+
+    /// bonded central loses link, it is called back by directed advertising, then by whitelist
+    fake_ble_evt_disconnected(HOST_CONN_HANDLE, BLE_HCI_CONNECTION_TIMEOUT);
+    fake_events_process();
+    m_reconnect_adv[0] = *fake_call_last("sd_ble_gap_adv_start");
+    fake_time_advance(HOST_TICKS_PER_MS(HOST_DIRECTED_MS));
+    m_reconnect_adv[1] = *fake_call_last("sd_ble_gap_adv_start");
+    fake_time_advance(HOST_TICKS_PER_MS(ADV_WHITELIST_TIMEOUT_S * 1000U));
+    m_reconnect_adv[2] = *fake_call_last("sd_ble_gap_adv_start");
+
+    fake_ble_evt_disconnected(HOST_CONN_HANDLE2, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+    fake_time_advance(HOST_TICKS_PER_MS(1000));
+
+    longjmp(m_session_end, 1);
+}
+
+/**
+    @brief Advertising schedule without centrals. It is played after checks
+           of session, because its long time overwrites older recorded calls.
+*/
+static void schedule_run(void) {
+
+    my_config_t const * p_config = my_storage_config_get();
+
+    /// reconnection phases of lost central are over
+    fake_time_advance(HOST_TICKS_PER_MS(HOST_DIRECTED_MS + ADV_WHITELIST_TIMEOUT_S * 1000U));
+
+    for (uint32_t i = 0; i < ADV_PHASE_COUNT - ADV_PHASE_CONFIG_FIRST; i++) {
+        m_schedule_adv[i] = *fake_call_last("sd_ble_gap_adv_start");
+        /// beacon without duration lasts longer than all other phases
+        uint32_t timeout_s = (p_config->adv_timeout_s[i] != 0) ? p_config->adv_timeout_s[i] : HOST_BEACON_S;
+        fake_time_advance(HOST_TICKS_PER_MS(timeout_s * 1000U));
+    }
+    m_beacon_adv = *fake_call_last("sd_ble_gap_adv_start");
+
+    /// click of button
+    fake_gpio_input_set(HOST_BUTTON_PIN, 0);
+    fake_time_advance(HOST_TICKS_PER_MS(100));
+    fake_gpio_input_set(HOST_BUTTON_PIN, 1);
+    fake_time_advance(HOST_TICKS_PER_MS(600));
+    m_wakeup_adv = *fake_call_last("sd_ble_gap_adv_start");
+}
+
+/**
+    @brief Records, which wait in ring, are sent and RTT channel is saved
+*/
+static int log_save(const char * p_path) {
+
+    uint8_t const * p_data;
+    uint32_t        len;
+
+    while (my_log_process())
+        ;
+
+    len = fake_rtt_data_get(MY_LOG_RTT_CHANNEL, &p_data);
+
+    FILE * p_file = fopen(p_path, "wb");
+    if ((p_file == NULL) || (fwrite(p_data, 1, len, p_file) != len)) {
+        fprintf(stderr, "%s: can't write\n", p_path);
+        return -1;
+    }
+    fclose(p_file);
+    return 0;
+}
+
+/**
+    @brief Trace of session is encoded like my_trace_init() does after reset
+*/
+static int trace_save(const char * p_path) {
+
+    uint8_t  data[TRACE_DIAG_LEN];
+    uint16_t len = my_trace_encode(data);
+
+    FILE * p_file = fopen(p_path, "wb");
+    if ((p_file == NULL) || (fwrite(data, 1, len, p_file) != len)) {
+        fprintf(stderr, "%s: can't write\n", p_path);
+        return -1;
+    }
+    fclose(p_file);
+    return 0;
+}
+
+int main(int argc, char * argv[]) {
+
+    const char * p_log_path = NULL;
+    const char * p_trace_path = NULL;
+
+    for (int i = 1; i < argc; i += 2) {
+        if ((i + 1 < argc) && (strcmp(argv[i], "--log") == 0)) {
+            p_log_path = argv[i + 1];
+        } else if ((i + 1 < argc) && (strcmp(argv[i], "--trace") == 0)) {
+            p_trace_path = argv[i + 1];
+        } else {
+            fprintf(stderr, "usage: %s [--log <file>] [--trace <file>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    fake_reset();
+    fake_idle_hook_set(session_run);
+    fake_hvx_hook_set(hvx_count);
+
+    if (setjmp(m_session_end) == 0)
+        app_main();
+
+    host_check(fake_gpio_output_get(HOST_OUT_REG1_PIN) == 1,       "out_reg1 bit 0 drives pin");
+    host_check(fake_call_count("sd_ble_gatts_hvx") > 0,            "notifications sent");
+    host_check(fake_call_count("fds_record_write") +
+               fake_call_count("fds_record_update") > 0,           "output registers stored");
+    host_check((m_link_notifications[HOST_CONN_HANDLE] > 0) &&
+               (m_link_notifications[HOST_CONN_HANDLE2] > 0),      "notifications sent to both centrals");
+    /// start, then advertising for next central after every connection, next phase after timeout during sync,
+    /// three phases of reconnection, directed again after the last disconnection
+    host_check(fake_call_count("sd_ble_gap_adv_start") == 8,       "advertising while links are free");
+    host_check((m_reconnect_adv[0].handle == BLE_GAP_ADV_TYPE_ADV_DIRECT_IND) &&
+               (m_reconnect_adv[1].handle == BLE_GAP_ADV_TYPE_ADV_IND) &&
+               (m_reconnect_adv[1].data[4] == BLE_GAP_ADV_FP_FILTER_CONNREQ) &&
+               (uint16_decode(&m_reconnect_adv[1].data[2]) == ADV_WHITELIST_TIMEOUT_S) &&
+               (m_reconnect_adv[2].data[4] == BLE_GAP_ADV_FP_ANY) &&
+               (uint16_decode(&m_reconnect_adv[2].data[0]) ==
+                MSEC_TO_UNITS(my_storage_config_get()->adv_interval_ms[0], UNIT_0_625_MS)),
+                                                                   "bonded central reconnected after link loss");
+#ifdef TX_POWER_CONTROL
+    /// RSSI of every link, TX power is raised for far central, default is set again without links
+    host_check(fake_call_count("sd_ble_gap_rssi_start") == 2,      "RSSI measured on every link");
+    fake_call_t const * p_tx_power = fake_call_last("sd_ble_gap_tx_power_set");
+    host_check((fake_call_count("sd_ble_gap_tx_power_set") == 3) && (p_tx_power != NULL) &&
+               ((int8_t)p_tx_power->data[0] == TX_POWER_LEVEL),    "TX power follows RSSI");
+#else
+    /// the second central isn't subscribed to RSSI
+    host_check(fake_call_count("sd_ble_gap_rssi_start") == 1,      "RSSI measured only for subscriber");
+#endif
+    /// data of ble_advertising, encoded packets, initial payload, then the first ADC measurement
+    host_check(fake_call_count("sd_ble_gap_adv_data_set") >= 4,    "sensor values broadcasted");
+    fake_call_t const * p_adv_data = fake_call_last("sd_ble_gap_adv_data_set");
+    host_check((p_adv_data != NULL) && ((p_adv_data->handle & 0xFF) > HOST_NAME_LEN) &&
+               (memcmp(&p_adv_data->data[p_adv_data->len - HOST_NAME_LEN], DEVICE_NAME, HOST_NAME_LEN) == 0),
+                                                                   "name in scan response");
+#ifdef RADIO_SYNC
+    host_check((m_sample_ticks > m_connected_ticks) &&
+               ((m_sample_ticks - m_connected_ticks) % HOST_CONN_EVT_TICKS == 0),
+                                                                   "ADC sampled before connection event");
+#endif
+#ifdef TIME_SYNC
+    int32_t drift_ppb = (int32_t)uint32_decode(&m_sync[16]);
+    host_check((m_sync_len == TIME_SYNC_REPLY_LEN) &&
+               (uint32_decode(&m_sync[0]) == (uint32_t)m_sync_ticks) &&
+               (uint32_decode(&m_sync[8]) == (uint32_t)(HOST_CENTRAL_US + HOST_SYNC_INTERVAL_MS * 1000ULL + HOST_CENTRAL_FAST_US)) &&
+               (drift_ppb >= -10001) && (drift_ppb <= -9999),      "time synced with drift of central");
+#endif
+    host_check((my_storage_config_get()->adc_interval_ms == HOST_ADC_INTERVAL_MS) &&
+               (uint16_decode(m_adc_interval) == HOST_ADC_INTERVAL_MS), "ADC interval written and stored");
+    /// the first central is near, the second one moved away
+    host_check((m_link_rssi[HOST_CONN_HANDLE] == -60) &&
+               (m_link_rssi[HOST_CONN_HANDLE2] < -80),             "RSSI read by link of reader");
+    host_check(ring_check(),                                       "ring keeps order over wrap");
+    /// average of link follows the last values, older ones are taken out
+    for (uint32_t i = 0; i < 2 * 64; i++)
+        my_rssi_push_value(HOST_CONN_HANDLE, (i < 64) ? -80 : -50);
+    host_check(my_rssi_get_value(HOST_CONN_HANDLE) == -50,         "RSSI averaged over last values");
+    my_rssi_link_remove(HOST_CONN_HANDLE);
+    host_check(fake_app_error_count() == 0,                        "no application errors");
+    host_check((m_stats_len == sizeof(m_stats)) && (m_stats.version == STATS_VERSION) &&
+               (m_stats.counters[STATS_COUNTER_NOTIFY_SENT] > 0) &&
+               (m_stats.counters[STATS_COUNTER_SAADC_CONVERSIONS] > 0), "statistics snapshot read");
+    host_check(m_stats.counters[STATS_COUNTER_FLASH_WORDS_USED] > 0, "flash usage in statistics");
+    host_check(m_blob_replies == 1,                                 "one reply to Read Blob of statistics");
+    /// retained RAM is empty at first run, trace value has header only
+    uint8_t trace_header[TRACE_DIAG_HEADER_LEN + 1];
+    host_check(fake_gatts_value_read(fake_gatts_value_handle_find(HOST_TRACE_DIAG_UUID), trace_header,
+                                     sizeof(trace_header)) == TRACE_DIAG_HEADER_LEN, "trace of previous run exposed");
+
+    /// log and trace are of session
+    if ((p_log_path != NULL) && (log_save(p_log_path) != 0))
+        m_failures++;
+    if ((p_trace_path != NULL) && (trace_save(p_trace_path) != 0))
+        m_failures++;
+
+    schedule_run();
+
+    my_config_t const * p_config = my_storage_config_get();
+    bool schedule_ok = true;
+    for (uint32_t i = 0; i < ADV_PHASE_COUNT - ADV_PHASE_CONFIG_FIRST; i++) {
+        schedule_ok = schedule_ok && (m_schedule_adv[i].handle == BLE_GAP_ADV_TYPE_ADV_IND) &&
+                      (uint16_decode(&m_schedule_adv[i].data[0]) ==
+                       MSEC_TO_UNITS(p_config->adv_interval_ms[i], UNIT_0_625_MS)) &&
+                      (uint16_decode(&m_schedule_adv[i].data[2]) == p_config->adv_timeout_s[i]);
+    }
+    host_check(schedule_ok,                                        "advertising phases burst, fast, slow, beacon");
+    host_check((m_beacon_adv.ticks == m_schedule_adv[ADV_PHASE_BEACON - ADV_PHASE_CONFIG_FIRST].ticks) &&
+               (fake_system_is_off() == false),                    "beacon lasts without system off");
+    host_check((m_wakeup_adv.ticks > m_beacon_adv.ticks) &&
+               (uint16_decode(&m_wakeup_adv.data[0]) ==
+                MSEC_TO_UNITS(p_config->adv_interval_ms[0], UNIT_0_625_MS)),
+                                                                   "input change starts burst again");
+    host_check(fake_app_error_count() == 0,                        "no application errors in schedule");
+
+    printf("\n");
+    fake_calls_summary(stdout);
+
+    return (m_failures == 0) ? 0 : 1;
+}
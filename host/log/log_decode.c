@@ -0,0 +1,255 @@
+/**
+    @brief Decoder of binary log of my_log_manager.
+
+    Usage: nrfblesq_log_decode <elf> <log.bin>
+
+    Records of log (RTT channel MY_LOG_RTT_CHANNEL, saved to file by J-Link
+    RTT Logger or by host harness) are printed as text. Format strings and %s
+    arguments are read from allocated sections of ELF file of the firmware,
+    32-bit ELF of nRF52 and 64-bit ELF of host build are supported.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <elf.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define DECODE_RTC_HZ           32768.0
+#define DECODE_TICKS_MASK       0x00FFFFFFU
+#define DECODE_NARGS_POS        24U
+#define DECODE_ARGS_MAX         4U
+#define DECODE_SECTIONS_MAX     128U
+#define DECODE_SPEC_MAX         16U
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief Allocated section of ELF with data in file
+*/
+typedef struct {
+    uint64_t addr;
+    uint64_t size;
+    uint64_t offset;
+} decode_section_t;
+
+static uint8_t *         mp_elf = NULL;
+static size_t            m_elf_size = 0;
+static decode_section_t  m_sections[DECODE_SECTIONS_MAX];
+static uint32_t          m_section_count = 0;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static uint8_t * file_read(const char * p_path, size_t * p_size);
+static int elf_load(const char * p_path);
+static const char * elf_string_at(uint32_t addr);
+static void record_print(uint32_t fmt_addr, uint32_t const * p_args, uint32_t nargs);
+
+static uint8_t * file_read(const char * p_path, size_t * p_size) {
+
+    FILE * p_file = fopen(p_path, "rb");
+    if (p_file == NULL)
+        return NULL;
+
+    fseek(p_file, 0, SEEK_END);
+    long size = ftell(p_file);
+    fseek(p_file, 0, SEEK_SET);
+
+    uint8_t * p_data = malloc((size > 0) ? (size_t)size : 1U);
+    if ((p_data != NULL) && (fread(p_data, 1, (size_t)size, p_file) != (size_t)size)) {
+        free(p_data);
+        p_data = NULL;
+    }
+    fclose(p_file);
+
+    *p_size = (size_t)size;
+    return p_data;
+}
+
+/**
+    @brief Table of allocated sections with data (.text, .rodata, ...)
+*/
+static int elf_load(const char * p_path) {
+
+    mp_elf = file_read(p_path, &m_elf_size);
+    if ((mp_elf == NULL) || (m_elf_size < EI_NIDENT) || (memcmp(mp_elf, ELFMAG, SELFMAG) != 0))
+        return -1;
+
+    if (mp_elf[EI_CLASS] == ELFCLASS32) {
+        Elf32_Ehdr const * p_hdr = (Elf32_Ehdr const *)mp_elf;
+        for (uint32_t i = 0; (i < p_hdr->e_shnum) && (m_section_count < DECODE_SECTIONS_MAX); i++) {
+            Elf32_Shdr const * p_sh = (Elf32_Shdr const *)(mp_elf + p_hdr->e_shoff + i * p_hdr->e_shentsize);
+            if ((p_sh->sh_type == SHT_PROGBITS) && (p_sh->sh_flags & SHF_ALLOC)) {
+                m_sections[m_section_count++] = (decode_section_t){p_sh->sh_addr, p_sh->sh_size, p_sh->sh_offset};
+            }
+        }
+    } else if (mp_elf[EI_CLASS] == ELFCLASS64) {
+        Elf64_Ehdr const * p_hdr = (Elf64_Ehdr const *)mp_elf;
+        for (uint32_t i = 0; (i < p_hdr->e_shnum) && (m_section_count < DECODE_SECTIONS_MAX); i++) {
+            Elf64_Shdr const * p_sh = (Elf64_Shdr const *)(mp_elf + p_hdr->e_shoff + i * p_hdr->e_shentsize);
+            if ((p_sh->sh_type == SHT_PROGBITS) && (p_sh->sh_flags & SHF_ALLOC)) {
+                m_sections[m_section_count++] = (decode_section_t){p_sh->sh_addr, p_sh->sh_size, p_sh->sh_offset};
+            }
+        }
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+    @brief String at address of firmware, NULL if address is not in ELF
+*/
+static const char * elf_string_at(uint32_t addr) {
+
+    for (uint32_t i = 0; i < m_section_count; i++) {
+        decode_section_t const * p_sec = &m_sections[i];
+        if ((addr >= p_sec->addr) && (addr < p_sec->addr + p_sec->size) &&
+            (p_sec->offset + p_sec->size <= m_elf_size)) {
+            const char * p_str = (const char *)(mp_elf + p_sec->offset + (addr - p_sec->addr));
+            /// string must end in section
+            if (memchr(p_str, 0, p_sec->addr + p_sec->size - addr) != NULL)
+                return p_str;
+        }
+    }
+    return NULL;
+}
+
+/**
+    @brief Text of record, every conversion gets one 32-bit argument
+*/
+static void record_print(uint32_t fmt_addr, uint32_t const * p_args, uint32_t nargs) {
+
+    const char * p_fmt = elf_string_at(fmt_addr);
+    uint32_t     arg = 0;
+
+    if (p_fmt == NULL) {
+        printf("<unknown format 0x%08x>", fmt_addr);
+        for (uint32_t i = 0; i < nargs; i++)
+            printf(" 0x%08x", p_args[i]);
+        return;
+    }
+
+    while (*p_fmt != '\0') {
+        if ((*p_fmt != '%') || (p_fmt[1] == '%')) {
+            if (*p_fmt == '%')
+                p_fmt++;
+            if ((*p_fmt != '\r') && (*p_fmt != '\n'))
+                putchar(*p_fmt);
+            p_fmt++;
+            continue;
+        }
+
+        /// specification without length modifiers, argument is 32-bit
+        char     spec[DECODE_SPEC_MAX];
+        uint32_t len = 0;
+        spec[len++] = *p_fmt++;
+        while ((*p_fmt != '\0') && (strchr("-+ #0123456789.", *p_fmt) != NULL) && (len < DECODE_SPEC_MAX - 3))
+            spec[len++] = *p_fmt++;
+        while ((*p_fmt == 'l') || (*p_fmt == 'h') || (*p_fmt == 'z'))
+            p_fmt++;
+        if (*p_fmt == '\0')
+            break;
+        char conv = *p_fmt++;
+
+        uint32_t value = (arg < nargs) ? p_args[arg] : 0;
+        arg++;
+
+        switch (conv)
+        {
+            case 'd':
+            case 'i':
+                spec[len++] = 'd'; spec[len] = '\0';
+                printf(spec, (int)(int32_t)value);
+                break;
+            case 'u': case 'x': case 'X': case 'o': case 'c':
+                spec[len++] = conv; spec[len] = '\0';
+                printf(spec, (unsigned)value);
+                break;
+            case 's':
+            {
+                const char * p_str = elf_string_at(value);
+                spec[len++] = 's'; spec[len] = '\0';
+                if (p_str != NULL)
+                    printf(spec, p_str);
+                else
+                    printf("<0x%08x>", value);
+                break;
+            }
+            default:
+                printf("<%%%c 0x%08x>", conv, value);
+                break;
+        }
+    }
+}
+
+int main(int argc, char * argv[]) {
+
+    uint8_t * p_log;
+    size_t    log_size;
+    uint32_t  last_ticks = 0;
+    uint64_t  wraps = 0;
+
+    if (argc != 3) {
+        fprintf(stderr, "usage: %s <elf> <log.bin>\n", argv[0]);
+        return 2;
+    }
+
+    if (elf_load(argv[1]) != 0) {
+        fprintf(stderr, "%s: not an ELF file\n", argv[1]);
+        return 1;
+    }
+
+    p_log = file_read(argv[2], &log_size);
+    if (p_log == NULL) {
+        fprintf(stderr, "%s: can't read\n", argv[2]);
+        return 1;
+    }
+
+    uint32_t const * p_words = (uint32_t const *)p_log;
+    size_t           count = log_size / sizeof(uint32_t);
+    size_t           i = 0;
+
+    while (i + 2 <= count) {
+        uint32_t fmt_addr = p_words[i];
+        uint32_t ticks    = p_words[i + 1] & DECODE_TICKS_MASK;
+        uint32_t nargs    = p_words[i + 1] >> DECODE_NARGS_POS;
+
+        if ((nargs > DECODE_ARGS_MAX) || (i + 2 + nargs > count)) {
+            fprintf(stderr, "broken record at offset %zu\n", i * sizeof(uint32_t));
+            free(p_log);
+            return 1;
+        }
+
+        if (fmt_addr == 0) {
+            /// time of drain, not of lost records
+            printf("%14s <%u records dropped>\n", "", p_words[i + 2]);
+            i += 2 + nargs;
+            continue;
+        }
+
+        /// RTC1 is 24-bit, records are in order of time
+        if (ticks < last_ticks)
+            wraps++;
+        last_ticks = ticks;
+
+        printf("[%12.6f] ", ((double)(wraps << 24) + ticks) / DECODE_RTC_HZ);
+        record_print(fmt_addr, &p_words[i + 2], nargs);
+        printf("\n");
+
+        i += 2 + nargs;
+    }
+
+    free(p_log);
+    return 0;
+}
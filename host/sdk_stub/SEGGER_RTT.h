@@ -0,0 +1,13 @@
+/* Host stand-in for SEGGER_RTT.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef SEGGER_RTT_H
+#define SEGGER_RTT_H
+#include "nrf_sdk_fake.h"
+
+#define SEGGER_RTT_MODE_NO_BLOCK_SKIP   (0U)
+#define SEGGER_RTT_MODE_NO_BLOCK_TRIM   (1U)
+#define SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL (2U)
+
+int      SEGGER_RTT_ConfigUpBuffer(unsigned BufferIndex, const char * sName, void * pBuffer,
+                                   unsigned BufferSize, unsigned Flags);
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void * pBuffer, unsigned NumBytes);
+#endif
@@ -0,0 +1,13 @@
+/* Host stand-in for app_error.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef APP_ERROR_H__
+#define APP_ERROR_H__
+#include "nrf_sdk_fake.h"
+void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name);
+void app_error_handler_bare(ret_code_t error_code);
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info);
+#define NRF_FAULT_ID_SDK_ERROR 0x4001
+#define NRF_FAULT_ID_SDK_ASSERT 0x4002
+typedef struct { uint32_t line_num; uint8_t const * p_file_name; uint32_t err_code; } error_info_t;
+#define APP_ERROR_HANDLER(ERR_CODE) do { app_error_handler((ERR_CODE), __LINE__, (uint8_t *)__FILE__); } while (0)
+#define APP_ERROR_CHECK(ERR_CODE) do { const uint32_t LOCAL_ERR_CODE = (ERR_CODE); if (LOCAL_ERR_CODE != NRF_SUCCESS) { APP_ERROR_HANDLER(LOCAL_ERR_CODE); } } while (0)
+#endif
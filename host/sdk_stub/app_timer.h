@@ -0,0 +1,43 @@
+/* Host stand-in for app_timer.h of nRF5 SDK 12.
+   Timers run on virtual RTC1 time, see fake_time_advance() in sdk_stub.h. */
+#ifndef APP_TIMER_H__
+#define APP_TIMER_H__
+#include "nrf_sdk_fake.h"
+#include "app_error.h"
+
+#define APP_TIMER_CLOCK_FREQ        32768
+#define APP_TIMER_MIN_TIMEOUT_TICKS 5
+#define APP_TIMER_MAX_CNT_VAL       0x00FFFFFF
+
+#define APP_TIMER_TICKS(MS, PRESCALER) \
+    ((uint32_t)ROUNDED_DIV((MS) * (uint64_t)APP_TIMER_CLOCK_FREQ, 1000 * ((PRESCALER) + 1)))
+
+typedef void (*app_timer_timeout_handler_t)(void * p_context);
+typedef enum { APP_TIMER_MODE_SINGLE_SHOT, APP_TIMER_MODE_REPEATED } app_timer_mode_t;
+
+typedef struct app_timer_t {
+    app_timer_timeout_handler_t handler;
+    app_timer_mode_t            mode;
+    bool                        created;
+    bool                        active;
+    uint64_t                    expiry;     /**< virtual time of next expiry, ticks */
+    uint32_t                    period;
+    void *                      p_context;
+} app_timer_t;
+typedef app_timer_t * app_timer_id_t;
+
+#define APP_TIMER_DEF(timer_id) \
+    static app_timer_t timer_id##_data; \
+    static const app_timer_id_t timer_id = &timer_id##_data
+
+#define APP_TIMER_INIT(PRESCALER, OP_QUEUE_SIZE, SCHEDULER_FUNC) \
+    do { uint32_t ERR_CODE = app_timer_init((PRESCALER), (OP_QUEUE_SIZE), NULL, NULL); APP_ERROR_CHECK(ERR_CODE); } while (0)
+
+uint32_t app_timer_init(uint32_t prescaler, uint8_t op_queue_size, void * p_op_queues_buf, void * evt_schedule_func);
+uint32_t app_timer_create(app_timer_id_t const * p_timer_id, app_timer_mode_t mode, app_timer_timeout_handler_t timeout_handler);
+uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context);
+uint32_t app_timer_stop(app_timer_id_t timer_id);
+uint32_t app_timer_stop_all(void);
+uint32_t app_timer_cnt_get(uint32_t * p_ticks);
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from, uint32_t * p_ticks_diff);
+#endif
@@ -0,0 +1,11 @@
+/* Host stand-in for app_util_platform.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef APP_UTIL_PLATFORM_H__
+#define APP_UTIL_PLATFORM_H__
+#include "nrf_sdk_fake.h"
+/* Host build is single threaded, critical region only keeps the syntax of the target. */
+#define APP_IRQ_PRIORITY_LOW     6
+#define APP_IRQ_PRIORITY_HIGH    2
+#define APP_IRQ_PRIORITY_LOWEST  7
+#define CRITICAL_REGION_ENTER() { uint8_t __CR_NESTED = 0; (void)__CR_NESTED;
+#define CRITICAL_REGION_EXIT()  }
+#endif
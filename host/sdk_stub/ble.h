@@ -0,0 +1,312 @@
+/* Host stand-in for the S132 v3 BLE API (ble.h, ble_gap.h, ble_gatts.h). */
+#ifndef BLE_H__
+#define BLE_H__
+#include "nrf_sdk_fake.h"
+
+#define BLE_CONN_HANDLE_INVALID     0xFFFF
+#define BLE_GATT_HANDLE_INVALID     0x0000
+#define BLE_GATTS_VLOC_INVALID      0x00
+#define BLE_GATTS_VLOC_STACK        0x01
+#define BLE_GATTS_VLOC_USER         0x02
+#define BLE_GATTS_SRVC_TYPE_PRIMARY 0x01
+#define BLE_UUID_TYPE_UNKNOWN       0x00
+#define BLE_UUID_TYPE_BLE           0x01
+#define BLE_UUID_TYPE_VENDOR_BEGIN  0x02
+#define BLE_GATT_HVX_NOTIFICATION   0x01
+#define BLE_GATT_HVX_INDICATION     0x02
+#define BLE_GATT_HVX_NOTIFICATION_BIT 0x01
+#define BLE_GATTS_OP_WRITE_REQ      0x01
+#define BLE_GATTS_OP_WRITE_CMD      0x02
+#define BLE_GATTS_OP_PREP_WRITE_REQ 0x04
+#define BLE_GATTS_OP_EXEC_WRITE_REQ_CANCEL 0x05
+#define BLE_GATTS_OP_EXEC_WRITE_REQ_NOW    0x06
+#define BLE_GATTS_AUTHORIZE_TYPE_INVALID 0x00
+#define BLE_GATTS_AUTHORIZE_TYPE_READ    0x01
+#define BLE_GATTS_AUTHORIZE_TYPE_WRITE   0x02
+#define BLE_GATT_STATUS_SUCCESS          0x0000
+#define BLE_GATT_STATUS_ATTERR_INVALID_OFFSET 0x0107
+#define BLE_GATT_STATUS_ATTERR_INVALID_ATT_VAL_LENGTH 0x010D
+#define BLE_GATT_STATUS_ATTERR_APP_BEGIN 0x0180
+#define BLE_GATT_ATT_MTU_DEFAULT         23
+#define GATT_MTU_SIZE_DEFAULT            23
+#define BLE_CCCD_VALUE_LEN               2
+#define BLE_GAP_ADV_MAX_SIZE             31
+#define BLE_GAP_ADDR_LEN                 6
+#define BLE_GAP_WHITELIST_ADDR_MAX_COUNT 8
+#define BLE_GAP_ADV_FLAG_LE_GENERAL_DISC_MODE 0x02
+#define BLE_GAP_ADV_FLAG_BR_EDR_NOT_SUPPORTED 0x04
+#define BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE 0x06
+#define BLE_GAP_AD_TYPE_FLAGS                          0x01
+#define BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE    0x03
+#define BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE   0x07
+#define BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME            0x09
+#define BLE_GAP_AD_TYPE_APPEARANCE                     0x19
+#define BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA     0xFF
+#define BLE_GAP_ADV_TYPE_ADV_IND          0x00
+#define BLE_GAP_ADV_TYPE_ADV_DIRECT_IND   0x01
+#define BLE_GAP_ADV_TYPE_ADV_NONCONN_IND  0x03
+#define BLE_GAP_ADV_FP_ANY                0x00
+#define BLE_GAP_ADV_FP_FILTER_CONNREQ     0x02
+#define BLE_GAP_ADDR_TYPE_PUBLIC          0x00
+#define BLE_GAP_ADV_INTERVAL_MIN          0x0020
+#define BLE_GAP_ADV_INTERVAL_MAX          0x4000
+#define BLE_GAP_RSSI_THRESHOLD_INVALID    0xFF
+#define BLE_APPEARANCE_GENERIC_TAG        512
+#define BLE_GAP_ROLE_INVALID              0x0
+#define BLE_GAP_ROLE_PERIPH               0x1
+#define BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION 0x13
+#define BLE_HCI_CONN_INTERVAL_UNACCEPTABLE        0x3B
+#define BLE_HCI_CONNECTION_TIMEOUT                0x08
+#define BLE_HCI_LOCAL_HOST_TERMINATED_CONNECTION  0x16
+
+typedef struct { uint16_t uuid; uint8_t type; } ble_uuid_t;
+typedef struct { uint8_t uuid128[16]; } ble_uuid128_t;
+
+typedef struct { uint8_t sm : 4; uint8_t lv : 4; } ble_gap_conn_sec_mode_t;
+#define BLE_GAP_CONN_SEC_MODE_SET_NO_ACCESS(ptr) do {(ptr)->sm = 0; (ptr)->lv = 0;} while(0)
+#define BLE_GAP_CONN_SEC_MODE_SET_OPEN(ptr)      do {(ptr)->sm = 1; (ptr)->lv = 1;} while(0)
+#define BLE_GAP_CONN_SEC_MODE_SET_ENC_NO_MITM(ptr) do {(ptr)->sm = 1; (ptr)->lv = 2;} while(0)
+
+typedef struct {
+    uint16_t min_conn_interval;
+    uint16_t max_conn_interval;
+    uint16_t slave_latency;
+    uint16_t conn_sup_timeout;
+} ble_gap_conn_params_t;
+
+typedef struct {
+    uint8_t addr_id_peer : 1;
+    uint8_t addr_type    : 7;
+    uint8_t addr[BLE_GAP_ADDR_LEN];
+} ble_gap_addr_t;
+
+typedef struct { uint8_t irk[16]; } ble_gap_irk_t;
+
+typedef struct {
+    uint8_t  type;
+    ble_gap_addr_t const * p_peer_addr;
+    uint8_t  fp;
+    void const * p_whitelist;
+    uint16_t interval;
+    uint16_t timeout;
+    struct { uint8_t ch_37_off : 1; uint8_t ch_38_off : 1; uint8_t ch_39_off : 1; } channel_mask;
+} ble_gap_adv_params_t;
+
+#define BLE_GAP_IO_CAPS_NONE 0x03
+
+typedef struct {
+    uint8_t bond : 1, mitm : 1, lesc : 1, keypress : 1, io_caps : 3, oob : 1;
+    uint8_t min_key_size;
+    uint8_t max_key_size;
+    struct { uint8_t enc : 1, id : 1, sign : 1, link : 1; } kdist_own, kdist_peer;
+} ble_gap_sec_params_t;
+
+typedef struct {
+    uint16_t handle;
+    uint8_t  type;
+    uint16_t offset;
+    uint16_t * p_len;
+    uint8_t const * p_data;
+} ble_gatts_hvx_params_t;
+
+typedef struct {
+    uint16_t len;
+    uint16_t offset;
+    uint8_t * p_value;
+} ble_gatts_value_t;
+
+typedef struct {
+    ble_gap_conn_sec_mode_t read_perm;
+    ble_gap_conn_sec_mode_t write_perm;
+    uint8_t vlen    : 1;
+    uint8_t vloc    : 2;
+    uint8_t rd_auth : 1;
+    uint8_t wr_auth : 1;
+} ble_gatts_attr_md_t;
+
+typedef struct {
+    ble_uuid_t const * p_uuid;
+    ble_gatts_attr_md_t const * p_attr_md;
+    uint16_t init_len;
+    uint16_t init_offs;
+    uint16_t max_len;
+    uint8_t * p_value;
+} ble_gatts_attr_t;
+
+typedef struct {
+    uint8_t broadcast : 1, read : 1, write_wo_resp : 1, write : 1, notify : 1, indicate : 1, auth_signed_wr : 1;
+} ble_gatt_char_props_t;
+
+typedef struct { uint8_t reliable_wr : 1, wr_aux : 1; } ble_gatt_char_ext_props_t;
+
+typedef struct {
+    ble_gatt_char_props_t char_props;
+    ble_gatt_char_ext_props_t char_ext_props;
+    uint8_t const * p_char_user_desc;
+    uint16_t char_user_desc_max_size;
+    uint16_t char_user_desc_size;
+    void const * p_char_pf;
+    ble_gatts_attr_md_t const * p_user_desc_md;
+    ble_gatts_attr_md_t const * p_cccd_md;
+    ble_gatts_attr_md_t const * p_sccd_md;
+} ble_gatts_char_md_t;
+
+typedef struct {
+    uint16_t value_handle;
+    uint16_t user_desc_handle;
+    uint16_t cccd_handle;
+    uint16_t sccd_handle;
+} ble_gatts_char_handles_t;
+
+/* events */
+enum {
+    BLE_EVT_TX_COMPLETE        = 0x01,
+    BLE_EVT_USER_MEM_REQUEST   = 0x02,
+    BLE_EVT_USER_MEM_RELEASE   = 0x03,
+    BLE_GAP_EVT_CONNECTED      = 0x10,
+    BLE_GAP_EVT_DISCONNECTED   = 0x11,
+    BLE_GAP_EVT_CONN_PARAM_UPDATE = 0x12,
+    BLE_GAP_EVT_SEC_PARAMS_REQUEST = 0x13,
+    BLE_GAP_EVT_CONN_SEC_UPDATE = 0x1A,
+    BLE_GAP_EVT_TIMEOUT        = 0x1B,
+    BLE_GAP_EVT_RSSI_CHANGED   = 0x1C,
+    BLE_GAP_EVT_ADV_REPORT     = 0x1D,
+    BLE_GATTC_EVT_TIMEOUT      = 0x3A,
+    BLE_GATTS_EVT_WRITE        = 0x50,
+    BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST = 0x51,
+    BLE_GATTS_EVT_SYS_ATTR_MISSING = 0x52,
+    BLE_GATTS_EVT_HVC          = 0x53,
+    BLE_GATTS_EVT_SC_CONFIRM   = 0x54,
+    BLE_GATTS_EVT_EXCHANGE_MTU_REQUEST = 0x55,
+    BLE_GATTS_EVT_TIMEOUT      = 0x56,
+};
+#define BLE_GAP_TIMEOUT_SRC_ADVERTISING 0x00
+
+typedef struct { uint16_t evt_id; uint16_t evt_len; } ble_evt_hdr_t;
+
+typedef struct {
+    ble_gap_addr_t peer_addr;
+    uint8_t role;
+    ble_gap_conn_params_t conn_params;
+} ble_gap_evt_connected_t;
+
+typedef struct { uint8_t reason; } ble_gap_evt_disconnected_t;
+typedef struct { int8_t rssi; } ble_gap_evt_rssi_changed_t;
+typedef struct { uint8_t src; } ble_gap_evt_timeout_t;
+typedef struct { ble_gap_conn_params_t conn_params; } ble_gap_evt_conn_param_update_t;
+
+typedef struct {
+    uint16_t conn_handle;
+    union {
+        ble_gap_evt_connected_t         connected;
+        ble_gap_evt_disconnected_t      disconnected;
+        ble_gap_evt_rssi_changed_t      rssi_changed;
+        ble_gap_evt_timeout_t           timeout;
+        ble_gap_evt_conn_param_update_t conn_param_update;
+    } params;
+} ble_gap_evt_t;
+
+typedef struct {
+    uint16_t handle;
+    ble_uuid_t uuid;
+    uint8_t op;
+    uint8_t auth_required;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t data[20];
+} ble_gatts_evt_write_t;
+
+typedef struct {
+    uint16_t handle;
+    ble_uuid_t uuid;
+    uint16_t offset;
+} ble_gatts_evt_read_t;
+
+typedef struct {
+    uint8_t type;
+    union {
+        ble_gatts_evt_read_t  read;
+        ble_gatts_evt_write_t write;
+    } request;
+} ble_gatts_evt_rw_authorize_request_t;
+
+typedef struct { uint16_t client_rx_mtu; } ble_gatts_evt_exchange_mtu_request_t;
+
+typedef struct {
+    uint16_t conn_handle;
+    union {
+        ble_gatts_evt_write_t                write;
+        ble_gatts_evt_rw_authorize_request_t authorize_request;
+        ble_gatts_evt_exchange_mtu_request_t exchange_mtu_request;
+    } params;
+} ble_gatts_evt_t;
+
+typedef struct { uint16_t conn_handle; } ble_gattc_evt_t;
+
+typedef struct { uint8_t count; } ble_evt_tx_complete_t;
+
+typedef struct {
+    uint16_t conn_handle;
+    union { ble_evt_tx_complete_t tx_complete; } params;
+} ble_common_evt_t;
+
+typedef struct {
+    ble_evt_hdr_t header;
+    union {
+        ble_common_evt_t common_evt;
+        ble_gap_evt_t    gap_evt;
+        ble_gattc_evt_t  gattc_evt;
+        ble_gatts_evt_t  gatts_evt;
+    } evt;
+} ble_evt_t;
+
+typedef struct {
+    uint16_t gatt_status;
+    uint8_t  update : 1;
+    uint16_t offset;
+    uint16_t len;
+    uint8_t const * p_data;
+} ble_gatts_authorize_params_t;
+
+typedef struct {
+    uint8_t type;
+    union {
+        ble_gatts_authorize_params_t read;
+        ble_gatts_authorize_params_t write;
+    } params;
+} ble_gatts_rw_authorize_reply_params_t;
+
+typedef struct {
+    struct { uint16_t att_mtu; } gatt_enable_params;
+} ble_enable_params_t;
+
+/* SVC calls, implemented by the fake layer */
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const * p_vs_uuid, uint8_t * p_uuid_type);
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle);
+uint32_t sd_ble_gatts_characteristic_add(uint16_t service_handle, ble_gatts_char_md_t const * p_char_md,
+                                         ble_gatts_attr_t const * p_attr_char_value,
+                                         ble_gatts_char_handles_t * p_handles);
+uint32_t sd_ble_gatts_value_set(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value);
+uint32_t sd_ble_gatts_value_get(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value);
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params);
+uint32_t sd_ble_gatts_rw_authorize_reply(uint16_t conn_handle, ble_gatts_rw_authorize_reply_params_t const * p_rw_authorize_reply_params);
+uint32_t sd_ble_gatts_exchange_mtu_reply(uint16_t conn_handle, uint16_t server_rx_mtu);
+uint32_t sd_ble_gatts_sys_attr_set(uint16_t conn_handle, uint8_t const * p_sys_attr_data, uint16_t len, uint32_t flags);
+uint32_t sd_ble_user_mem_reply(uint16_t conn_handle, void const * p_block);
+uint32_t sd_ble_tx_packet_count_get(uint16_t conn_handle, uint8_t * p_count);
+uint32_t sd_ble_gap_device_name_set(ble_gap_conn_sec_mode_t const * p_write_perm, uint8_t const * p_dev_name, uint16_t len);
+uint32_t sd_ble_gap_appearance_set(uint16_t appearance);
+uint32_t sd_ble_gap_ppcp_set(ble_gap_conn_params_t const * p_conn_params);
+uint32_t sd_ble_gap_tx_power_set(int8_t tx_power);
+uint32_t sd_ble_gap_disconnect(uint16_t conn_handle, uint8_t hci_status_code);
+uint32_t sd_ble_gap_rssi_start(uint16_t conn_handle, uint8_t threshold_dbm, uint8_t skip_count);
+uint32_t sd_ble_gap_rssi_stop(uint16_t conn_handle);
+uint32_t sd_ble_gap_rssi_get(uint16_t conn_handle, int8_t * p_rssi);
+uint32_t sd_ble_gap_adv_data_set(uint8_t const * p_data, uint8_t dlen, uint8_t const * p_sr_data, uint8_t srdlen);
+uint32_t sd_ble_gap_adv_start(ble_gap_adv_params_t const * p_adv_params);
+uint32_t sd_ble_gap_adv_stop(void);
+uint32_t sd_power_system_off(void);
+uint32_t sd_app_evt_wait(void);
+uint32_t sd_nvic_critical_region_enter(uint8_t * p_is_nested_critical_region);
+uint32_t sd_nvic_critical_region_exit(uint8_t is_nested_critical_region);
+#endif
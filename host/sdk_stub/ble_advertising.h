@@ -0,0 +1,25 @@
+/* Host stand-in for ble_advertising.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef BLE_ADVERTISING_H__
+#define BLE_ADVERTISING_H__
+#include "ble_advdata.h"
+typedef enum { BLE_ADV_MODE_IDLE, BLE_ADV_MODE_DIRECTED, BLE_ADV_MODE_DIRECTED_SLOW, BLE_ADV_MODE_FAST, BLE_ADV_MODE_SLOW } ble_adv_mode_t;
+typedef enum { BLE_ADV_EVT_IDLE, BLE_ADV_EVT_DIRECTED, BLE_ADV_EVT_DIRECTED_SLOW, BLE_ADV_EVT_FAST, BLE_ADV_EVT_SLOW,
+               BLE_ADV_EVT_FAST_WHITELIST, BLE_ADV_EVT_SLOW_WHITELIST, BLE_ADV_EVT_WHITELIST_REQUEST, BLE_ADV_EVT_PEER_ADDR_REQUEST } ble_adv_evt_t;
+typedef struct {
+    bool ble_adv_on_disconnect_disabled; bool ble_adv_whitelist_enabled; bool ble_adv_directed_enabled;
+    bool ble_adv_directed_slow_enabled; uint32_t ble_adv_directed_slow_interval; uint32_t ble_adv_directed_slow_timeout;
+    bool ble_adv_fast_enabled; uint32_t ble_adv_fast_interval; uint32_t ble_adv_fast_timeout;
+    bool ble_adv_slow_enabled; uint32_t ble_adv_slow_interval; uint32_t ble_adv_slow_timeout;
+} ble_adv_modes_config_t;
+typedef void (*ble_advertising_evt_handler_t)(ble_adv_evt_t const adv_evt);
+typedef void (*ble_advertising_error_handler_t)(uint32_t nrf_error);
+uint32_t ble_advertising_init(ble_advdata_t const * p_advdata, ble_advdata_t const * p_srdata, ble_adv_modes_config_t const * p_config,
+                              ble_advertising_evt_handler_t const evt_handler, ble_advertising_error_handler_t const error_handler);
+void ble_advertising_on_ble_evt(ble_evt_t const * const p_ble_evt);
+void ble_advertising_on_sys_evt(uint32_t const sys_evt);
+uint32_t ble_advertising_start(ble_adv_mode_t advertising_mode);
+uint32_t ble_advertising_peer_addr_reply(ble_gap_addr_t * p_peer_addr);
+uint32_t ble_advertising_whitelist_reply(ble_gap_addr_t const * p_gap_addrs, uint32_t addr_cnt, ble_gap_irk_t const * p_gap_irks, uint32_t irk_cnt);
+uint32_t ble_advertising_restart_without_whitelist(void);
+void ble_advertising_modes_config_set(ble_adv_modes_config_t const * const p_adv_modes_config);
+#endif
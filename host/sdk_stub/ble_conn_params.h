@@ -0,0 +1,20 @@
+/* Host stand-in for ble_conn_params.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef BLE_CONN_PARAMS_H__
+#define BLE_CONN_PARAMS_H__
+#include "ble_srv_common.h"
+typedef enum { BLE_CONN_PARAMS_EVT_FAILED, BLE_CONN_PARAMS_EVT_SUCCEEDED } ble_conn_params_evt_type_t;
+typedef struct { ble_conn_params_evt_type_t evt_type; } ble_conn_params_evt_t;
+typedef void (*ble_conn_params_evt_handler_t)(ble_conn_params_evt_t * p_evt);
+typedef struct {
+    ble_gap_conn_params_t * p_conn_params;
+    uint32_t first_conn_params_update_delay;
+    uint32_t next_conn_params_update_delay;
+    uint8_t  max_conn_params_update_count;
+    uint16_t start_on_notify_cccd_handle;
+    bool     disconnect_on_fail;
+    ble_conn_params_evt_handler_t evt_handler;
+    void (*error_handler)(uint32_t nrf_error);
+} ble_conn_params_init_t;
+uint32_t ble_conn_params_init(const ble_conn_params_init_t * p_init);
+void ble_conn_params_on_ble_evt(ble_evt_t * p_ble_evt);
+#endif
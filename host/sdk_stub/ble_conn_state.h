@@ -0,0 +1,9 @@
+/* Host stand-in for ble_conn_state.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef BLE_CONN_STATE_H__
+#define BLE_CONN_STATE_H__
+#include "ble.h"
+void ble_conn_state_on_ble_evt(ble_evt_t * p_ble_evt);
+uint8_t ble_conn_state_role(uint16_t conn_handle);
+uint32_t ble_conn_state_n_connections(void);
+bool ble_conn_state_encrypted(uint16_t conn_handle);
+#endif
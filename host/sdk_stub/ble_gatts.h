@@ -0,0 +1,2 @@
+/* Host stand-in for ble_gatts.h of nRF5 SDK 12, see sdk_stub.h */
+#include "ble.h"
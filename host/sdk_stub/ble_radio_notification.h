@@ -0,0 +1,9 @@
+/* Host stand-in for ble_radio_notification.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef BLE_RADIO_NOTIFICATION_H__
+#define BLE_RADIO_NOTIFICATION_H__
+#include <stdbool.h>
+#include <stdint.h>
+#include "nrf_soc.h"
+typedef void (*ble_radio_notification_evt_handler_t)(bool radio_active);
+uint32_t ble_radio_notification_init(uint32_t irq_priority, uint8_t distance, ble_radio_notification_evt_handler_t evt_handler);
+#endif
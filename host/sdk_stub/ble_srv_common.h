@@ -0,0 +1,25 @@
+/* Host stand-in for ble_srv_common.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef BLE_SRV_COMMON_H__
+#define BLE_SRV_COMMON_H__
+#include "ble.h"
+#define BLE_UUID_BATTERY_SERVICE            0x180F
+#define BLE_UUID_DEVICE_INFORMATION_SERVICE 0x180A
+#define BLE_UUID_TX_POWER_SERVICE           0x1804
+#define BLE_UUID_BATTERY_LEVEL_CHAR         0x2A19
+#define BLE_UUID_TX_POWER_LEVEL_CHAR        0x2A07
+typedef struct {
+    ble_gap_conn_sec_mode_t cccd_write_perm;
+    ble_gap_conn_sec_mode_t read_perm;
+    ble_gap_conn_sec_mode_t write_perm;
+} ble_srv_cccd_security_mode_t;
+typedef struct {
+    ble_gap_conn_sec_mode_t read_perm;
+    ble_gap_conn_sec_mode_t write_perm;
+} ble_srv_security_mode_t;
+typedef struct { uint8_t report_id; uint8_t report_type; } ble_srv_report_ref_t;
+static inline bool ble_srv_is_notification_enabled(uint8_t const * p_encoded_data)
+{
+    uint16_t v = (uint16_t)(p_encoded_data[0] | (p_encoded_data[1] << 8));
+    return ((v & BLE_GATT_HVX_NOTIFICATION) != 0);
+}
+#endif
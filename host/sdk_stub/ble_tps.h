@@ -0,0 +1,10 @@
+/* Host stand-in for ble_tps.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef BLE_TPS_H__
+#define BLE_TPS_H__
+#include "ble_srv_common.h"
+typedef struct { int8_t initial_tx_power_level; ble_srv_security_mode_t tps_attr_md; } ble_tps_init_t;
+typedef struct { uint16_t service_handle; ble_gatts_char_handles_t tx_power_level_handles; } ble_tps_t;
+uint32_t ble_tps_init(ble_tps_t * p_hrs, const ble_tps_init_t * p_tps_init);
+uint32_t ble_tps_tx_power_level_set(ble_tps_t * p_tps, int8_t tx_power_level);
+void ble_tps_on_ble_evt(ble_tps_t * p_tps, ble_evt_t * p_ble_evt);
+#endif
@@ -0,0 +1,6 @@
+/* Host stand-in for bsp.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef BSP_H__
+#define BSP_H__
+#include "nrf_sdk_fake.h"
+typedef enum { BSP_EVENT_NOTHING = 0, BSP_EVENT_SLEEP, BSP_EVENT_DISCONNECT, BSP_EVENT_WHITELIST_OFF } bsp_event_t;
+#endif
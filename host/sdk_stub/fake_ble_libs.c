@@ -0,0 +1,866 @@
+/**
+    @brief Host stand-in for BLE libraries of nRF5 SDK 12 used by application:
+    peer manager, ble_advertising, ble_advdata, ble_conn_params, ble_conn_state,
+    Battery and TX Power services, fstorage and app_error.
+
+    Libraries keep only behaviour visible to application, they call fake
+    SoftDevice, so their calls are recorded too.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stdlib.h>
+#include "fake_internal.h"
+#include "app_error.h"
+#include "ble_advertising.h"
+#include "ble_conn_params.h"
+#include "ble_conn_state.h"
+#include "ble_radio_notification.h"
+#include "ble_bas.h"
+#include "ble_tps.h"
+#include "fstorage.h"
+#include "peer_manager.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define FAKE_CONN_STATE_MAX     8U
+
+/// AD types of advertising data
+#define AD_TYPE_FLAGS                       0x01
+#define AD_TYPE_16BIT_SERVICE_UUID_COMPLETE 0x03
+#define AD_TYPE_128BIT_SERVICE_UUID_COMPLETE 0x07
+#define AD_TYPE_SHORT_LOCAL_NAME            0x08
+#define AD_TYPE_COMPLETE_LOCAL_NAME         0x09
+#define AD_TYPE_TX_POWER_LEVEL              0x0A
+#define AD_TYPE_APPEARANCE                  0x19
+#define AD_TYPE_MANUFACTURER_SPECIFIC_DATA  0xFF
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+static pm_evt_handler_t m_pm_handler = NULL;
+
+/// Bonds of peer manager, peer ID is index
+static ble_gap_addr_t m_pm_peer_addrs[BLE_GAP_WHITELIST_ADDR_MAX_COUNT];
+static uint16_t       m_pm_peer_conns[BLE_GAP_WHITELIST_ADDR_MAX_COUNT];   /**< link of peer */
+static uint16_t       m_pm_peer_count = 0;
+static pm_peer_id_t   m_pm_whitelist[BLE_GAP_WHITELIST_ADDR_MAX_COUNT];
+static uint32_t       m_pm_whitelist_count = 0;
+
+static ble_adv_modes_config_t          m_adv_config;
+static ble_advertising_evt_handler_t   m_adv_evt_handler = NULL;
+static ble_advertising_error_handler_t m_adv_error_handler = NULL;
+static ble_adv_mode_t                  m_adv_mode = BLE_ADV_MODE_IDLE;
+static ble_gap_addr_t                  m_adv_peer_addr;
+static bool                            m_adv_peer_addr_set = false;    /**< reply to peer address request */
+static bool                            m_adv_whitelist_set = false;    /**< reply to whitelist request with addresses */
+
+static uint16_t m_conn_handles[FAKE_CONN_STATE_MAX];
+static uint8_t  m_conn_count = 0;
+
+static uint32_t m_app_error_count = 0;
+
+static ble_radio_notification_evt_handler_t m_radio_handler = NULL;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void pm_fds_evt_handler(fds_evt_t const * const p_evt);
+static void pm_evt_dispatch(void const * p_data);
+static uint32_t adv_mode_start(ble_adv_mode_t mode);
+
+void fake_libs_reset(void) {
+
+    m_pm_handler        = NULL;
+    m_pm_peer_count     = 0;
+    m_pm_whitelist_count = 0;
+    m_adv_evt_handler   = NULL;
+    m_adv_error_handler = NULL;
+    m_adv_mode          = BLE_ADV_MODE_IDLE;
+    m_adv_peer_addr_set = false;
+    m_adv_whitelist_set = false;
+    m_conn_count        = 0;
+    m_app_error_count   = 0;
+    m_radio_handler     = NULL;
+    memset(&m_adv_config, 0, sizeof(m_adv_config));
+}
+
+uint32_t fake_app_error_count(void) {
+    return m_app_error_count;
+}
+
+/* ==================================================================== */
+/* ============================ app_error ============================= */
+/* ==================================================================== */
+
+void app_error_handler(uint32_t error_code, uint32_t line_num, const uint8_t * p_file_name) {
+
+    /// static: address is passed as 32-bit value like on target
+    static error_info_t error_info;
+
+    error_info = (error_info_t) {
+        .line_num    = line_num,
+        .p_file_name = p_file_name,
+        .err_code    = error_code,
+    };
+
+    m_app_error_count++;
+    fake_call_record(__func__, BLE_CONN_HANDLE_INVALID, (uint16_t)line_num,
+                     (uint8_t const *)&error_code, sizeof(error_code), error_code);
+    app_error_fault_handler(NRF_FAULT_ID_SDK_ERROR, 0, (uint32_t)(uintptr_t)&error_info);
+}
+
+void app_error_handler_bare(ret_code_t error_code) {
+    app_error_handler(error_code, 0, NULL);
+}
+
+/**
+    @brief Default handler stops host run like reset stops target,
+           application or harness can replace it
+*/
+__WEAK void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info) {
+
+    UNUSED_PARAMETER(pc);
+
+    if (id == NRF_FAULT_ID_SDK_ERROR) {
+        error_info_t const * p_info = (error_info_t const *)(uintptr_t)info;
+        fprintf(stderr, "app error 0x%x at %s:%u\n", p_info->err_code,
+                (p_info->p_file_name != NULL) ? (const char *)p_info->p_file_name : "?",
+                p_info->line_num);
+    } else {
+        fprintf(stderr, "fault 0x%x\n", id);
+    }
+    abort();
+}
+
+/* ==================================================================== */
+/* ============================ fstorage ============================== */
+/* ==================================================================== */
+
+void fs_sys_event_handler(uint32_t sys_evt) {
+    UNUSED_PARAMETER(sys_evt);
+}
+
+/* ==================================================================== */
+/* =========================== peer manager =========================== */
+/* ==================================================================== */
+
+static void pm_fds_evt_handler(fds_evt_t const * const p_evt) {
+    UNUSED_PARAMETER(p_evt);
+}
+
+static void pm_evt_dispatch(void const * p_data) {
+
+    pm_evt_t evt;
+    memcpy(&evt, p_data, sizeof(evt));
+
+    if (m_pm_handler != NULL)
+        m_pm_handler(&evt);
+}
+
+/**
+    @brief Peer manager shares FDS with application
+*/
+ret_code_t pm_init(void) {
+
+    ret_code_t err_code = fds_register(pm_fds_evt_handler);
+    if (err_code != FDS_SUCCESS)
+        return NRF_ERROR_INTERNAL;
+
+    return fds_init();
+}
+
+ret_code_t pm_register(pm_evt_handler_t event_handler) {
+
+    m_pm_handler = event_handler;
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Bond of link: peer gets address from its ID, application gets
+           PM_EVT_CONN_SEC_SUCCEEDED like after pairing with bonding
+*/
+pm_peer_id_t fake_pm_bond(uint16_t conn_handle) {
+
+    pm_evt_t     evt;
+    pm_peer_id_t peer_id = m_pm_peer_count;
+
+    if (peer_id >= BLE_GAP_WHITELIST_ADDR_MAX_COUNT)
+        return PM_PEER_ID_INVALID;
+    m_pm_peer_count++;
+
+    memset(&m_pm_peer_addrs[peer_id], 0, sizeof(m_pm_peer_addrs[peer_id]));
+    m_pm_peer_addrs[peer_id].addr_type = BLE_GAP_ADDR_TYPE_PUBLIC;
+    m_pm_peer_addrs[peer_id].addr[0]   = (uint8_t)(peer_id + 1);
+    m_pm_peer_addrs[peer_id].addr[5]   = 0xC0;
+    m_pm_peer_conns[peer_id]           = conn_handle;
+
+    memset(&evt, 0, sizeof(evt));
+    evt.evt_id      = PM_EVT_CONN_SEC_SUCCEEDED;
+    evt.conn_handle = conn_handle;
+    evt.peer_id     = peer_id;
+    fake_evt_queue(pm_evt_dispatch, &evt, sizeof(evt));
+    return peer_id;
+}
+
+/**
+    @brief Without bonds system attributes are empty, they are set on connect,
+           peer is without link after disconnect
+*/
+void pm_on_ble_evt(ble_evt_t * p_ble_evt) {
+
+    if (p_ble_evt->header.evt_id == BLE_GAP_EVT_CONNECTED) {
+        uint32_t err_code = sd_ble_gatts_sys_attr_set(p_ble_evt->evt.gap_evt.conn_handle, NULL, 0, 0);
+        APP_ERROR_CHECK(err_code);
+    }
+    if (p_ble_evt->header.evt_id == BLE_GAP_EVT_DISCONNECTED) {
+        for (uint16_t i = 0; i < m_pm_peer_count; i++) {
+            if (m_pm_peer_conns[i] == p_ble_evt->evt.gap_evt.conn_handle)
+                m_pm_peer_conns[i] = BLE_CONN_HANDLE_INVALID;
+        }
+    }
+}
+
+ret_code_t pm_sec_params_set(ble_gap_sec_params_t * p_sec_params) {
+
+    UNUSED_PARAMETER(p_sec_params);
+    return NRF_SUCCESS;
+}
+
+ret_code_t pm_peers_delete(void) {
+
+    pm_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.evt_id      = PM_EVT_PEERS_DELETE_SUCCEEDED;
+    evt.conn_handle = BLE_CONN_HANDLE_INVALID;
+    evt.peer_id     = PM_PEER_ID_INVALID;
+    fake_evt_queue(pm_evt_dispatch, &evt, sizeof(evt));
+    return NRF_SUCCESS;
+}
+
+ret_code_t pm_peer_delete(pm_peer_id_t peer_id) {
+
+    UNUSED_PARAMETER(peer_id);
+    return NRF_ERROR_INVALID_PARAM;
+}
+
+void pm_conn_sec_config_reply(uint16_t conn_handle, pm_conn_sec_config_t * p_conn_sec_config) {
+
+    uint8_t allow = p_conn_sec_config->allow_repairing;
+    fake_call_record(__func__, conn_handle, 0, &allow, 1, NRF_SUCCESS);
+}
+
+void pm_local_database_has_changed(void) {
+    fake_call_record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_SUCCESS);
+}
+
+ret_code_t pm_peer_id_get(uint16_t conn_handle, pm_peer_id_t * p_peer_id) {
+
+    *p_peer_id = PM_PEER_ID_INVALID;
+    for (uint16_t i = 0; i < m_pm_peer_count; i++) {
+        if (m_pm_peer_conns[i] == conn_handle)
+            *p_peer_id = i;
+    }
+    return NRF_SUCCESS;
+}
+
+pm_peer_id_t pm_next_peer_id_get(pm_peer_id_t prev_peer_id) {
+
+    pm_peer_id_t peer_id = (prev_peer_id == PM_PEER_ID_INVALID) ? 0 : (pm_peer_id_t)(prev_peer_id + 1);
+    return (peer_id < m_pm_peer_count) ? peer_id : PM_PEER_ID_INVALID;
+}
+
+uint32_t pm_peer_count(void) {
+    return m_pm_peer_count;
+}
+
+ret_code_t pm_peer_data_bonding_load(pm_peer_id_t peer_id, pm_peer_data_bonding_t * p_data) {
+
+    if (peer_id >= m_pm_peer_count)
+        return NRF_ERROR_NOT_FOUND;
+
+    memset(p_data, 0, sizeof(*p_data));
+    p_data->own_role                 = BLE_GAP_ROLE_PERIPH;
+    p_data->peer_ble_id.id_addr_info = m_pm_peer_addrs[peer_id];
+    return NRF_SUCCESS;
+}
+
+ret_code_t pm_whitelist_set(pm_peer_id_t const * p_peers, uint32_t peer_cnt) {
+
+    if (peer_cnt > BLE_GAP_WHITELIST_ADDR_MAX_COUNT)
+        return NRF_ERROR_INVALID_PARAM;
+    for (uint32_t i = 0; i < peer_cnt; i++) {
+        if (p_peers[i] >= m_pm_peer_count)
+            return NRF_ERROR_NOT_FOUND;
+        m_pm_whitelist[i] = p_peers[i];
+    }
+    m_pm_whitelist_count = peer_cnt;
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Addresses of whitelisted peers, bonds of fake have no IRKs
+*/
+ret_code_t pm_whitelist_get(ble_gap_addr_t * p_addrs, uint32_t * p_addr_cnt, ble_gap_irk_t * p_irks, uint32_t * p_irk_cnt) {
+
+    UNUSED_PARAMETER(p_irks);
+    if ((p_addr_cnt == NULL) || (*p_addr_cnt < m_pm_whitelist_count))
+        return NRF_ERROR_NO_MEM;
+
+    for (uint32_t i = 0; i < m_pm_whitelist_count; i++)
+        p_addrs[i] = m_pm_peer_addrs[m_pm_whitelist[i]];
+    *p_addr_cnt = m_pm_whitelist_count;
+    if (p_irk_cnt != NULL)
+        *p_irk_cnt = 0;
+    return NRF_SUCCESS;
+}
+
+ret_code_t pm_device_identities_list_set(pm_peer_id_t const * p_peers, uint32_t peer_cnt) {
+
+    UNUSED_PARAMETER(p_peers);
+    return (peer_cnt <= BLE_GAP_WHITELIST_ADDR_MAX_COUNT) ? NRF_SUCCESS : NRF_ERROR_INVALID_PARAM;
+}
+
+/* ==================================================================== */
+/* ============================ ble_advdata =========================== */
+/* ==================================================================== */
+
+/**
+    @brief Encode advertising data like ble_advdata of SDK, error if it doesn't fit in 31 bytes
+*/
+uint32_t adv_data_encode(ble_advdata_t const * const p_advdata, uint8_t * const p_encoded_data, uint16_t * const p_len) {
+
+    uint16_t max_len = *p_len;
+    uint16_t len     = 0;
+
+    #define ADV_PUT(BYTE) do { if (len >= max_len) return NRF_ERROR_DATA_SIZE; p_encoded_data[len++] = (uint8_t)(BYTE); } while (0)
+
+    if (p_advdata->name_type != BLE_ADVDATA_NO_NAME) {
+        uint8_t  name[BLE_GAP_ADV_MAX_SIZE];
+        uint16_t name_len = fake_sd_device_name_get(name, sizeof(name));
+        uint8_t  type     = AD_TYPE_COMPLETE_LOCAL_NAME;
+
+        if ((p_advdata->name_type == BLE_ADVDATA_SHORT_NAME) && (p_advdata->short_name_len < name_len)) {
+            name_len = p_advdata->short_name_len;
+            type     = AD_TYPE_SHORT_LOCAL_NAME;
+        }
+        ADV_PUT(name_len + 1);
+        ADV_PUT(type);
+        for (uint16_t i = 0; i < name_len; i++)
+            ADV_PUT(name[i]);
+    }
+
+    if (p_advdata->include_appearance) {
+        /// appearance set by sd_ble_gap_appearance_set() isn't kept, its size matters
+        ADV_PUT(3);
+        ADV_PUT(AD_TYPE_APPEARANCE);
+        ADV_PUT(BLE_APPEARANCE_GENERIC_TAG & 0xFF);
+        ADV_PUT(BLE_APPEARANCE_GENERIC_TAG >> 8);
+    }
+
+    if (p_advdata->flags != 0) {
+        ADV_PUT(2);
+        ADV_PUT(AD_TYPE_FLAGS);
+        ADV_PUT(p_advdata->flags);
+    }
+
+    if (p_advdata->p_tx_power_level != NULL) {
+        ADV_PUT(2);
+        ADV_PUT(AD_TYPE_TX_POWER_LEVEL);
+        ADV_PUT(*p_advdata->p_tx_power_level);
+    }
+
+    ble_advdata_uuid_list_t const * p_list = &p_advdata->uuids_complete;
+    if (p_list->uuid_cnt != 0) {
+        uint16_t count16 = 0;
+        for (uint16_t i = 0; i < p_list->uuid_cnt; i++) {
+            if (p_list->p_uuids[i].type == BLE_UUID_TYPE_BLE)
+                count16++;
+        }
+        if (count16 != 0) {
+            ADV_PUT(count16 * 2 + 1);
+            ADV_PUT(AD_TYPE_16BIT_SERVICE_UUID_COMPLETE);
+            for (uint16_t i = 0; i < p_list->uuid_cnt; i++) {
+                if (p_list->p_uuids[i].type == BLE_UUID_TYPE_BLE) {
+                    ADV_PUT(p_list->p_uuids[i].uuid & 0xFF);
+                    ADV_PUT(p_list->p_uuids[i].uuid >> 8);
+                }
+            }
+        }
+        for (uint16_t i = 0; i < p_list->uuid_cnt; i++) {
+            uint8_t uuid128[16];
+            if (p_list->p_uuids[i].type == BLE_UUID_TYPE_BLE)
+                continue;
+            if (fake_sd_uuid_base_get(p_list->p_uuids[i].type, uuid128) == false)
+                return NRF_ERROR_NOT_FOUND;
+            uuid128[12] = (uint8_t)p_list->p_uuids[i].uuid;
+            uuid128[13] = (uint8_t)(p_list->p_uuids[i].uuid >> 8);
+            ADV_PUT(17);
+            ADV_PUT(AD_TYPE_128BIT_SERVICE_UUID_COMPLETE);
+            for (uint8_t j = 0; j < sizeof(uuid128); j++)
+                ADV_PUT(uuid128[j]);
+        }
+    }
+
+    if (p_advdata->p_manuf_specific_data != NULL) {
+        ble_advdata_manuf_data_t const * p_manuf = p_advdata->p_manuf_specific_data;
+        ADV_PUT(p_manuf->data.size + 3);
+        ADV_PUT(AD_TYPE_MANUFACTURER_SPECIFIC_DATA);
+        ADV_PUT(p_manuf->company_identifier & 0xFF);
+        ADV_PUT(p_manuf->company_identifier >> 8);
+        for (uint16_t i = 0; i < p_manuf->data.size; i++)
+            ADV_PUT(p_manuf->data.p_data[i]);
+    }
+
+    #undef ADV_PUT
+
+    *p_len = len;
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_advdata_set(ble_advdata_t const * p_advdata, ble_advdata_t const * p_srdata) {
+
+    uint8_t  adv[BLE_GAP_ADV_MAX_SIZE];
+    uint8_t  sr[BLE_GAP_ADV_MAX_SIZE];
+    uint16_t adv_len = 0;
+    uint16_t sr_len  = 0;
+    uint32_t err_code;
+
+    if (p_advdata != NULL) {
+        adv_len  = sizeof(adv);
+        err_code = adv_data_encode(p_advdata, adv, &adv_len);
+        if (err_code != NRF_SUCCESS)
+            return err_code;
+    }
+    if (p_srdata != NULL) {
+        sr_len   = sizeof(sr);
+        err_code = adv_data_encode(p_srdata, sr, &sr_len);
+        if (err_code != NRF_SUCCESS)
+            return err_code;
+    }
+
+    return sd_ble_gap_adv_data_set(adv, (uint8_t)adv_len, sr, (uint8_t)sr_len);
+}
+
+/* ==================================================================== */
+/* ========================== ble_advertising ========================= */
+/* ==================================================================== */
+
+static uint32_t adv_mode_start(ble_adv_mode_t mode) {
+
+    ble_gap_adv_params_t adv_params;
+    ble_adv_evt_t        adv_evt;
+    uint32_t             err_code;
+
+    /// directed mode needs address of peer from application
+    if (mode == BLE_ADV_MODE_DIRECTED) {
+        m_adv_peer_addr_set = false;
+        if (m_adv_config.ble_adv_directed_enabled && (m_adv_evt_handler != NULL))
+            m_adv_evt_handler(BLE_ADV_EVT_PEER_ADDR_REQUEST);
+        if (m_adv_peer_addr_set == false)
+            mode = BLE_ADV_MODE_FAST;
+    }
+    if (mode == BLE_ADV_MODE_DIRECTED_SLOW)
+        mode = BLE_ADV_MODE_FAST;
+    /// disabled modes are skipped like in ble_advertising
+    if ((mode == BLE_ADV_MODE_FAST) && (m_adv_config.ble_adv_fast_enabled == false))
+        mode = BLE_ADV_MODE_SLOW;
+    if ((mode == BLE_ADV_MODE_SLOW) && (m_adv_config.ble_adv_slow_enabled == false))
+        mode = BLE_ADV_MODE_IDLE;
+
+    m_adv_mode = mode;
+
+    memset(&adv_params, 0, sizeof(adv_params));
+    adv_params.type = BLE_GAP_ADV_TYPE_ADV_IND;
+    adv_params.fp   = BLE_GAP_ADV_FP_ANY;
+
+    /// whitelist is requested from application for every start
+    m_adv_whitelist_set = false;
+    if (((mode == BLE_ADV_MODE_FAST) || (mode == BLE_ADV_MODE_SLOW)) &&
+        m_adv_config.ble_adv_whitelist_enabled && (m_adv_evt_handler != NULL))
+        m_adv_evt_handler(BLE_ADV_EVT_WHITELIST_REQUEST);
+    if (m_adv_whitelist_set)
+        adv_params.fp = BLE_GAP_ADV_FP_FILTER_CONNREQ;
+
+    switch (mode)
+    {
+        case BLE_ADV_MODE_DIRECTED:
+            /// high duty: interval and duration are fixed by stack
+            adv_params.type        = BLE_GAP_ADV_TYPE_ADV_DIRECT_IND;
+            adv_params.p_peer_addr = &m_adv_peer_addr;
+            adv_params.interval    = BLE_GAP_ADV_INTERVAL_MIN;
+            adv_evt                = BLE_ADV_EVT_DIRECTED;
+            break;
+
+        case BLE_ADV_MODE_FAST:
+            adv_params.interval = (uint16_t)m_adv_config.ble_adv_fast_interval;
+            adv_params.timeout  = (uint16_t)m_adv_config.ble_adv_fast_timeout;
+            adv_evt             = m_adv_whitelist_set ? BLE_ADV_EVT_FAST_WHITELIST : BLE_ADV_EVT_FAST;
+            break;
+
+        case BLE_ADV_MODE_SLOW:
+            adv_params.interval = (uint16_t)m_adv_config.ble_adv_slow_interval;
+            adv_params.timeout  = (uint16_t)m_adv_config.ble_adv_slow_timeout;
+            adv_evt             = m_adv_whitelist_set ? BLE_ADV_EVT_SLOW_WHITELIST : BLE_ADV_EVT_SLOW;
+            break;
+
+        default:
+            if (m_adv_evt_handler != NULL)
+                m_adv_evt_handler(BLE_ADV_EVT_IDLE);
+            return NRF_SUCCESS;
+    }
+
+    err_code = sd_ble_gap_adv_start(&adv_params);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    if (m_adv_evt_handler != NULL)
+        m_adv_evt_handler(adv_evt);
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_advertising_init(ble_advdata_t const * p_advdata, ble_advdata_t const * p_srdata,
+                              ble_adv_modes_config_t const * p_config,
+                              ble_advertising_evt_handler_t const evt_handler,
+                              ble_advertising_error_handler_t const error_handler) {
+
+    if ((p_advdata == NULL) || (p_config == NULL))
+        return NRF_ERROR_NULL;
+
+    m_adv_config        = *p_config;
+    m_adv_evt_handler   = evt_handler;
+    m_adv_error_handler = error_handler;
+    m_adv_mode          = BLE_ADV_MODE_IDLE;
+
+    return ble_advdata_set(p_advdata, p_srdata);
+}
+
+/**
+    @brief Advertising goes to next mode after timeout and is restarted after disconnect
+*/
+void ble_advertising_on_ble_evt(ble_evt_t const * const p_ble_evt) {
+
+    uint32_t err_code = NRF_SUCCESS;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            m_adv_mode = BLE_ADV_MODE_IDLE;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            if (m_adv_config.ble_adv_on_disconnect_disabled == false)
+                err_code = adv_mode_start(BLE_ADV_MODE_DIRECTED);
+            break;
+
+        case BLE_GAP_EVT_TIMEOUT:
+            if (p_ble_evt->evt.gap_evt.params.timeout.src == BLE_GAP_TIMEOUT_SRC_ADVERTISING) {
+                if ((m_adv_mode == BLE_ADV_MODE_DIRECTED) || (m_adv_mode == BLE_ADV_MODE_DIRECTED_SLOW))
+                    err_code = adv_mode_start(BLE_ADV_MODE_FAST);
+                else if (m_adv_mode == BLE_ADV_MODE_FAST)
+                    err_code = adv_mode_start(BLE_ADV_MODE_SLOW);
+                else
+                    err_code = adv_mode_start(BLE_ADV_MODE_IDLE);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if ((err_code != NRF_SUCCESS) && (m_adv_error_handler != NULL))
+        m_adv_error_handler(err_code);
+}
+
+void ble_advertising_on_sys_evt(uint32_t const sys_evt) {
+    UNUSED_PARAMETER(sys_evt);
+}
+
+uint32_t ble_advertising_start(ble_adv_mode_t advertising_mode) {
+    return adv_mode_start(advertising_mode);
+}
+
+uint32_t ble_advertising_peer_addr_reply(ble_gap_addr_t * p_peer_addr) {
+
+    m_adv_peer_addr     = *p_peer_addr;
+    m_adv_peer_addr_set = true;
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_advertising_whitelist_reply(ble_gap_addr_t const * p_gap_addrs, uint32_t addr_cnt,
+                                         ble_gap_irk_t const * p_gap_irks, uint32_t irk_cnt) {
+
+    UNUSED_PARAMETER(p_gap_addrs);
+    UNUSED_PARAMETER(p_gap_irks);
+    m_adv_whitelist_set = ((addr_cnt + irk_cnt) != 0);
+    return NRF_SUCCESS;
+}
+
+uint32_t ble_advertising_restart_without_whitelist(void) {
+
+    if (m_adv_mode == BLE_ADV_MODE_IDLE)
+        return NRF_ERROR_INVALID_STATE;
+
+    uint32_t err_code = sd_ble_gap_adv_stop();
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+    return adv_mode_start(m_adv_mode);
+}
+
+void ble_advertising_modes_config_set(ble_adv_modes_config_t const * const p_adv_modes_config) {
+    m_adv_config = *p_adv_modes_config;
+}
+
+/* ==================================================================== */
+/* ====================== ble_radio_notification ====================== */
+/* ==================================================================== */
+
+/**
+    @brief Notification before and after radio events, SWI1 is called from fake SoftDevice
+*/
+uint32_t ble_radio_notification_init(uint32_t irq_priority, uint8_t distance, ble_radio_notification_evt_handler_t evt_handler) {
+
+    UNUSED_PARAMETER(irq_priority);
+    m_radio_handler = evt_handler;
+    return sd_radio_notification_cfg_set(NRF_RADIO_NOTIFICATION_TYPE_INT_ON_BOTH, distance);
+}
+
+void fake_libs_radio_notification(bool radio_active) {
+
+    if (m_radio_handler != NULL)
+        m_radio_handler(radio_active);
+}
+
+/* ==================================================================== */
+/* ========================= ble_conn_params ========================== */
+/* ==================================================================== */
+
+uint32_t ble_conn_params_init(const ble_conn_params_init_t * p_init) {
+    return (p_init != NULL) ? NRF_SUCCESS : NRF_ERROR_NULL;
+}
+
+void ble_conn_params_on_ble_evt(ble_evt_t * p_ble_evt) {
+    UNUSED_PARAMETER(p_ble_evt);
+}
+
+/* ==================================================================== */
+/* ========================== ble_conn_state ========================== */
+/* ==================================================================== */
+
+void ble_conn_state_on_ble_evt(ble_evt_t * p_ble_evt) {
+
+    uint16_t conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            if (m_conn_count < FAKE_CONN_STATE_MAX)
+                m_conn_handles[m_conn_count++] = conn_handle;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            for (uint8_t i = 0; i < m_conn_count; i++) {
+                if (m_conn_handles[i] == conn_handle) {
+                    m_conn_handles[i] = m_conn_handles[--m_conn_count];
+                    break;
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+uint8_t ble_conn_state_role(uint16_t conn_handle) {
+
+    for (uint8_t i = 0; i < m_conn_count; i++) {
+        if (m_conn_handles[i] == conn_handle)
+            return BLE_GAP_ROLE_PERIPH;
+    }
+    return BLE_GAP_ROLE_INVALID;
+}
+
+uint32_t ble_conn_state_n_connections(void) {
+    return m_conn_count;
+}
+
+bool ble_conn_state_encrypted(uint16_t conn_handle) {
+
+    UNUSED_PARAMETER(conn_handle);
+    return false;
+}
+
+/* ==================================================================== */
+/* ========================== Battery Service ========================= */
+/* ==================================================================== */
+
+uint32_t ble_bas_init(ble_bas_t * p_bas, const ble_bas_init_t * p_bas_init) {
+
+    ble_uuid_t          ble_uuid;
+    ble_gatts_char_md_t char_md;
+    ble_gatts_attr_md_t attr_md;
+    ble_gatts_attr_t    attr_char_value;
+    uint8_t             initial_battery_level = p_bas_init->initial_batt_level;
+    uint32_t            err_code;
+
+    p_bas->evt_handler               = p_bas_init->evt_handler;
+    p_bas->conn_handle               = BLE_CONN_HANDLE_INVALID;
+    p_bas->is_notification_supported = p_bas_init->support_notification;
+    p_bas->battery_level_last        = 0xFF;
+
+    ble_uuid.type = BLE_UUID_TYPE_BLE;
+    ble_uuid.uuid = BLE_UUID_BATTERY_SERVICE;
+    err_code = sd_ble_gatts_service_add(BLE_GATTS_SRVC_TYPE_PRIMARY, &ble_uuid, &p_bas->service_handle);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    memset(&char_md, 0, sizeof(char_md));
+    char_md.char_props.read   = 1;
+    char_md.char_props.notify = p_bas->is_notification_supported ? 1 : 0;
+
+    memset(&attr_md, 0, sizeof(attr_md));
+    attr_md.read_perm  = p_bas_init->battery_level_char_attr_md.read_perm;
+    attr_md.write_perm = p_bas_init->battery_level_char_attr_md.write_perm;
+    attr_md.vloc       = BLE_GATTS_VLOC_STACK;
+
+    ble_uuid.uuid = BLE_UUID_BATTERY_LEVEL_CHAR;
+    memset(&attr_char_value, 0, sizeof(attr_char_value));
+    attr_char_value.p_uuid    = &ble_uuid;
+    attr_char_value.p_attr_md = &attr_md;
+    attr_char_value.init_len  = sizeof(uint8_t);
+    attr_char_value.max_len   = sizeof(uint8_t);
+    attr_char_value.p_value   = &initial_battery_level;
+
+    err_code = sd_ble_gatts_characteristic_add(p_bas->service_handle, &char_md, &attr_char_value,
+                                               &p_bas->battery_level_handles);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    p_bas->battery_level_last = initial_battery_level;
+    return NRF_SUCCESS;
+}
+
+void ble_bas_on_ble_evt(ble_bas_t * p_bas, ble_evt_t * p_ble_evt) {
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            p_bas->conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            p_bas->conn_handle = BLE_CONN_HANDLE_INVALID;
+            break;
+
+        case BLE_GATTS_EVT_WRITE:
+        {
+            ble_gatts_evt_write_t const * p_evt_write = &p_ble_evt->evt.gatts_evt.params.write;
+
+            if (p_bas->is_notification_supported &&
+                (p_evt_write->handle == p_bas->battery_level_handles.cccd_handle) &&
+                (p_evt_write->len == BLE_CCCD_VALUE_LEN) && (p_bas->evt_handler != NULL)) {
+
+                ble_bas_evt_t evt;
+                evt.evt_type = ble_srv_is_notification_enabled(p_evt_write->data)
+                             ? BLE_BAS_EVT_NOTIFICATION_ENABLED : BLE_BAS_EVT_NOTIFICATION_DISABLED;
+                p_bas->evt_handler(p_bas, &evt);
+            }
+        } break;
+
+        default:
+            break;
+    }
+}
+
+uint32_t ble_bas_battery_level_update(ble_bas_t * p_bas, uint8_t battery_level) {
+
+    if (battery_level == p_bas->battery_level_last)
+        return NRF_SUCCESS;
+
+    ble_gatts_value_t gatts_value;
+    memset(&gatts_value, 0, sizeof(gatts_value));
+    gatts_value.len     = sizeof(uint8_t);
+    gatts_value.p_value = &battery_level;
+
+    uint32_t err_code = sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
+                                               p_bas->battery_level_handles.value_handle,
+                                               &gatts_value);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    p_bas->battery_level_last = battery_level;
+
+    if ((p_bas->conn_handle == BLE_CONN_HANDLE_INVALID) || (p_bas->is_notification_supported == false))
+        return NRF_ERROR_INVALID_STATE;
+
+    ble_gatts_hvx_params_t hvx_params;
+    memset(&hvx_params, 0, sizeof(hvx_params));
+    hvx_params.handle = p_bas->battery_level_handles.value_handle;
+    hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+    hvx_params.p_len  = &gatts_value.len;
+    hvx_params.p_data = gatts_value.p_value;
+
+    return sd_ble_gatts_hvx(p_bas->conn_handle, &hvx_params);
+}
+
+/* ==================================================================== */
+/* ========================= TX Power Service ========================= */
+/* ==================================================================== */
+
+uint32_t ble_tps_init(ble_tps_t * p_tps, const ble_tps_init_t * p_tps_init) {
+
+    ble_uuid_t          ble_uuid;
+    ble_gatts_char_md_t char_md;
+    ble_gatts_attr_md_t attr_md;
+    ble_gatts_attr_t    attr_char_value;
+    int8_t              tx_power_level = p_tps_init->initial_tx_power_level;
+    uint32_t            err_code;
+
+    ble_uuid.type = BLE_UUID_TYPE_BLE;
+    ble_uuid.uuid = BLE_UUID_TX_POWER_SERVICE;
+    err_code = sd_ble_gatts_service_add(BLE_GATTS_SRVC_TYPE_PRIMARY, &ble_uuid, &p_tps->service_handle);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    memset(&char_md, 0, sizeof(char_md));
+    char_md.char_props.read = 1;
+
+    memset(&attr_md, 0, sizeof(attr_md));
+    attr_md.read_perm  = p_tps_init->tps_attr_md.read_perm;
+    attr_md.write_perm = p_tps_init->tps_attr_md.write_perm;
+    attr_md.vloc       = BLE_GATTS_VLOC_STACK;
+
+    ble_uuid.uuid = BLE_UUID_TX_POWER_LEVEL_CHAR;
+    memset(&attr_char_value, 0, sizeof(attr_char_value));
+    attr_char_value.p_uuid    = &ble_uuid;
+    attr_char_value.p_attr_md = &attr_md;
+    attr_char_value.init_len  = sizeof(int8_t);
+    attr_char_value.max_len   = sizeof(int8_t);
+    attr_char_value.p_value   = (uint8_t *)&tx_power_level;
+
+    return sd_ble_gatts_characteristic_add(p_tps->service_handle, &char_md, &attr_char_value,
+                                           &p_tps->tx_power_level_handles);
+}
+
+uint32_t ble_tps_tx_power_level_set(ble_tps_t * p_tps, int8_t tx_power_level) {
+
+    ble_gatts_value_t gatts_value;
+    memset(&gatts_value, 0, sizeof(gatts_value));
+    gatts_value.len     = sizeof(int8_t);
+    gatts_value.p_value = (uint8_t *)&tx_power_level;
+
+    return sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID, p_tps->tx_power_level_handles.value_handle,
+                                  &gatts_value);
+}
+
+void ble_tps_on_ble_evt(ble_tps_t * p_tps, ble_evt_t * p_ble_evt) {
+
+    UNUSED_PARAMETER(p_tps);
+    UNUSED_PARAMETER(p_ble_evt);
+}
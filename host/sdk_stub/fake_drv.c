@@ -0,0 +1,453 @@
+/**
+    @brief Host stand-in for drivers of nRF5 SDK 12: nrf_gpio, nrf_drv_gpiote,
+    nrf_drv_saadc, SEGGER RTT and registers of core used by application
+    (POWER, DWT, SCB).
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stdlib.h>
+#include <time.h>
+#include "fake_internal.h"
+#include "nrf.h"
+#include "nrf_gpio.h"
+#include "nrf_drv_gpiote.h"
+#include "nrf_drv_saadc.h"
+#include "SEGGER_RTT.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define FAKE_PIN_COUNT          48U     /**< P0 and P1 of nRF52840 */
+#define FAKE_SAADC_CHANNELS     8U
+#define FAKE_SAADC_BUFFERS      2U      /**< driver keeps current and next buffer */
+#define FAKE_RTT_CHANNELS       2U
+#define FAKE_RTT_CAPACITY       65536U  /**< data of channel kept for harness */
+#define FAKE_DWT_PER_TICK       ((64000000U + 16384U) / 32768U)  /**< CPU cycles in RTC1 tick */
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief Up channel of RTT, host reads everything what is written
+*/
+typedef struct {
+    bool     configured;
+    uint32_t len;
+    uint8_t  data[FAKE_RTT_CAPACITY];
+} fake_rtt_channel_t;
+
+static fake_rtt_channel_t m_rtt[FAKE_RTT_CHANNELS];
+
+NRF_POWER_Type fake_power;
+CoreDebug_Type fake_coredebug;
+DWT_Type       fake_dwt;
+
+bool            fake_dwt_host_clock = false;        /**< DWT counts host time of code too */
+static double   m_dwt_cycles_per_ns = 0;
+static double   m_dwt_fraction = 0;                 /**< cycles not added yet */
+static uint64_t m_dwt_host_ns = 0;                  /**< host time of last update */
+SCB_Type       fake_scb;
+
+/** @brief State of one pin
+*/
+typedef struct {
+    bool     output;
+    uint8_t  out_level;
+    uint8_t  in_level;                          /**< level driven from outside */
+    bool     gpiote;                            /**< pin has GPIOTE event */
+    bool     gpiote_enabled;
+    nrf_gpiote_polarity_t        sense;
+    nrf_drv_gpiote_evt_handler_t handler;
+} fake_pin_t;
+
+static fake_pin_t m_pins[FAKE_PIN_COUNT];
+static bool       m_gpiote_initialized = false;
+
+/** @brief Event of GPIOTE for queue
+*/
+typedef struct {
+    nrf_drv_gpiote_evt_handler_t handler;
+    nrf_drv_gpiote_pin_t         pin;
+    nrf_gpiote_polarity_t        action;
+} fake_gpiote_evt_t;
+
+static nrf_drv_saadc_event_handler_t m_saadc_handler = NULL;
+static nrf_saadc_value_t * m_saadc_buffers[FAKE_SAADC_BUFFERS];
+static uint16_t            m_saadc_sizes[FAKE_SAADC_BUFFERS];
+static uint8_t             m_saadc_buffer_count = 0;
+static nrf_saadc_value_t   m_saadc_values[FAKE_SAADC_CHANNELS];
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static fake_pin_t * pin_get(uint32_t pin);
+static void gpiote_evt_dispatch(void const * p_data);
+static void saadc_evt_dispatch(void const * p_data);
+
+static fake_pin_t * pin_get(uint32_t pin) {
+
+    if (pin >= FAKE_PIN_COUNT) {
+        fprintf(stderr, "fake: pin %u doesn't exist\n", pin);
+        abort();
+    }
+    return &m_pins[pin];
+}
+
+static void gpiote_evt_dispatch(void const * p_data) {
+
+    fake_gpiote_evt_t evt;
+    memcpy(&evt, p_data, sizeof(evt));
+    evt.handler(evt.pin, evt.action);
+}
+
+static void saadc_evt_dispatch(void const * p_data) {
+
+    nrf_drv_saadc_evt_t evt;
+    memcpy(&evt, p_data, sizeof(evt));
+
+    if (m_saadc_handler != NULL)
+        m_saadc_handler(&evt);
+}
+
+static uint64_t host_ns(void) {
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+/**
+    @brief Host time from last access of DWT is added as CPU cycles
+*/
+void fake_dwt_host_update(void) {
+
+    uint64_t now = host_ns();
+
+    if ((fake_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0) {
+        double cycles    = (double)(now - m_dwt_host_ns) * m_dwt_cycles_per_ns + m_dwt_fraction;
+        uint32_t whole   = (uint32_t)cycles;
+        m_dwt_fraction   = cycles - whole;
+        fake_dwt.CYCCNT += whole;
+    }
+    m_dwt_host_ns = now;
+}
+
+void fake_dwt_advance(uint32_t ticks) {
+
+    if ((fake_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0)
+        fake_dwt.CYCCNT += ticks * FAKE_DWT_PER_TICK;
+}
+
+/**
+    @brief Reset requested by application (fault handler) ends host run
+*/
+void NVIC_SystemReset(void) {
+
+    fprintf(stderr, "fake: system reset\n");
+    abort();
+}
+
+void fake_drv_reset(void) {
+
+    memset(m_pins, 0, sizeof(m_pins));
+    m_gpiote_initialized = false;
+    m_saadc_handler      = NULL;
+    m_saadc_buffer_count = 0;
+
+    /// VDD is 3 V, other inputs are in the middle of range
+    for (uint8_t i = 0; i < FAKE_SAADC_CHANNELS; i++)
+        m_saadc_values[i] = 512;
+    m_saadc_values[0] = 853;
+
+    for (uint8_t i = 0; i < FAKE_RTT_CHANNELS; i++) {
+        m_rtt[i].configured = false;
+        m_rtt[i].len        = 0;
+    }
+
+    memset(&fake_power, 0, sizeof(fake_power));
+    memset(&fake_coredebug, 0, sizeof(fake_coredebug));
+    memset(&fake_dwt, 0, sizeof(fake_dwt));
+    m_dwt_fraction = 0;
+    m_dwt_host_ns  = host_ns();
+    memset(&fake_scb, 0, sizeof(fake_scb));
+    fake_power.RESETREAS = POWER_RESETREAS_RESETPIN_Msk;
+}
+
+/* ==================================================================== */
+/* ========================== harness control ========================= */
+/* ==================================================================== */
+
+/**
+    @brief Level of input is changed from outside, GPIOTE event is queued if it is enabled
+*/
+void fake_gpio_input_set(uint32_t pin, uint32_t level) {
+
+    fake_pin_t * p_pin = pin_get(pin);
+    uint8_t      old   = p_pin->in_level;
+
+    p_pin->in_level = (level != 0);
+    if ((old == p_pin->in_level) || (p_pin->gpiote_enabled == false))
+        return;
+
+    nrf_gpiote_polarity_t action = p_pin->in_level ? NRF_GPIOTE_POLARITY_LOTOHI : NRF_GPIOTE_POLARITY_HITOLO;
+    if ((p_pin->sense & action) == 0)
+        return;
+
+    fake_gpiote_evt_t evt = {p_pin->handler, pin, action};
+    fake_evt_queue(gpiote_evt_dispatch, &evt, sizeof(evt));
+}
+
+uint32_t fake_gpio_output_get(uint32_t pin) {
+    return pin_get(pin)->out_level;
+}
+
+/**
+    @brief Results of next conversions, one value per channel
+*/
+void fake_saadc_values_set(int16_t const * p_values, uint8_t count) {
+    memcpy(m_saadc_values, p_values, MIN(count, FAKE_SAADC_CHANNELS) * sizeof(int16_t));
+}
+
+/**
+    @brief DWT counts also host time of code, scaled to CPU cycles, for timing of boot
+    @param[in] cycles_per_ns - scale of host time, 0 - DWT follows only RTC1
+*/
+void fake_dwt_host_clock_set(double cycles_per_ns) {
+
+    m_dwt_cycles_per_ns = cycles_per_ns;
+    m_dwt_fraction      = 0;
+    m_dwt_host_ns       = host_ns();
+    fake_dwt_host_clock = (cycles_per_ns > 0);
+}
+
+/* ==================================================================== */
+/* ============================= nrf_gpio ============================= */
+/* ==================================================================== */
+
+void nrf_gpio_cfg_output(uint32_t pin_number) {
+    pin_get(pin_number)->output = true;
+}
+
+void nrf_gpio_cfg_input(uint32_t pin_number, nrf_gpio_pin_pull_t pull_config) {
+
+    fake_pin_t * p_pin = pin_get(pin_number);
+    p_pin->output   = false;
+    p_pin->in_level = (pull_config == NRF_GPIO_PIN_PULLUP);
+}
+
+void nrf_gpio_pin_write(uint32_t pin_number, uint32_t value) {
+
+    fake_pin_t * p_pin = pin_get(pin_number);
+    uint8_t      level = (value != 0);
+
+    if (p_pin->out_level != level)
+        fake_call_record(__func__, BLE_CONN_HANDLE_INVALID, (uint16_t)pin_number, &level, 1, NRF_SUCCESS);
+    p_pin->out_level = level;
+}
+
+void nrf_gpio_pin_set(uint32_t pin_number) {
+    nrf_gpio_pin_write(pin_number, 1);
+}
+
+void nrf_gpio_pin_clear(uint32_t pin_number) {
+    nrf_gpio_pin_write(pin_number, 0);
+}
+
+uint32_t nrf_gpio_pin_read(uint32_t pin_number) {
+
+    fake_pin_t const * p_pin = pin_get(pin_number);
+    return p_pin->output ? p_pin->out_level : p_pin->in_level;
+}
+
+/* ==================================================================== */
+/* ========================== nrf_drv_gpiote ========================== */
+/* ==================================================================== */
+
+ret_code_t nrf_drv_gpiote_init(void) {
+
+    if (m_gpiote_initialized)
+        return NRF_ERROR_INVALID_STATE;
+
+    m_gpiote_initialized = true;
+    return NRF_SUCCESS;
+}
+
+bool nrf_drv_gpiote_is_init(void) {
+    return m_gpiote_initialized;
+}
+
+ret_code_t nrf_drv_gpiote_in_init(nrf_drv_gpiote_pin_t pin, nrf_drv_gpiote_in_config_t const * p_config,
+                                  nrf_drv_gpiote_evt_handler_t evt_handler) {
+
+    fake_pin_t * p_pin = pin_get(pin);
+
+    if (p_pin->gpiote)
+        return NRF_ERROR_INVALID_STATE;
+
+    p_pin->gpiote   = true;
+    p_pin->sense    = p_config->sense;
+    p_pin->handler  = evt_handler;
+    nrf_gpio_cfg_input(pin, p_config->pull);
+    return NRF_SUCCESS;
+}
+
+void nrf_drv_gpiote_in_event_enable(nrf_drv_gpiote_pin_t pin, bool int_enable) {
+    pin_get(pin)->gpiote_enabled = int_enable;
+}
+
+void nrf_drv_gpiote_in_event_disable(nrf_drv_gpiote_pin_t pin) {
+    pin_get(pin)->gpiote_enabled = false;
+}
+
+/* ==================================================================== */
+/* ========================== nrf_drv_saadc =========================== */
+/* ==================================================================== */
+
+ret_code_t nrf_drv_saadc_init(nrf_drv_saadc_config_t const * p_config, nrf_drv_saadc_event_handler_t event_handler) {
+
+    UNUSED_PARAMETER(p_config);
+
+    if (m_saadc_handler != NULL)
+        return NRF_ERROR_INVALID_STATE;
+    if (event_handler == NULL)
+        return NRF_ERROR_INVALID_PARAM;
+
+    m_saadc_handler = event_handler;
+    return NRF_SUCCESS;
+}
+
+void nrf_drv_saadc_uninit(void) {
+    m_saadc_handler      = NULL;
+    m_saadc_buffer_count = 0;
+}
+
+ret_code_t nrf_drv_saadc_channel_init(uint8_t channel, nrf_saadc_channel_config_t const * const p_config) {
+
+    UNUSED_PARAMETER(p_config);
+    return (channel < FAKE_SAADC_CHANNELS) ? NRF_SUCCESS : NRF_ERROR_INVALID_PARAM;
+}
+
+ret_code_t nrf_drv_saadc_buffer_convert(nrf_saadc_value_t * buffer, uint16_t size) {
+
+    if (m_saadc_handler == NULL)
+        return NRF_ERROR_INVALID_STATE;
+    if (m_saadc_buffer_count == FAKE_SAADC_BUFFERS)
+        return NRF_ERROR_BUSY;
+
+    m_saadc_buffers[m_saadc_buffer_count] = buffer;
+    m_saadc_sizes[m_saadc_buffer_count]   = size;
+    m_saadc_buffer_count++;
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Conversion of all channels to current buffer, DONE event is queued
+*/
+ret_code_t nrf_drv_saadc_sample(void) {
+
+    if (m_saadc_buffer_count == 0) {
+        fake_call_record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_INVALID_STATE);
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    nrf_saadc_value_t * p_buffer = m_saadc_buffers[0];
+    uint16_t            size     = m_saadc_sizes[0];
+
+    for (uint16_t i = 0; i < size; i++)
+        p_buffer[i] = m_saadc_values[i % FAKE_SAADC_CHANNELS];
+
+    m_saadc_buffers[0] = m_saadc_buffers[1];
+    m_saadc_sizes[0]   = m_saadc_sizes[1];
+    m_saadc_buffer_count--;
+
+    nrf_drv_saadc_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.type               = NRF_DRV_SAADC_EVT_DONE;
+    evt.data.done.p_buffer = p_buffer;
+    evt.data.done.size     = size;
+    fake_evt_queue(saadc_evt_dispatch, &evt, sizeof(evt));
+
+    fake_call_record(__func__, BLE_CONN_HANDLE_INVALID, 0, (uint8_t const *)p_buffer,
+                     (uint16_t)(size * sizeof(nrf_saadc_value_t)), NRF_SUCCESS);
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Calibration is possible only for idle SAADC, CALIBRATEDONE event is queued
+*/
+ret_code_t nrf_drv_saadc_calibrate_offset(void) {
+
+    if (m_saadc_handler == NULL)
+        return NRF_ERROR_INVALID_STATE;
+    if (m_saadc_buffer_count != 0)
+        return NRF_ERROR_BUSY;
+
+    nrf_drv_saadc_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.type = NRF_DRV_SAADC_EVT_CALIBRATEDONE;
+    fake_evt_queue(saadc_evt_dispatch, &evt, sizeof(evt));
+
+    fake_call_record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_SUCCESS);
+    return NRF_SUCCESS;
+}
+
+bool nrf_drv_saadc_is_busy(void) {
+    return (m_saadc_buffer_count != 0);
+}
+
+/* ==================================================================== */
+/* ================================ RTT =============================== */
+/* ==================================================================== */
+
+/**
+    @brief Channel 0 is configured by default like in SEGGER RTT, others by application
+*/
+int SEGGER_RTT_ConfigUpBuffer(unsigned BufferIndex, const char * sName, void * pBuffer,
+                              unsigned BufferSize, unsigned Flags) {
+
+    (void)sName;
+    (void)pBuffer;
+    (void)BufferSize;
+    (void)Flags;
+
+    if (BufferIndex >= FAKE_RTT_CHANNELS)
+        return -1;
+    m_rtt[BufferIndex].configured = true;
+    return 0;
+}
+
+/**
+    @brief Data is written whole or not at all, like in SEGGER_RTT_MODE_NO_BLOCK_SKIP
+*/
+unsigned SEGGER_RTT_Write(unsigned BufferIndex, const void * pBuffer, unsigned NumBytes) {
+
+    if ((BufferIndex >= FAKE_RTT_CHANNELS) ||
+        ((BufferIndex != 0) && (m_rtt[BufferIndex].configured == false)))
+        return 0;
+
+    fake_rtt_channel_t * p_channel = &m_rtt[BufferIndex];
+    if (NumBytes > (FAKE_RTT_CAPACITY - p_channel->len))
+        return 0;
+
+    memcpy(&p_channel->data[p_channel->len], pBuffer, NumBytes);
+    p_channel->len += NumBytes;
+    return NumBytes;
+}
+
+/**
+    @brief Data written to up channel of RTT
+    @return length of data
+*/
+uint32_t fake_rtt_data_get(uint8_t channel, uint8_t const ** pp_data) {
+
+    if (channel >= FAKE_RTT_CHANNELS) {
+        *pp_data = NULL;
+        return 0;
+    }
+    *pp_data = m_rtt[channel].data;
+    return m_rtt[channel].len;
+}
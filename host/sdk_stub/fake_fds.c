@@ -0,0 +1,380 @@
+/**
+    @brief Host stand-in for Flash Data Storage of nRF5 SDK 12 in RAM.
+
+    Flash has FDS_VIRTUAL_PAGES pages, one of them is swap page for GC.
+    Update and delete leave dirty records, space of them is free only after GC.
+    Every operation is queued and its event is sent to all users, queue has
+    FDS_OP_QUEUE_SIZE operations like in FDS. Data is copied at the call.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include "fake_internal.h"
+#include "fds.h"
+#include "sdk_config.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define FAKE_FDS_RECORDS        64U     /**< Count of records in flash, valid and dirty */
+#define FAKE_FDS_RECORD_WORDS   32U     /**< Max length of record data */
+#define FAKE_FDS_HEADER_WORDS   3U      /**< Record header in flash */
+#define FAKE_FDS_PAGE_TAG_WORDS 2U      /**< Page tag in flash */
+
+/// Data pages without swap page
+#define FAKE_FDS_CAPACITY_WORDS ((FDS_VIRTUAL_PAGES - 1) * (FDS_VIRTUAL_PAGE_SIZE - FAKE_FDS_PAGE_TAG_WORDS))
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief Record in flash
+*/
+typedef struct {
+    bool         in_use;                    /**< record takes space in flash */
+    bool         valid;                     /**< false for dirty record */
+    fds_header_t header;
+    uint32_t     data[FAKE_FDS_RECORD_WORDS];
+} fake_record_t;
+
+static fake_record_t m_records[FAKE_FDS_RECORDS];
+static uint32_t      m_record_id = 0;
+
+static fds_cb_t m_users[FDS_MAX_USERS];
+static uint8_t  m_user_count = 0;
+
+static bool     m_initialized  = false;
+static bool     m_initializing = false;
+static uint8_t  m_ops_queued   = 0;         /**< operations which have no event yet */
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void fds_evt_dispatch(void const * p_data);
+static ret_code_t op_queue(fds_evt_t const * p_evt);
+static uint32_t words_used(void);
+static fake_record_t * record_by_id(uint32_t record_id);
+static ret_code_t record_store(fds_record_desc_t * p_desc, fds_record_t const * p_record,
+                               fds_evt_id_t evt_id, fake_record_t * p_old);
+
+static void fds_evt_dispatch(void const * p_data) {
+
+    fds_evt_t evt;
+    memcpy(&evt, p_data, sizeof(evt));
+
+    if (evt.id == FDS_EVT_INIT) {
+        m_initializing = false;
+        m_initialized  = true;
+    } else if (m_ops_queued > 0) {
+        m_ops_queued--;
+    }
+
+    for (uint8_t i = 0; i < m_user_count; i++)
+        m_users[i](&evt);
+}
+
+static ret_code_t op_queue(fds_evt_t const * p_evt) {
+
+    if (m_ops_queued >= FDS_OP_QUEUE_SIZE)
+        return FDS_ERR_NO_SPACE_IN_QUEUES;
+
+    m_ops_queued++;
+    fake_evt_queue(fds_evt_dispatch, p_evt, sizeof(*p_evt));
+    return FDS_SUCCESS;
+}
+
+static uint32_t words_used(void) {
+
+    uint32_t words = 0;
+
+    for (uint32_t i = 0; i < FAKE_FDS_RECORDS; i++) {
+        if (m_records[i].in_use)
+            words += FAKE_FDS_HEADER_WORDS + m_records[i].header.tl.length_words;
+    }
+    return words;
+}
+
+static fake_record_t * record_by_id(uint32_t record_id) {
+
+    for (uint32_t i = 0; i < FAKE_FDS_RECORDS; i++) {
+        if (m_records[i].in_use && m_records[i].valid && (m_records[i].header.record_id == record_id))
+            return &m_records[i];
+    }
+    return NULL;
+}
+
+/** @brief Write new record, old record is dirty after update
+*/
+static ret_code_t record_store(fds_record_desc_t * p_desc, fds_record_t const * p_record,
+                               fds_evt_id_t evt_id, fake_record_t * p_old) {
+
+    uint32_t length_words = 0;
+    uint32_t i;
+
+    if (m_initialized == false)
+        return FDS_ERR_NOT_INITIALIZED;
+
+    for (i = 0; i < p_record->data.num_chunks; i++)
+        length_words += p_record->data.p_chunks[i].length_words;
+
+    if (length_words > FAKE_FDS_RECORD_WORDS)
+        return FDS_ERR_RECORD_TOO_LARGE;
+
+    if (words_used() + FAKE_FDS_HEADER_WORDS + length_words > FAKE_FDS_CAPACITY_WORDS)
+        return FDS_ERR_NO_SPACE_IN_FLASH;
+
+    for (i = 0; i < FAKE_FDS_RECORDS; i++) {
+        if (m_records[i].in_use == false)
+            break;
+    }
+    if (i == FAKE_FDS_RECORDS)
+        return FDS_ERR_NO_SPACE_IN_FLASH;
+
+    fds_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.id                      = evt_id;
+    evt.result                  = FDS_SUCCESS;
+    evt.write.record_id         = ++m_record_id;
+    evt.write.file_id           = p_record->file_id;
+    evt.write.record_key        = p_record->key;
+    evt.write.is_record_updated = (p_old != NULL);
+
+    ret_code_t err_code = op_queue(&evt);
+    if (err_code != FDS_SUCCESS) {
+        m_record_id--;
+        return err_code;
+    }
+
+    fake_record_t * p_new = &m_records[i];
+    uint8_t       * p_dst = (uint8_t *)p_new->data;
+
+    memset(p_new, 0, sizeof(*p_new));
+    p_new->in_use                  = true;
+    p_new->valid                   = true;
+    p_new->header.tl.record_key    = p_record->key;
+    p_new->header.tl.length_words  = (uint16_t)length_words;
+    p_new->header.ic.file_id       = p_record->file_id;
+    p_new->header.record_id        = m_record_id;
+
+    for (uint32_t c = 0; c < p_record->data.num_chunks; c++) {
+        uint32_t size = p_record->data.p_chunks[c].length_words * sizeof(uint32_t);
+        memcpy(p_dst, p_record->data.p_chunks[c].p_data, size);
+        p_dst += size;
+    }
+
+    if (p_old != NULL)
+        p_old->valid = false;
+
+    if (p_desc != NULL) {
+        memset(p_desc, 0, sizeof(*p_desc));
+        p_desc->record_id = m_record_id;
+    }
+
+    fake_call_record(evt_id == FDS_EVT_UPDATE ? "fds_record_update" : "fds_record_write",
+                     BLE_CONN_HANDLE_INVALID, p_record->key, (uint8_t const *)p_new->data,
+                     (uint16_t)(length_words * sizeof(uint32_t)), FDS_SUCCESS);
+    return FDS_SUCCESS;
+}
+
+void fake_fds_reset(void) {
+
+    memset(m_records, 0, sizeof(m_records));
+    m_record_id    = 0;
+    m_user_count   = 0;
+    m_initialized  = false;
+    m_initializing = false;
+    m_ops_queued   = 0;
+}
+
+/* ==================================================================== */
+/* ========================== harness control ========================= */
+/* ==================================================================== */
+
+/**
+    @brief Erase all pages, like new device. Users and state of module are kept.
+*/
+void fake_fds_erase(void) {
+    memset(m_records, 0, sizeof(m_records));
+}
+
+/* ==================================================================== */
+/* =============================== FDS ================================ */
+/* ==================================================================== */
+
+ret_code_t fds_register(fds_cb_t cb) {
+
+    if (m_user_count == FDS_MAX_USERS)
+        return FDS_ERR_USER_LIMIT_REACHED;
+
+    m_users[m_user_count++] = cb;
+    return FDS_SUCCESS;
+}
+
+/**
+    @brief Init is shared by all users: the first call queues INIT event,
+           calls while init is in progress do nothing, later calls queue event again
+*/
+ret_code_t fds_init(void) {
+
+    if (m_initializing)
+        return FDS_SUCCESS;
+
+    if (m_initialized == false)
+        m_initializing = true;
+
+    fds_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.id     = FDS_EVT_INIT;
+    evt.result = FDS_SUCCESS;
+    fake_evt_queue(fds_evt_dispatch, &evt, sizeof(evt));
+    return FDS_SUCCESS;
+}
+
+ret_code_t fds_record_find(uint16_t file_id, uint16_t record_key, fds_record_desc_t * p_desc, fds_find_token_t * p_token) {
+
+    if (m_initialized == false)
+        return FDS_ERR_NOT_INITIALIZED;
+
+    /// token keeps index of the next record to check
+    for (uint32_t i = p_token->page; i < FAKE_FDS_RECORDS; i++) {
+        fake_record_t const * p_rec = &m_records[i];
+        if (p_rec->in_use && p_rec->valid && (p_rec->header.ic.file_id == file_id) &&
+            (p_rec->header.tl.record_key == record_key)) {
+            memset(p_desc, 0, sizeof(*p_desc));
+            p_desc->record_id = p_rec->header.record_id;
+            p_desc->p_record  = p_rec->data;
+            p_token->page     = (uint16_t)(i + 1);
+            p_token->p_addr   = p_rec->data;
+            return FDS_SUCCESS;
+        }
+    }
+    return FDS_ERR_NOT_FOUND;
+}
+
+ret_code_t fds_record_find_in_file(uint16_t file_id, fds_record_desc_t * p_desc, fds_find_token_t * p_token) {
+
+    if (m_initialized == false)
+        return FDS_ERR_NOT_INITIALIZED;
+
+    for (uint32_t i = p_token->page; i < FAKE_FDS_RECORDS; i++) {
+        fake_record_t const * p_rec = &m_records[i];
+        if (p_rec->in_use && p_rec->valid && (p_rec->header.ic.file_id == file_id)) {
+            memset(p_desc, 0, sizeof(*p_desc));
+            p_desc->record_id = p_rec->header.record_id;
+            p_desc->p_record  = p_rec->data;
+            p_token->page     = (uint16_t)(i + 1);
+            p_token->p_addr   = p_rec->data;
+            return FDS_SUCCESS;
+        }
+    }
+    return FDS_ERR_NOT_FOUND;
+}
+
+ret_code_t fds_record_open(fds_record_desc_t * p_desc, fds_flash_record_t * p_flash_record) {
+
+    fake_record_t const * p_rec = record_by_id(p_desc->record_id);
+
+    if (p_rec == NULL)
+        return FDS_ERR_NOT_FOUND;
+
+    p_flash_record->p_header = &p_rec->header;
+    p_flash_record->p_data   = p_rec->data;
+    return FDS_SUCCESS;
+}
+
+ret_code_t fds_record_close(fds_record_desc_t * p_desc) {
+
+    UNUSED_PARAMETER(p_desc);
+    return FDS_SUCCESS;
+}
+
+ret_code_t fds_record_write(fds_record_desc_t * p_desc, fds_record_t const * p_record) {
+    return record_store(p_desc, p_record, FDS_EVT_WRITE, NULL);
+}
+
+ret_code_t fds_record_update(fds_record_desc_t * p_desc, fds_record_t const * p_record) {
+
+    fake_record_t * p_old = record_by_id(p_desc->record_id);
+
+    if (p_old == NULL)
+        return FDS_ERR_NOT_FOUND;
+
+    return record_store(p_desc, p_record, FDS_EVT_UPDATE, p_old);
+}
+
+ret_code_t fds_record_delete(fds_record_desc_t * p_desc) {
+
+    if (m_initialized == false)
+        return FDS_ERR_NOT_INITIALIZED;
+
+    fake_record_t * p_rec = record_by_id(p_desc->record_id);
+    if (p_rec == NULL)
+        return FDS_ERR_NOT_FOUND;
+
+    fds_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.id             = FDS_EVT_DEL_RECORD;
+    evt.result         = FDS_SUCCESS;
+    evt.del.record_id  = p_rec->header.record_id;
+    evt.del.file_id    = p_rec->header.ic.file_id;
+    evt.del.record_key = p_rec->header.tl.record_key;
+
+    ret_code_t err_code = op_queue(&evt);
+    if (err_code == FDS_SUCCESS)
+        p_rec->valid = false;
+    return err_code;
+}
+
+/**
+    @brief Dirty records are removed, their space is free
+*/
+ret_code_t fds_gc(void) {
+
+    if (m_initialized == false)
+        return FDS_ERR_NOT_INITIALIZED;
+
+    fds_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.id     = FDS_EVT_GC;
+    evt.result = FDS_SUCCESS;
+
+    ret_code_t err_code = op_queue(&evt);
+    if (err_code != FDS_SUCCESS)
+        return err_code;
+
+    for (uint32_t i = 0; i < FAKE_FDS_RECORDS; i++) {
+        if (m_records[i].in_use && (m_records[i].valid == false))
+            m_records[i].in_use = false;
+    }
+
+    fake_call_record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, FDS_SUCCESS);
+    return FDS_SUCCESS;
+}
+
+ret_code_t fds_stat(fds_stat_t * p_stat) {
+
+    if (m_initialized == false)
+        return FDS_ERR_NOT_INITIALIZED;
+
+    memset(p_stat, 0, sizeof(*p_stat));
+    p_stat->pages_available = FDS_VIRTUAL_PAGES - 1;
+
+    for (uint32_t i = 0; i < FAKE_FDS_RECORDS; i++) {
+        fake_record_t const * p_rec = &m_records[i];
+        if (p_rec->in_use == false)
+            continue;
+        uint16_t words = (uint16_t)(FAKE_FDS_HEADER_WORDS + p_rec->header.tl.length_words);
+        if (p_rec->valid) {
+            p_stat->valid_records++;
+        } else {
+            p_stat->dirty_records++;
+            p_stat->freeable_words += words;
+        }
+        p_stat->words_used += words;
+    }
+    p_stat->largest_contig = (uint16_t)(FAKE_FDS_CAPACITY_WORDS - p_stat->words_used);
+    return FDS_SUCCESS;
+}
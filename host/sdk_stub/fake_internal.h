@@ -0,0 +1,40 @@
+/*!
+    @brief Internal interface between parts of the fake layer, not used by harness.
+*/
+
+#ifndef FAKE_INTERNAL_H__
+#define FAKE_INTERNAL_H__
+
+#include "sdk_stub.h"
+
+#define FAKE_EVT_DATA_MAX       64U     /**< Max size of queued event */
+#define FAKE_EVT_QUEUE_SIZE     128U    /**< Count of queued events */
+
+/**@brief Dispatcher of queued event, called from fake_events_process(). */
+typedef void (*fake_evt_dispatch_t)(void const * p_data);
+
+/** Queue event, it is dispatched in order with all other events (BLE, SAADC, FDS, GPIOTE) */
+void fake_evt_queue(fake_evt_dispatch_t dispatch, void const * p_data, uint16_t size);
+bool fake_evt_pending(void);
+
+/** Deadlines of SoftDevice (advertising timeout), app_timer advances time through them */
+bool fake_sd_deadline_get(uint64_t * p_ticks);
+void fake_sd_deadline_expired(uint64_t now);
+
+/** Radio notification of application is called by SoftDevice around connection events */
+void fake_libs_radio_notification(bool radio_active);
+
+/** Data of GAP used by encoder of advertising data */
+uint16_t fake_sd_device_name_get(uint8_t * p_buf, uint16_t max_len);
+bool fake_sd_uuid_base_get(uint8_t uuid_type, uint8_t * p_uuid128);
+
+/** Time of DWT is advanced with RTC1 */
+void fake_dwt_advance(uint32_t ticks);
+
+void fake_sd_reset(void);
+void fake_timer_reset(void);
+void fake_drv_reset(void);
+void fake_fds_reset(void);
+void fake_libs_reset(void);
+
+#endif
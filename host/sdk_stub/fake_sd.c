@@ -0,0 +1,1136 @@
+/**
+    @brief Host stand-in for S132 v3: GATT server database, links, advertising,
+    queue of events and log of calls.
+
+    Behaviour follows the SoftDevice where application depends on it:
+    notification needs connection, system attributes, enabled CCCD and free
+    TX buffer, otherwise the same error codes as S132 are returned.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stdlib.h>
+#include "fake_internal.h"
+#include "softdevice_handler.h"
+#include "app_timer.h"
+#include "nrf_soc.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define FAKE_ATTR_MAX           128U    /**< Count of attributes in database */
+#define FAKE_ATTR_VALUE_MAX     512U    /**< Max length of attribute value */
+#define FAKE_LINK_MAX           8U      /**< Count of simultaneous links */
+#define FAKE_UUID_VS_MAX        4U      /**< Count of vendor specific bases */
+#define FAKE_TX_BUFFERS_DEFAULT 6U      /**< TX buffers of link with default bandwidth */
+#define FAKE_DEVICE_NAME_MAX    32U
+/// Connection interval of fake_ble_evt_connected(), connection events of all links are together
+#define FAKE_CONN_INTERVAL_MS   30U
+
+#define FAKE_ATTR_SERVICE       0x01
+#define FAKE_ATTR_CHAR_DECL     0x02
+#define FAKE_ATTR_VALUE         0x03
+#define FAKE_ATTR_CCCD          0x04
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief One attribute of GATT server
+*/
+typedef struct {
+    uint8_t  kind;                              /**< FAKE_ATTR_xxx */
+    uint16_t uuid;
+    uint8_t  uuid_type;
+    uint8_t  props_notify;                      /**< value can be notified or indicated */
+    uint8_t  rd_auth;                           /**< read is authorized by application */
+    uint16_t len;
+    uint16_t max_len;
+    uint8_t  value[FAKE_ATTR_VALUE_MAX];
+    uint8_t * p_value;                          /**< value, or memory of application for BLE_GATTS_VLOC_USER */
+    uint16_t cccd[FAKE_LINK_MAX];               /**< CCCD is stored per link */
+} fake_attr_t;
+
+/** @brief One link
+*/
+typedef struct {
+    bool     connected;
+    bool     sys_attr_set;
+    uint8_t  tx_free;                           /**< free TX buffers */
+    uint8_t  tx_in_flight;                      /**< queued packets, freed by TX_COMPLETE */
+    int8_t   rssi;
+    bool     rssi_active;
+    uint16_t att_mtu;                           /**< notification carries up to att_mtu - 3 bytes */
+    uint16_t auth_handle;                       /**< attribute of pending authorize request */
+} fake_link_t;
+
+static fake_attr_t m_attrs[FAKE_ATTR_MAX + 1];  /**< index is handle, 0 is invalid */
+static uint16_t    m_attr_count = 0;
+
+static fake_link_t m_links[FAKE_LINK_MAX];      /**< index is connection handle */
+static uint8_t     m_tx_buffers = FAKE_TX_BUFFERS_DEFAULT;
+static int8_t      m_rssi_default = -60;
+
+static ble_uuid128_t m_uuid_vs[FAKE_UUID_VS_MAX];
+static uint8_t       m_uuid_vs_count = 0;
+
+static uint8_t  m_device_name[FAKE_DEVICE_NAME_MAX];
+static uint16_t m_device_name_len = 0;
+
+static bool     m_enabled = false;
+static bool     m_advertising = false;
+static uint64_t m_adv_deadline = 0;             /**< 0 - advertising without timeout */
+static bool     m_system_off = false;
+static uint8_t  m_radio_notification = NRF_RADIO_NOTIFICATION_TYPE_NONE;
+static uint64_t m_conn_evt_next = 0;            /**< 0 - no links */
+
+static ble_evt_handler_t m_ble_evt_handler = NULL;
+static sys_evt_handler_t m_sys_evt_handler = NULL;
+static fake_idle_hook_t  m_idle_hook = NULL;
+static fake_hvx_hook_t   m_hvx_hook = NULL;
+
+/** @brief Queue of events of all sources
+*/
+typedef struct {
+    fake_evt_dispatch_t dispatch;
+    uint8_t             data[FAKE_EVT_DATA_MAX] __attribute__((aligned(8)));
+} fake_evt_t;
+
+static fake_evt_t m_evt_queue[FAKE_EVT_QUEUE_SIZE];
+static uint32_t   m_evt_head = 0;
+static uint32_t   m_evt_tail = 0;
+
+/** @brief Log of calls, ring buffer
+*/
+static fake_call_t m_calls[FAKE_CALL_LOG_SIZE];
+static uint32_t    m_calls_total = 0;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static fake_attr_t * attr_get(uint16_t handle);
+static uint16_t attr_add(uint8_t kind, uint16_t uuid, uint8_t uuid_type);
+static fake_link_t * link_get(uint16_t conn_handle);
+static uint32_t record(const char * name, uint16_t conn_handle, uint16_t handle,
+                       void const * p_data, uint16_t len, uint32_t result);
+static void ble_evt_dispatch(void const * p_data);
+static void sys_evt_dispatch(void const * p_data);
+
+static fake_attr_t * attr_get(uint16_t handle) {
+
+    if ((handle == BLE_GATT_HANDLE_INVALID) || (handle > m_attr_count))
+        return NULL;
+    return &m_attrs[handle];
+}
+
+static uint16_t attr_add(uint8_t kind, uint16_t uuid, uint8_t uuid_type) {
+
+    if (m_attr_count >= FAKE_ATTR_MAX)
+        return BLE_GATT_HANDLE_INVALID;
+
+    m_attr_count++;
+    fake_attr_t * p_attr = &m_attrs[m_attr_count];
+    memset(p_attr, 0, sizeof(*p_attr));
+    p_attr->kind      = kind;
+    p_attr->uuid      = uuid;
+    p_attr->uuid_type = uuid_type;
+    p_attr->p_value   = p_attr->value;
+    return m_attr_count;
+}
+
+static fake_link_t * link_get(uint16_t conn_handle) {
+
+    if ((conn_handle >= FAKE_LINK_MAX) || (m_links[conn_handle].connected == false))
+        return NULL;
+    return &m_links[conn_handle];
+}
+
+static uint32_t record(const char * name, uint16_t conn_handle, uint16_t handle,
+                       void const * p_data, uint16_t len, uint32_t result) {
+
+    fake_call_record(name, conn_handle, handle, (uint8_t const *)p_data, len, result);
+    return result;
+}
+
+static void ble_evt_dispatch(void const * p_data) {
+
+    ble_evt_t evt;
+    memcpy(&evt, p_data, sizeof(evt));
+
+    /// state of links is changed before application gets event, like in SoftDevice
+    switch (evt.header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+        {
+            uint16_t conn_handle = evt.evt.gap_evt.conn_handle;
+            if (conn_handle < FAKE_LINK_MAX) {
+                memset(&m_links[conn_handle], 0, sizeof(m_links[conn_handle]));
+                m_links[conn_handle].connected = true;
+                m_links[conn_handle].tx_free   = m_tx_buffers;
+                m_links[conn_handle].rssi      = m_rssi_default;
+                m_links[conn_handle].att_mtu   = GATT_MTU_SIZE_DEFAULT;
+                for (uint16_t h = 1; h <= m_attr_count; h++)
+                    m_attrs[h].cccd[conn_handle] = 0;
+            }
+            /// peripheral stops advertising when connected
+            m_advertising  = false;
+            m_adv_deadline = 0;
+            if (m_conn_evt_next == 0)
+                m_conn_evt_next = fake_time_ticks() + (FAKE_CONN_INTERVAL_MS * APP_TIMER_CLOCK_FREQ) / 1000U;
+        } break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+        {
+            bool connected = false;
+            if (evt.evt.gap_evt.conn_handle < FAKE_LINK_MAX)
+                m_links[evt.evt.gap_evt.conn_handle].connected = false;
+            for (uint16_t i = 0; i < FAKE_LINK_MAX; i++)
+                connected |= m_links[i].connected;
+            if (connected == false)
+                m_conn_evt_next = 0;
+        } break;
+
+        case BLE_GAP_EVT_TIMEOUT:
+            if (evt.evt.gap_evt.params.timeout.src == BLE_GAP_TIMEOUT_SRC_ADVERTISING)
+                m_advertising = false;
+            break;
+
+        default:
+            break;
+    }
+
+    if (m_ble_evt_handler != NULL)
+        m_ble_evt_handler(&evt);
+}
+
+static void sys_evt_dispatch(void const * p_data) {
+
+    uint32_t sys_evt;
+    memcpy(&sys_evt, p_data, sizeof(sys_evt));
+
+    if (m_sys_evt_handler != NULL)
+        m_sys_evt_handler(sys_evt);
+}
+
+/* ==================================================================== */
+/* ======================= internal of fake layer ===================== */
+/* ==================================================================== */
+
+void fake_evt_queue(fake_evt_dispatch_t dispatch, void const * p_data, uint16_t size) {
+
+    if ((m_evt_head - m_evt_tail) >= FAKE_EVT_QUEUE_SIZE) {
+        fprintf(stderr, "fake: event queue overflow\n");
+        abort();
+    }
+    if (size > FAKE_EVT_DATA_MAX) {
+        fprintf(stderr, "fake: event of %u bytes is too large\n", size);
+        abort();
+    }
+
+    fake_evt_t * p_evt = &m_evt_queue[m_evt_head % FAKE_EVT_QUEUE_SIZE];
+    p_evt->dispatch = dispatch;
+    memcpy(p_evt->data, p_data, size);
+    m_evt_head++;
+}
+
+bool fake_evt_pending(void) {
+    return (m_evt_head != m_evt_tail);
+}
+
+/**
+    @brief Timeout of advertising, or connection event, when application gets radio notification
+*/
+bool fake_sd_deadline_get(uint64_t * p_ticks) {
+
+    bool found = false;
+
+    if (m_advertising && (m_adv_deadline != 0)) {
+        *p_ticks = m_adv_deadline;
+        found    = true;
+    }
+    if ((m_radio_notification != NRF_RADIO_NOTIFICATION_TYPE_NONE) && (m_conn_evt_next != 0) &&
+        ((found == false) || (m_conn_evt_next < *p_ticks))) {
+        *p_ticks = m_conn_evt_next;
+        found    = true;
+    }
+    return found;
+}
+
+void fake_sd_deadline_expired(uint64_t now) {
+
+    /// signals before and after connection event
+    if ((m_radio_notification != NRF_RADIO_NOTIFICATION_TYPE_NONE) && (m_conn_evt_next != 0) &&
+        (m_conn_evt_next <= now)) {
+        m_conn_evt_next += (FAKE_CONN_INTERVAL_MS * APP_TIMER_CLOCK_FREQ) / 1000U;
+        fake_libs_radio_notification(true);
+        fake_libs_radio_notification(false);
+    }
+
+    if (m_advertising && (m_adv_deadline != 0) && (m_adv_deadline <= now)) {
+        m_adv_deadline = 0;
+
+        ble_evt_t evt;
+        memset(&evt, 0, sizeof(evt));
+        evt.header.evt_id                      = BLE_GAP_EVT_TIMEOUT;
+        evt.evt.gap_evt.conn_handle            = BLE_CONN_HANDLE_INVALID;
+        evt.evt.gap_evt.params.timeout.src     = BLE_GAP_TIMEOUT_SRC_ADVERTISING;
+        fake_ble_evt_push(&evt);
+    }
+}
+
+uint16_t fake_sd_device_name_get(uint8_t * p_buf, uint16_t max_len) {
+
+    uint16_t len = MIN(m_device_name_len, max_len);
+    memcpy(p_buf, m_device_name, len);
+    return len;
+}
+
+bool fake_sd_uuid_base_get(uint8_t uuid_type, uint8_t * p_uuid128) {
+
+    if ((uuid_type < BLE_UUID_TYPE_VENDOR_BEGIN) ||
+        (uuid_type >= BLE_UUID_TYPE_VENDOR_BEGIN + m_uuid_vs_count))
+        return false;
+    memcpy(p_uuid128, m_uuid_vs[uuid_type - BLE_UUID_TYPE_VENDOR_BEGIN].uuid128, 16);
+    return true;
+}
+
+void fake_sd_reset(void) {
+
+    memset(m_attrs, 0, sizeof(m_attrs));
+    memset(m_links, 0, sizeof(m_links));
+    m_attr_count      = 0;
+    m_tx_buffers      = FAKE_TX_BUFFERS_DEFAULT;
+    m_rssi_default    = -60;
+    m_uuid_vs_count   = 0;
+    m_device_name_len = 0;
+    m_enabled         = false;
+    m_advertising     = false;
+    m_adv_deadline    = 0;
+    m_system_off      = false;
+    m_radio_notification = NRF_RADIO_NOTIFICATION_TYPE_NONE;
+    m_conn_evt_next   = 0;
+    m_ble_evt_handler = NULL;
+    m_sys_evt_handler = NULL;
+    m_idle_hook       = NULL;
+    m_hvx_hook        = NULL;
+    m_evt_head        = 0;
+    m_evt_tail        = 0;
+    m_calls_total     = 0;
+}
+
+/* ==================================================================== */
+/* ========================== harness control ========================= */
+/* ==================================================================== */
+
+/**
+    @brief Reset all parts of fake layer, must be called before every run of application
+*/
+void fake_reset(void) {
+    fake_sd_reset();
+    fake_timer_reset();
+    fake_drv_reset();
+    fake_fds_reset();
+    fake_libs_reset();
+}
+
+void fake_idle_hook_set(fake_idle_hook_t hook) {
+    m_idle_hook = hook;
+}
+
+/**
+    @brief Handler registered by application, harness can call it without queue
+*/
+ble_evt_handler_t fake_ble_evt_handler_get(void) {
+    return m_ble_evt_handler;
+}
+
+bool fake_system_is_off(void) {
+    return m_system_off;
+}
+
+void fake_call_record(const char * name, uint16_t conn_handle, uint16_t handle,
+                      uint8_t const * p_data, uint16_t len, uint32_t result) {
+
+    fake_call_t * p_call = &m_calls[m_calls_total % FAKE_CALL_LOG_SIZE];
+
+    p_call->name        = name;
+    p_call->ticks       = fake_time_ticks();
+    p_call->conn_handle = conn_handle;
+    p_call->handle      = handle;
+    p_call->result      = result;
+    p_call->len         = len;
+    memset(p_call->data, 0, sizeof(p_call->data));
+    if (p_data != NULL)
+        memcpy(p_call->data, p_data, MIN(len, FAKE_CALL_DATA_MAX));
+
+    m_calls_total++;
+}
+
+uint32_t fake_calls_total(void) {
+    return m_calls_total;
+}
+
+uint32_t fake_call_count(const char * name) {
+
+    uint32_t count = 0;
+    uint32_t first = (m_calls_total > FAKE_CALL_LOG_SIZE) ? (m_calls_total - FAKE_CALL_LOG_SIZE) : 0;
+
+    for (uint32_t i = first; i < m_calls_total; i++) {
+        if (strcmp(m_calls[i % FAKE_CALL_LOG_SIZE].name, name) == 0)
+            count++;
+    }
+    return count;
+}
+
+fake_call_t const * fake_call_last(const char * name) {
+
+    uint32_t first = (m_calls_total > FAKE_CALL_LOG_SIZE) ? (m_calls_total - FAKE_CALL_LOG_SIZE) : 0;
+
+    for (uint32_t i = m_calls_total; i > first; i--) {
+        fake_call_t const * p_call = &m_calls[(i - 1) % FAKE_CALL_LOG_SIZE];
+        if (strcmp(p_call->name, name) == 0)
+            return p_call;
+    }
+    return NULL;
+}
+
+void fake_calls_clear(void) {
+    m_calls_total = 0;
+}
+
+/**
+    @brief Print count of calls of every function and count of failed calls
+*/
+void fake_calls_summary(FILE * p_file) {
+
+    const char * names[64];
+    uint32_t     counts[64];
+    uint32_t     errors[64];
+    uint32_t     n = 0;
+    uint32_t     first = (m_calls_total > FAKE_CALL_LOG_SIZE) ? (m_calls_total - FAKE_CALL_LOG_SIZE) : 0;
+
+    for (uint32_t i = first; i < m_calls_total; i++) {
+        fake_call_t const * p_call = &m_calls[i % FAKE_CALL_LOG_SIZE];
+        uint32_t j;
+        for (j = 0; j < n; j++) {
+            if (strcmp(names[j], p_call->name) == 0)
+                break;
+        }
+        if (j == n) {
+            if (n == ARRAY_SIZE(names))
+                continue;
+            names[n]  = p_call->name;
+            counts[n] = 0;
+            errors[n] = 0;
+            n++;
+        }
+        counts[j]++;
+        if (p_call->result != NRF_SUCCESS)
+            errors[j]++;
+    }
+
+    for (uint32_t j = 0; j < n; j++)
+        fprintf(p_file, "  %-36s %6u calls, %4u failed\n", names[j], counts[j], errors[j]);
+}
+
+/* ------------------------------- events ------------------------------ */
+
+void fake_ble_evt_push(ble_evt_t const * p_evt) {
+    fake_evt_queue(ble_evt_dispatch, p_evt, sizeof(*p_evt));
+}
+
+void fake_ble_evt_connected(uint16_t conn_handle) {
+
+    ble_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                        = BLE_GAP_EVT_CONNECTED;
+    evt.evt.gap_evt.conn_handle              = conn_handle;
+    evt.evt.gap_evt.params.connected.role    = BLE_GAP_ROLE_PERIPH;
+    evt.evt.gap_evt.params.connected.conn_params.min_conn_interval = MSEC_TO_UNITS(30, UNIT_1_25_MS);
+    evt.evt.gap_evt.params.connected.conn_params.max_conn_interval = MSEC_TO_UNITS(30, UNIT_1_25_MS);
+    evt.evt.gap_evt.params.connected.conn_params.conn_sup_timeout  = MSEC_TO_UNITS(4000, UNIT_10_MS);
+    fake_ble_evt_push(&evt);
+}
+
+void fake_ble_evt_disconnected(uint16_t conn_handle, uint8_t reason) {
+
+    ble_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                          = BLE_GAP_EVT_DISCONNECTED;
+    evt.evt.gap_evt.conn_handle                = conn_handle;
+    evt.evt.gap_evt.params.disconnected.reason = reason;
+    fake_ble_evt_push(&evt);
+}
+
+/**
+    @brief Write of central, value in database is changed before event like in SoftDevice
+*/
+void fake_ble_evt_write(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len) {
+
+    fake_attr_t * p_attr = attr_get(handle);
+    ble_evt_t     evt;
+
+    memset(&evt, 0, sizeof(evt));
+    len = MIN(len, sizeof(evt.evt.gatts_evt.params.write.data));
+
+    if (p_attr != NULL) {
+        if ((p_attr->kind == FAKE_ATTR_CCCD) && (conn_handle < FAKE_LINK_MAX) && (len == BLE_CCCD_VALUE_LEN)) {
+            p_attr->cccd[conn_handle] = uint16_decode(p_data);
+        } else if (len <= p_attr->max_len) {
+            memcpy(p_attr->p_value, p_data, len);
+            p_attr->len = len;
+        }
+        evt.evt.gatts_evt.params.write.uuid.uuid = p_attr->uuid;
+        evt.evt.gatts_evt.params.write.uuid.type = p_attr->uuid_type;
+    }
+
+    evt.header.evt_id                      = BLE_GATTS_EVT_WRITE;
+    evt.evt.gatts_evt.conn_handle          = conn_handle;
+    evt.evt.gatts_evt.params.write.handle  = handle;
+    evt.evt.gatts_evt.params.write.op      = BLE_GATTS_OP_WRITE_REQ;
+    evt.evt.gatts_evt.params.write.len     = len;
+    memcpy(evt.evt.gatts_evt.params.write.data, p_data, len);
+    fake_ble_evt_push(&evt);
+}
+
+/**
+    @brief Read of central, authorized attribute raises request, reply
+           is applied by sd_ble_gatts_rw_authorize_reply() before value is read
+*/
+void fake_ble_evt_read(uint16_t conn_handle, uint16_t handle, uint16_t offset) {
+
+    fake_attr_t * p_attr = attr_get(handle);
+    fake_link_t * p_link = link_get(conn_handle);
+
+    if ((p_attr == NULL) || (p_attr->rd_auth == 0) || (p_link == NULL))
+        return;
+
+    ble_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                                               = BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST;
+    evt.evt.gatts_evt.conn_handle                                   = conn_handle;
+    evt.evt.gatts_evt.params.authorize_request.type                 = BLE_GATTS_AUTHORIZE_TYPE_READ;
+    evt.evt.gatts_evt.params.authorize_request.request.read.handle  = handle;
+    evt.evt.gatts_evt.params.authorize_request.request.read.offset  = offset;
+    evt.evt.gatts_evt.params.authorize_request.request.read.uuid.uuid = p_attr->uuid;
+    evt.evt.gatts_evt.params.authorize_request.request.read.uuid.type = p_attr->uuid_type;
+    p_link->auth_handle = handle;
+    fake_ble_evt_push(&evt);
+}
+
+/**
+    @brief Packets are sent in connection event, buffers are free
+    @param[in] count - count of sent packets, 0 - all queued packets
+*/
+void fake_ble_evt_tx_complete(uint16_t conn_handle, uint8_t count) {
+
+    fake_link_t * p_link = link_get(conn_handle);
+
+    if ((p_link == NULL) || (p_link->tx_in_flight == 0))
+        return;
+
+    if ((count == 0) || (count > p_link->tx_in_flight))
+        count = p_link->tx_in_flight;
+
+    p_link->tx_in_flight -= count;
+    p_link->tx_free      += count;
+
+    ble_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                              = BLE_EVT_TX_COMPLETE;
+    evt.evt.common_evt.conn_handle                 = conn_handle;
+    evt.evt.common_evt.params.tx_complete.count    = count;
+    fake_ble_evt_push(&evt);
+}
+
+void fake_ble_evt_rssi(uint16_t conn_handle, int8_t rssi) {
+
+    fake_link_t * p_link = link_get(conn_handle);
+
+    if (p_link == NULL)
+        return;
+
+    p_link->rssi = rssi;
+    if (p_link->rssi_active == false)
+        return;
+
+    ble_evt_t evt;
+    memset(&evt, 0, sizeof(evt));
+    evt.header.evt_id                          = BLE_GAP_EVT_RSSI_CHANGED;
+    evt.evt.gap_evt.conn_handle                = conn_handle;
+    evt.evt.gap_evt.params.rssi_changed.rssi   = rssi;
+    fake_ble_evt_push(&evt);
+}
+
+void fake_sys_evt_push(uint32_t sys_evt) {
+    fake_evt_queue(sys_evt_dispatch, &sys_evt, sizeof(sys_evt));
+}
+
+/**
+    @brief Dispatch all queued events, events queued by handlers are dispatched too
+    @return count of dispatched events
+*/
+uint32_t fake_events_process(void) {
+
+    uint32_t count = 0;
+
+    while (m_evt_head != m_evt_tail) {
+        fake_evt_t evt = m_evt_queue[m_evt_tail % FAKE_EVT_QUEUE_SIZE];
+        m_evt_tail++;
+        evt.dispatch(evt.data);
+        count++;
+    }
+    return count;
+}
+
+/* ---------------------------- GATT database -------------------------- */
+
+uint16_t fake_gatts_value_handle_find(uint16_t uuid) {
+
+    for (uint16_t h = 1; h <= m_attr_count; h++) {
+        if ((m_attrs[h].kind == FAKE_ATTR_VALUE) && (m_attrs[h].uuid == uuid))
+            return h;
+    }
+    return BLE_GATT_HANDLE_INVALID;
+}
+
+uint16_t fake_gatts_cccd_handle_find(uint16_t uuid) {
+
+    uint16_t value_handle = fake_gatts_value_handle_find(uuid);
+
+    if ((value_handle != BLE_GATT_HANDLE_INVALID) && (value_handle < m_attr_count) &&
+        (m_attrs[value_handle + 1].kind == FAKE_ATTR_CCCD))
+        return value_handle + 1;
+    return BLE_GATT_HANDLE_INVALID;
+}
+
+uint16_t fake_gatts_value_read(uint16_t handle, uint8_t * p_buf, uint16_t max_len) {
+
+    fake_attr_t const * p_attr = attr_get(handle);
+
+    if (p_attr == NULL)
+        return 0;
+
+    uint16_t len = MIN(p_attr->len, max_len);
+    memcpy(p_buf, p_attr->p_value, len);
+    return len;
+}
+
+/**
+    @brief Central writes CCCD of characteristic with given 16-bit UUID
+*/
+void fake_gatts_notify_enable(uint16_t conn_handle, uint16_t uuid, bool enable) {
+
+    uint8_t  cccd[BLE_CCCD_VALUE_LEN];
+    uint16_t handle = fake_gatts_cccd_handle_find(uuid);
+
+    if (handle == BLE_GATT_HANDLE_INVALID) {
+        fprintf(stderr, "fake: characteristic 0x%04x has no CCCD\n", uuid);
+        abort();
+    }
+
+    uint16_encode(enable ? BLE_GATT_HVX_NOTIFICATION : 0, cccd);
+    fake_ble_evt_write(conn_handle, handle, cccd, sizeof(cccd));
+}
+
+/**
+    @brief Set count of TX buffers of every new link
+*/
+void fake_sd_tx_buffers_set(uint8_t count) {
+    m_tx_buffers = count;
+}
+
+void fake_sd_rssi_set(int8_t rssi) {
+    m_rssi_default = rssi;
+}
+
+/**
+    @brief ATT MTU of link after exchange, it limits length of notification
+*/
+void fake_sd_att_mtu_set(uint16_t conn_handle, uint16_t att_mtu) {
+
+    fake_link_t * p_link = link_get(conn_handle);
+    if (p_link != NULL)
+        p_link->att_mtu = MAX(att_mtu, GATT_MTU_SIZE_DEFAULT);
+}
+
+/**
+    @brief Hook is called for every notification accepted by stack, until its TX_COMPLETE
+           the notification occupies TX buffer
+*/
+void fake_hvx_hook_set(fake_hvx_hook_t hook) {
+    m_hvx_hook = hook;
+}
+
+/* ==================================================================== */
+/* ======================== softdevice_handler ======================== */
+/* ==================================================================== */
+
+uint32_t softdevice_enable_get_default_config(uint8_t central_links_count, uint8_t periph_links_count,
+                                              ble_enable_params_t * p_ble_enable_params) {
+
+    UNUSED_PARAMETER(central_links_count);
+    UNUSED_PARAMETER(periph_links_count);
+    memset(p_ble_enable_params, 0, sizeof(*p_ble_enable_params));
+    p_ble_enable_params->gatt_enable_params.att_mtu = GATT_MTU_SIZE_DEFAULT;
+    return NRF_SUCCESS;
+}
+
+uint32_t softdevice_enable(ble_enable_params_t * p_ble_enable_params) {
+
+    m_enabled = true;
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, &p_ble_enable_params->gatt_enable_params.att_mtu,
+                  sizeof(uint16_t), NRF_SUCCESS);
+}
+
+uint32_t softdevice_ble_evt_handler_set(ble_evt_handler_t ble_evt_handler) {
+
+    m_ble_evt_handler = ble_evt_handler;
+    return NRF_SUCCESS;
+}
+
+uint32_t softdevice_sys_evt_handler_set(sys_evt_handler_t sys_evt_handler) {
+
+    m_sys_evt_handler = sys_evt_handler;
+    return NRF_SUCCESS;
+}
+
+/* ==================================================================== */
+/* ============================ SVC calls ============================= */
+/* ==================================================================== */
+
+uint32_t sd_ble_uuid_vs_add(ble_uuid128_t const * p_vs_uuid, uint8_t * p_uuid_type) {
+
+    uint8_t i;
+
+    /// bytes 12 and 13 are replaced by 16-bit UUID
+    for (i = 0; i < m_uuid_vs_count; i++) {
+        if ((memcmp(m_uuid_vs[i].uuid128, p_vs_uuid->uuid128, 12) == 0) &&
+            (memcmp(&m_uuid_vs[i].uuid128[14], &p_vs_uuid->uuid128[14], 2) == 0))
+            break;
+    }
+
+    if (i == m_uuid_vs_count) {
+        if (m_uuid_vs_count == FAKE_UUID_VS_MAX)
+            return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_NO_MEM);
+        m_uuid_vs[m_uuid_vs_count++] = *p_vs_uuid;
+    }
+
+    *p_uuid_type = BLE_UUID_TYPE_VENDOR_BEGIN + i;
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, p_uuid_type, 1, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gatts_service_add(uint8_t type, ble_uuid_t const * p_uuid, uint16_t * p_handle) {
+
+    UNUSED_PARAMETER(type);
+
+    if (m_enabled == false)
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, BLE_ERROR_NOT_ENABLED);
+
+    *p_handle = attr_add(FAKE_ATTR_SERVICE, p_uuid->uuid, p_uuid->type);
+    if (*p_handle == BLE_GATT_HANDLE_INVALID)
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_NO_MEM);
+
+    return record(__func__, BLE_CONN_HANDLE_INVALID, *p_handle, &p_uuid->uuid, sizeof(uint16_t), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gatts_characteristic_add(uint16_t service_handle, ble_gatts_char_md_t const * p_char_md,
+                                         ble_gatts_attr_t const * p_attr_char_value,
+                                         ble_gatts_char_handles_t * p_handles) {
+
+    fake_attr_t const * p_service = attr_get(service_handle);
+
+    if ((p_service == NULL) || (p_service->kind != FAKE_ATTR_SERVICE))
+        return record(__func__, BLE_CONN_HANDLE_INVALID, service_handle, NULL, 0, NRF_ERROR_INVALID_PARAM);
+
+    if ((p_attr_char_value->max_len > FAKE_ATTR_VALUE_MAX) ||
+        (p_attr_char_value->init_len > p_attr_char_value->max_len))
+        return record(__func__, BLE_CONN_HANDLE_INVALID, service_handle, NULL, 0, NRF_ERROR_INVALID_PARAM);
+
+    bool     notify = p_char_md->char_props.notify || p_char_md->char_props.indicate;
+    uint16_t count  = notify ? 3 : 2;
+
+    if (m_attr_count + count > FAKE_ATTR_MAX)
+        return record(__func__, BLE_CONN_HANDLE_INVALID, service_handle, NULL, 0, NRF_ERROR_NO_MEM);
+
+    memset(p_handles, 0, sizeof(*p_handles));
+
+    attr_add(FAKE_ATTR_CHAR_DECL, p_attr_char_value->p_uuid->uuid, p_attr_char_value->p_uuid->type);
+
+    p_handles->value_handle = attr_add(FAKE_ATTR_VALUE, p_attr_char_value->p_uuid->uuid,
+                                       p_attr_char_value->p_uuid->type);
+    fake_attr_t * p_value = attr_get(p_handles->value_handle);
+    p_value->props_notify = notify;
+    p_value->max_len      = p_attr_char_value->max_len;
+    p_value->len          = p_attr_char_value->init_len;
+    if (p_attr_char_value->p_attr_md != NULL)
+        p_value->rd_auth  = p_attr_char_value->p_attr_md->rd_auth;
+    if ((p_attr_char_value->p_attr_md != NULL) && (p_attr_char_value->p_attr_md->vloc == BLE_GATTS_VLOC_USER))
+        p_value->p_value = p_attr_char_value->p_value;
+    else if (p_attr_char_value->p_value != NULL)
+        memcpy(p_value->value, p_attr_char_value->p_value, p_attr_char_value->init_len);
+
+    if (notify) {
+        p_handles->cccd_handle = attr_add(FAKE_ATTR_CCCD, 0x2902, BLE_UUID_TYPE_BLE);
+        attr_get(p_handles->cccd_handle)->max_len = BLE_CCCD_VALUE_LEN;
+    }
+
+    return record(__func__, BLE_CONN_HANDLE_INVALID, p_handles->value_handle,
+                  &p_attr_char_value->p_uuid->uuid, sizeof(uint16_t), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gatts_value_set(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value) {
+
+    fake_attr_t * p_attr = attr_get(handle);
+
+    if (p_attr == NULL)
+        return record(__func__, conn_handle, handle, NULL, 0, BLE_ERROR_INVALID_ATTR_HANDLE);
+
+    if (p_attr->kind == FAKE_ATTR_CCCD) {
+        if (link_get(conn_handle) == NULL)
+            return record(__func__, conn_handle, handle, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+        p_attr->cccd[conn_handle] = uint16_decode(p_value->p_value);
+        return record(__func__, conn_handle, handle, p_value->p_value, p_value->len, NRF_SUCCESS);
+    }
+
+    if ((uint32_t)p_value->offset + p_value->len > p_attr->max_len)
+        return record(__func__, conn_handle, handle, NULL, 0, NRF_ERROR_INVALID_PARAM);
+
+    memcpy(&p_attr->p_value[p_value->offset], p_value->p_value, p_value->len);
+    p_attr->len = p_value->offset + p_value->len;
+
+    return record(__func__, conn_handle, handle, p_value->p_value, p_value->len, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gatts_value_get(uint16_t conn_handle, uint16_t handle, ble_gatts_value_t * p_value) {
+
+    fake_attr_t const * p_attr = attr_get(handle);
+
+    if (p_attr == NULL)
+        return record(__func__, conn_handle, handle, NULL, 0, BLE_ERROR_INVALID_ATTR_HANDLE);
+
+    if (p_attr->kind == FAKE_ATTR_CCCD) {
+        if (link_get(conn_handle) == NULL)
+            return record(__func__, conn_handle, handle, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+        if (p_value->p_value != NULL)
+            uint16_encode(p_attr->cccd[conn_handle], p_value->p_value);
+        p_value->len = BLE_CCCD_VALUE_LEN;
+        return record(__func__, conn_handle, handle, NULL, 0, NRF_SUCCESS);
+    }
+
+    uint16_t available = (p_value->offset < p_attr->len) ? (p_attr->len - p_value->offset) : 0;
+    if (p_value->p_value != NULL) {
+        p_value->len = MIN(p_value->len, available);
+        memcpy(p_value->p_value, &p_attr->p_value[p_value->offset], p_value->len);
+    } else {
+        p_value->len = available;
+    }
+    return record(__func__, conn_handle, handle, NULL, 0, NRF_SUCCESS);
+}
+
+/**
+    @brief Notification or indication, value in database is updated too
+*/
+uint32_t sd_ble_gatts_hvx(uint16_t conn_handle, ble_gatts_hvx_params_t const * p_hvx_params) {
+
+    fake_link_t * p_link = link_get(conn_handle);
+    fake_attr_t * p_attr = attr_get(p_hvx_params->handle);
+    uint16_t      len    = (p_hvx_params->p_len != NULL) ? *p_hvx_params->p_len : 0;
+
+    if (p_link == NULL)
+        return record(__func__, conn_handle, p_hvx_params->handle, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+
+    if ((p_attr == NULL) || (p_attr->kind != FAKE_ATTR_VALUE))
+        return record(__func__, conn_handle, p_hvx_params->handle, NULL, 0, BLE_ERROR_INVALID_ATTR_HANDLE);
+
+    if ((p_attr->props_notify == false) || ((uint32_t)p_hvx_params->offset + len > p_attr->max_len))
+        return record(__func__, conn_handle, p_hvx_params->handle, NULL, 0, NRF_ERROR_INVALID_PARAM);
+
+    if (len > p_link->att_mtu - 3)
+        return record(__func__, conn_handle, p_hvx_params->handle, NULL, 0, NRF_ERROR_DATA_SIZE);
+
+    if (p_link->sys_attr_set == false)
+        return record(__func__, conn_handle, p_hvx_params->handle, NULL, 0, BLE_ERROR_GATTS_SYS_ATTR_MISSING);
+
+    uint16_t cccd = m_attrs[p_hvx_params->handle + 1].cccd[conn_handle];
+    if ((cccd & p_hvx_params->type) == 0)
+        return record(__func__, conn_handle, p_hvx_params->handle, NULL, 0, NRF_ERROR_INVALID_STATE);
+
+    if (p_link->tx_free == 0)
+        return record(__func__, conn_handle, p_hvx_params->handle, NULL, 0, BLE_ERROR_NO_TX_PACKETS);
+
+    p_link->tx_free--;
+    p_link->tx_in_flight++;
+
+    if (p_hvx_params->p_data != NULL) {
+        memcpy(&p_attr->p_value[p_hvx_params->offset], p_hvx_params->p_data, len);
+        p_attr->len = p_hvx_params->offset + len;
+    }
+
+    /// without data the current attribute value is sent
+    uint8_t const * p_sent = &p_attr->p_value[p_hvx_params->offset];
+
+    if (m_hvx_hook != NULL)
+        m_hvx_hook(conn_handle, p_hvx_params->handle, p_sent, len);
+
+    return record(__func__, conn_handle, p_hvx_params->handle, p_sent, len, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gatts_rw_authorize_reply(uint16_t conn_handle,
+                                         ble_gatts_rw_authorize_reply_params_t const * p_rw_authorize_reply_params) {
+
+    if (link_get(conn_handle) == NULL)
+        return record(__func__, conn_handle, 0, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+
+    fake_link_t *                        p_link   = link_get(conn_handle);
+    ble_gatts_authorize_params_t const * p_params = &p_rw_authorize_reply_params->params.read;
+    uint8_t data[3] = {p_rw_authorize_reply_params->type,
+                       (uint8_t)p_params->gatt_status, (uint8_t)(p_params->gatt_status >> 8)};
+
+    /// every request gets one reply, like in S132
+    if (p_link->auth_handle == BLE_GATT_HANDLE_INVALID)
+        return record(__func__, conn_handle, 0, data, sizeof(data), NRF_ERROR_INVALID_STATE);
+
+    uint16_t auth_handle = p_link->auth_handle;
+    p_link->auth_handle  = BLE_GATT_HANDLE_INVALID;
+
+    /// reply of read updates value of pending request
+    if ((p_rw_authorize_reply_params->type == BLE_GATTS_AUTHORIZE_TYPE_READ) && p_params->update) {
+        fake_attr_t * p_attr = attr_get(auth_handle);
+        if ((p_attr == NULL) || (p_params->offset + p_params->len > p_attr->max_len))
+            return record(__func__, conn_handle, 0, data, sizeof(data), NRF_ERROR_INVALID_PARAM);
+        memcpy(p_attr->p_value + p_params->offset, p_params->p_data, p_params->len);
+        p_attr->len = p_params->offset + p_params->len;
+    }
+
+    return record(__func__, conn_handle, 0, data, sizeof(data), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gatts_exchange_mtu_reply(uint16_t conn_handle, uint16_t server_rx_mtu) {
+
+    if (link_get(conn_handle) == NULL)
+        return record(__func__, conn_handle, 0, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+    return record(__func__, conn_handle, 0, &server_rx_mtu, sizeof(server_rx_mtu), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gatts_sys_attr_set(uint16_t conn_handle, uint8_t const * p_sys_attr_data, uint16_t len, uint32_t flags) {
+
+    UNUSED_PARAMETER(flags);
+
+    fake_link_t * p_link = link_get(conn_handle);
+    if (p_link == NULL)
+        return record(__func__, conn_handle, 0, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+
+    p_link->sys_attr_set = true;
+    return record(__func__, conn_handle, 0, p_sys_attr_data, len, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_user_mem_reply(uint16_t conn_handle, void const * p_block) {
+
+    UNUSED_PARAMETER(p_block);
+    return record(__func__, conn_handle, 0, NULL, 0,
+                  link_get(conn_handle) ? NRF_SUCCESS : BLE_ERROR_INVALID_CONN_HANDLE);
+}
+
+uint32_t sd_ble_tx_packet_count_get(uint16_t conn_handle, uint8_t * p_count) {
+
+    if (link_get(conn_handle) == NULL)
+        return record(__func__, conn_handle, 0, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+
+    *p_count = m_tx_buffers;
+    return record(__func__, conn_handle, 0, p_count, 1, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_device_name_set(ble_gap_conn_sec_mode_t const * p_write_perm, uint8_t const * p_dev_name, uint16_t len) {
+
+    UNUSED_PARAMETER(p_write_perm);
+
+    if (len > FAKE_DEVICE_NAME_MAX)
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_DATA_SIZE);
+
+    memcpy(m_device_name, p_dev_name, len);
+    m_device_name_len = len;
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, p_dev_name, len, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_appearance_set(uint16_t appearance) {
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, &appearance, sizeof(appearance), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_ppcp_set(ble_gap_conn_params_t const * p_conn_params) {
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, p_conn_params, sizeof(*p_conn_params), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_tx_power_set(int8_t tx_power) {
+
+    static const int8_t levels[] = {-40, -20, -16, -12, -8, -4, 0, 3, 4};
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(levels); i++) {
+        if (levels[i] == tx_power)
+            return record(__func__, BLE_CONN_HANDLE_INVALID, 0, &tx_power, 1, NRF_SUCCESS);
+    }
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, &tx_power, 1, NRF_ERROR_INVALID_PARAM);
+}
+
+/**
+    @brief Local disconnect, DISCONNECTED event is queued
+*/
+uint32_t sd_ble_gap_disconnect(uint16_t conn_handle, uint8_t hci_status_code) {
+
+    if (link_get(conn_handle) == NULL)
+        return record(__func__, conn_handle, 0, &hci_status_code, 1, BLE_ERROR_INVALID_CONN_HANDLE);
+
+    fake_ble_evt_disconnected(conn_handle, BLE_HCI_LOCAL_HOST_TERMINATED_CONNECTION);
+    return record(__func__, conn_handle, 0, &hci_status_code, 1, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_rssi_start(uint16_t conn_handle, uint8_t threshold_dbm, uint8_t skip_count) {
+
+    fake_link_t * p_link = link_get(conn_handle);
+    uint8_t       data[2] = {threshold_dbm, skip_count};
+
+    if (p_link == NULL)
+        return record(__func__, conn_handle, 0, data, sizeof(data), BLE_ERROR_INVALID_CONN_HANDLE);
+    if (p_link->rssi_active)
+        return record(__func__, conn_handle, 0, data, sizeof(data), NRF_ERROR_INVALID_STATE);
+
+    p_link->rssi_active = true;
+    return record(__func__, conn_handle, 0, data, sizeof(data), NRF_SUCCESS);
+}
+
+/**
+    @brief Measuring of RSSI is stopped with link, so after disconnect
+           S132 returns BLE_ERROR_INVALID_CONN_HANDLE
+*/
+uint32_t sd_ble_gap_rssi_stop(uint16_t conn_handle) {
+
+    fake_link_t * p_link = link_get(conn_handle);
+
+    if (p_link == NULL)
+        return record(__func__, conn_handle, 0, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+    if (p_link->rssi_active == false)
+        return record(__func__, conn_handle, 0, NULL, 0, NRF_ERROR_INVALID_STATE);
+
+    p_link->rssi_active = false;
+    return record(__func__, conn_handle, 0, NULL, 0, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_rssi_get(uint16_t conn_handle, int8_t * p_rssi) {
+
+    fake_link_t * p_link = link_get(conn_handle);
+
+    if (p_link == NULL)
+        return record(__func__, conn_handle, 0, NULL, 0, BLE_ERROR_INVALID_CONN_HANDLE);
+    if (p_link->rssi_active == false)
+        return record(__func__, conn_handle, 0, NULL, 0, NRF_ERROR_INVALID_STATE);
+
+    *p_rssi = p_link->rssi;
+    return record(__func__, conn_handle, 0, p_rssi, 1, NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_adv_data_set(uint8_t const * p_data, uint8_t dlen, uint8_t const * p_sr_data, uint8_t srdlen) {
+
+    uint8_t data[2 * BLE_GAP_ADV_MAX_SIZE];
+
+    if ((dlen > BLE_GAP_ADV_MAX_SIZE) || (srdlen > BLE_GAP_ADV_MAX_SIZE))
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_INVALID_LENGTH);
+
+    /// recorded data: advertising data, then scan response data
+    if (p_data != NULL)
+        memcpy(data, p_data, dlen);
+    if (p_sr_data != NULL)
+        memcpy(&data[dlen], p_sr_data, srdlen);
+
+    return record(__func__, BLE_CONN_HANDLE_INVALID, (uint16_t)(dlen << 8 | srdlen), data,
+                  (uint16_t)(dlen + srdlen), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_adv_start(ble_gap_adv_params_t const * p_adv_params) {
+
+    if (m_advertising)
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_INVALID_STATE);
+
+    if ((p_adv_params->interval < BLE_GAP_ADV_INTERVAL_MIN) || (p_adv_params->interval > BLE_GAP_ADV_INTERVAL_MAX))
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_INVALID_PARAM);
+
+    m_advertising  = true;
+    m_adv_deadline = 0;
+    if (p_adv_params->timeout != 0)
+        m_adv_deadline = fake_time_ticks() + (uint64_t)p_adv_params->timeout * APP_TIMER_CLOCK_FREQ;
+    /// high duty directed advertising lasts 1.28 s
+    if (p_adv_params->type == BLE_GAP_ADV_TYPE_ADV_DIRECT_IND)
+        m_adv_deadline = fake_time_ticks() + (1280ULL * APP_TIMER_CLOCK_FREQ) / 1000U;
+
+    /// recorded data: interval, timeout, filter policy
+    uint8_t data[5];
+    uint16_encode(p_adv_params->interval, &data[0]);
+    uint16_encode(p_adv_params->timeout, &data[2]);
+    data[4] = p_adv_params->fp;
+    return record(__func__, BLE_CONN_HANDLE_INVALID, p_adv_params->type, data, sizeof(data), NRF_SUCCESS);
+}
+
+uint32_t sd_ble_gap_adv_stop(void) {
+
+    if (m_advertising == false)
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_ERROR_INVALID_STATE);
+
+    m_advertising  = false;
+    m_adv_deadline = 0;
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_SUCCESS);
+}
+
+uint32_t sd_radio_notification_cfg_set(uint8_t type, uint8_t distance) {
+
+    if ((type > NRF_RADIO_NOTIFICATION_TYPE_INT_ON_BOTH) || (distance > NRF_RADIO_NOTIFICATION_DISTANCE_5500US))
+        return record(__func__, BLE_CONN_HANDLE_INVALID, 0, &distance, 1, NRF_ERROR_INVALID_PARAM);
+    m_radio_notification = type;
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, &distance, 1, NRF_SUCCESS);
+}
+
+/**
+    @brief System OFF doesn't return on target, here flag is set for harness
+*/
+uint32_t sd_power_system_off(void) {
+
+    m_system_off = true;
+    return record(__func__, BLE_CONN_HANDLE_INVALID, 0, NULL, 0, NRF_SUCCESS);
+}
+
+/**
+    @brief Sleep until event. Queued events are dispatched like interrupts,
+           without events idle hook of harness is called, it pushes new
+           events or advances time. Without hook time goes to next timer.
+*/
+uint32_t sd_app_evt_wait(void) {
+
+    if (fake_events_process() != 0)
+        return NRF_SUCCESS;
+
+    if (m_idle_hook != NULL) {
+        m_idle_hook();
+    } else {
+        uint64_t next;
+        if (fake_time_next_expiry(&next) == false) {
+            fprintf(stderr, "fake: sd_app_evt_wait() without events and timers\n");
+            abort();
+        }
+        fake_time_advance((uint32_t)(next - fake_time_ticks()));
+    }
+    fake_events_process();
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_nvic_critical_region_enter(uint8_t * p_is_nested_critical_region) {
+
+    *p_is_nested_critical_region = 0;
+    return NRF_SUCCESS;
+}
+
+uint32_t sd_nvic_critical_region_exit(uint8_t is_nested_critical_region) {
+
+    UNUSED_PARAMETER(is_nested_critical_region);
+    return NRF_SUCCESS;
+}
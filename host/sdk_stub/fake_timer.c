@@ -0,0 +1,215 @@
+/**
+    @brief Host stand-in for app_timer of nRF5 SDK 12 on virtual RTC1 time.
+
+    Time goes only by fake_time_advance(), expired timers are called in order
+    of expiry, events queued by timeout handlers are dispatched at the same
+    virtual time, like interrupts of higher priority on target.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include "fake_internal.h"
+#include "app_timer.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define FAKE_TIMER_MAX      32U     /**< Count of created timers */
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+static app_timer_t * m_timers[FAKE_TIMER_MAX];
+static uint32_t      m_timer_count = 0;
+static bool          m_initialized = false;
+static uint64_t      m_now = 0;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static app_timer_t * timer_next(void);
+
+/** @brief Active timer with the earliest expiry, the first created if several
+*/
+static app_timer_t * timer_next(void) {
+
+    app_timer_t * p_next = NULL;
+
+    for (uint32_t i = 0; i < m_timer_count; i++) {
+        if (m_timers[i]->active && ((p_next == NULL) || (m_timers[i]->expiry < p_next->expiry)))
+            p_next = m_timers[i];
+    }
+    return p_next;
+}
+
+void fake_timer_reset(void) {
+
+    for (uint32_t i = 0; i < m_timer_count; i++)
+        memset(m_timers[i], 0, sizeof(app_timer_t));
+
+    m_timer_count = 0;
+    m_initialized = false;
+    m_now         = 0;
+}
+
+/* ==================================================================== */
+/* ========================== harness control ========================= */
+/* ==================================================================== */
+
+uint64_t fake_time_ticks(void) {
+    return m_now;
+}
+
+/**
+    @brief Time of the next expiry of timer or deadline of SoftDevice
+*/
+bool fake_time_next_expiry(uint64_t * p_ticks) {
+
+    app_timer_t const * p_next = timer_next();
+    uint64_t            deadline;
+    bool                found = false;
+
+    if (p_next != NULL) {
+        *p_ticks = p_next->expiry;
+        found    = true;
+    }
+    if (fake_sd_deadline_get(&deadline) && ((found == false) || (deadline < *p_ticks))) {
+        *p_ticks = deadline;
+        found    = true;
+    }
+    return found;
+}
+
+/**
+    @brief Advance virtual time, all expired timers are called
+*/
+void fake_time_advance(uint32_t ticks) {
+
+    uint64_t target = m_now + ticks;
+    uint64_t next;
+
+    fake_events_process();
+
+    while (fake_time_next_expiry(&next) && (next <= target)) {
+
+        fake_dwt_advance((uint32_t)(next - m_now));
+        m_now = next;
+
+        fake_sd_deadline_expired(m_now);
+
+        app_timer_t * p_timer = timer_next();
+        if ((p_timer != NULL) && (p_timer->expiry <= m_now)) {
+            if (p_timer->mode == APP_TIMER_MODE_REPEATED) {
+                p_timer->expiry += p_timer->period;
+            } else {
+                p_timer->active = false;
+            }
+            p_timer->handler(p_timer->p_context);
+        }
+
+        fake_events_process();
+    }
+
+    fake_dwt_advance((uint32_t)(target - m_now));
+    m_now = target;
+}
+
+/* ==================================================================== */
+/* ============================ app_timer ============================= */
+/* ==================================================================== */
+
+uint32_t app_timer_init(uint32_t prescaler, uint8_t op_queue_size, void * p_op_queues_buf, void * evt_schedule_func) {
+
+    UNUSED_PARAMETER(op_queue_size);
+    UNUSED_PARAMETER(p_op_queues_buf);
+    UNUSED_PARAMETER(evt_schedule_func);
+
+    /// virtual time is counted in ticks of RTC1 without prescaler
+    if (prescaler != 0)
+        return NRF_ERROR_INVALID_PARAM;
+
+    m_initialized = true;
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_create(app_timer_id_t const * p_timer_id, app_timer_mode_t mode,
+                          app_timer_timeout_handler_t timeout_handler) {
+
+    if (m_initialized == false)
+        return NRF_ERROR_INVALID_STATE;
+
+    if ((p_timer_id == NULL) || (*p_timer_id == NULL) || (timeout_handler == NULL))
+        return NRF_ERROR_INVALID_PARAM;
+
+    app_timer_t * p_timer = *p_timer_id;
+
+    if (p_timer->active)
+        return NRF_ERROR_INVALID_STATE;
+
+    if (p_timer->created == false) {
+        if (m_timer_count == FAKE_TIMER_MAX)
+            return NRF_ERROR_NO_MEM;
+        m_timers[m_timer_count++] = p_timer;
+    }
+
+    p_timer->handler = timeout_handler;
+    p_timer->mode    = mode;
+    p_timer->created = true;
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Start timer. Like in SDK 12, start of running timer is ignored.
+*/
+uint32_t app_timer_start(app_timer_id_t timer_id, uint32_t timeout_ticks, void * p_context) {
+
+    if (m_initialized == false)
+        return NRF_ERROR_INVALID_STATE;
+
+    if ((timer_id == NULL) || (timer_id->created == false))
+        return NRF_ERROR_INVALID_STATE;
+
+    if ((timeout_ticks < APP_TIMER_MIN_TIMEOUT_TICKS) || (timeout_ticks > APP_TIMER_MAX_CNT_VAL))
+        return NRF_ERROR_INVALID_PARAM;
+
+    if (timer_id->active)
+        return NRF_SUCCESS;
+
+    timer_id->active    = true;
+    timer_id->expiry    = m_now + timeout_ticks;
+    timer_id->period    = (timer_id->mode == APP_TIMER_MODE_REPEATED) ? timeout_ticks : 0;
+    timer_id->p_context = p_context;
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_stop(app_timer_id_t timer_id) {
+
+    if (timer_id == NULL)
+        return NRF_ERROR_INVALID_PARAM;
+
+    timer_id->active = false;
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_stop_all(void) {
+
+    for (uint32_t i = 0; i < m_timer_count; i++)
+        m_timers[i]->active = false;
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_cnt_get(uint32_t * p_ticks) {
+
+    *p_ticks = (uint32_t)(m_now & APP_TIMER_MAX_CNT_VAL);
+    return NRF_SUCCESS;
+}
+
+uint32_t app_timer_cnt_diff_compute(uint32_t ticks_to, uint32_t ticks_from, uint32_t * p_ticks_diff) {
+
+    *p_ticks_diff = (ticks_to - ticks_from) & APP_TIMER_MAX_CNT_VAL;
+    return NRF_SUCCESS;
+}
@@ -0,0 +1,6 @@
+/* Host stand-in for fstorage.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef FSTORAGE_H__
+#define FSTORAGE_H__
+#include "nrf_sdk_fake.h"
+void fs_sys_event_handler(uint32_t sys_evt);
+#endif
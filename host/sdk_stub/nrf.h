@@ -0,0 +1,33 @@
+/* Host stand-in for nrf.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef NRF_H__
+#define NRF_H__
+#include "nrf_sdk_fake.h"
+typedef struct { volatile uint32_t RESETREAS; volatile uint32_t GPREGRET; } NRF_POWER_Type;
+typedef struct { volatile uint32_t DEMCR; } CoreDebug_Type;
+typedef struct { volatile uint32_t CTRL; volatile uint32_t CYCCNT; } DWT_Type;
+typedef struct { volatile uint32_t CFSR; volatile uint32_t HFSR; volatile uint32_t MMFAR; volatile uint32_t BFAR; } SCB_Type;
+extern NRF_POWER_Type fake_power; extern CoreDebug_Type fake_coredebug; extern DWT_Type fake_dwt;
+extern SCB_Type fake_scb;
+#define NRF_POWER (&fake_power)
+#define CoreDebug (&fake_coredebug)
+/* DWT counts RTC1 time, harness can add host time of code (fake_dwt_host_clock_set) */
+extern bool fake_dwt_host_clock;
+void fake_dwt_host_update(void);
+static inline DWT_Type * fake_dwt_get(void) { if (fake_dwt_host_clock) fake_dwt_host_update(); return &fake_dwt; }
+#define DWT       (fake_dwt_get())
+#define SCB       (&fake_scb)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL)
+#define POWER_RESETREAS_RESETPIN_Msk (1UL << 0)
+#define POWER_RESETREAS_DOG_Msk      (1UL << 1)
+#define POWER_RESETREAS_SREQ_Msk     (1UL << 2)
+#define POWER_RESETREAS_LOCKUP_Msk   (1UL << 3)
+#define POWER_RESETREAS_OFF_Msk      (1UL << 16)
+#define __NOP() do { } while (0)
+/* Host run is single-threaded, exclusive store always succeeds */
+static inline uint32_t __LDREXW(volatile uint32_t * p_addr) { return *p_addr; }
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t * p_addr) { *p_addr = value; return 0; }
+static inline uint32_t __CLZ(uint32_t value) { return (value != 0) ? (uint32_t)__builtin_clz(value) : 32U; }
+/* Stops host run like reset stops target */
+void NVIC_SystemReset(void);
+#endif
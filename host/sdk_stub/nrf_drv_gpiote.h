@@ -0,0 +1,22 @@
+/* Host stand-in for nrf_drv_gpiote.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef NRF_DRV_GPIOTE__
+#define NRF_DRV_GPIOTE__
+#include "nrf_gpio.h"
+#include "sdk_config.h"
+typedef enum { NRF_GPIOTE_POLARITY_LOTOHI = 1, NRF_GPIOTE_POLARITY_HITOLO = 2, NRF_GPIOTE_POLARITY_TOGGLE = 3 } nrf_gpiote_polarity_t;
+typedef uint32_t nrf_drv_gpiote_pin_t;
+typedef struct {
+    nrf_gpiote_polarity_t sense;
+    nrf_gpio_pin_pull_t   pull;
+    bool is_watcher;
+    bool hi_accuracy;
+} nrf_drv_gpiote_in_config_t;
+#define GPIOTE_CONFIG_IN_SENSE_TOGGLE(hi_accu) { .is_watcher = false, .hi_accuracy = hi_accu, .pull = NRF_GPIO_PIN_NOPULL, .sense = NRF_GPIOTE_POLARITY_TOGGLE }
+#define GPIOTE_CONFIG_IN_SENSE_HITOLO(hi_accu) { .is_watcher = false, .hi_accuracy = hi_accu, .pull = NRF_GPIO_PIN_NOPULL, .sense = NRF_GPIOTE_POLARITY_HITOLO }
+typedef void (*nrf_drv_gpiote_evt_handler_t)(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
+ret_code_t nrf_drv_gpiote_init(void);
+bool nrf_drv_gpiote_is_init(void);
+ret_code_t nrf_drv_gpiote_in_init(nrf_drv_gpiote_pin_t pin, nrf_drv_gpiote_in_config_t const * p_config, nrf_drv_gpiote_evt_handler_t evt_handler);
+void nrf_drv_gpiote_in_event_enable(nrf_drv_gpiote_pin_t pin, bool int_enable);
+void nrf_drv_gpiote_in_event_disable(nrf_drv_gpiote_pin_t pin);
+#endif
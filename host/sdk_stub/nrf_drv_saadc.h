@@ -0,0 +1,24 @@
+/* Host stand-in for nrf_drv_saadc.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef NRF_DRV_SAADC_H__
+#define NRF_DRV_SAADC_H__
+#include "nrf_sdk_fake.h"
+typedef int16_t nrf_saadc_value_t;
+typedef enum { NRF_SAADC_INPUT_DISABLED = 0, NRF_SAADC_INPUT_AIN0, NRF_SAADC_INPUT_AIN1, NRF_SAADC_INPUT_AIN2, NRF_SAADC_INPUT_AIN3, NRF_SAADC_INPUT_VDD = 9 } nrf_saadc_input_t;
+typedef struct { nrf_saadc_input_t pin_p; uint32_t gain; } nrf_saadc_channel_config_t;
+#define NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(PIN_P) { .pin_p = (PIN_P), .gain = 0 }
+typedef enum { NRF_DRV_SAADC_EVT_DONE, NRF_DRV_SAADC_EVT_LIMIT, NRF_DRV_SAADC_EVT_CALIBRATEDONE } nrf_drv_saadc_evt_type_t;
+typedef struct { nrf_saadc_value_t * p_buffer; uint16_t size; } nrf_drv_saadc_done_evt_t;
+typedef struct {
+    nrf_drv_saadc_evt_type_t type;
+    union { nrf_drv_saadc_done_evt_t done; } data;
+} nrf_drv_saadc_evt_t;
+typedef void (*nrf_drv_saadc_event_handler_t)(nrf_drv_saadc_evt_t const * p_event);
+typedef struct { uint8_t resolution; } nrf_drv_saadc_config_t;
+ret_code_t nrf_drv_saadc_init(nrf_drv_saadc_config_t const * p_config, nrf_drv_saadc_event_handler_t event_handler);
+void nrf_drv_saadc_uninit(void);
+ret_code_t nrf_drv_saadc_channel_init(uint8_t channel, nrf_saadc_channel_config_t const * const p_config);
+ret_code_t nrf_drv_saadc_buffer_convert(nrf_saadc_value_t * buffer, uint16_t size);
+ret_code_t nrf_drv_saadc_sample(void);
+ret_code_t nrf_drv_saadc_calibrate_offset(void);
+bool nrf_drv_saadc_is_busy(void);
+#endif
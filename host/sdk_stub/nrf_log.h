@@ -0,0 +1,14 @@
+/* Host stand-in for nrf_log.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef NRF_LOG_H_
+#define NRF_LOG_H_
+#include "nrf_sdk_fake.h"
+/* Host build: log calls are compiled out like with NRF_LOG_ENABLED 0,
+   arguments are still type-checked. */
+static inline void nrf_log_fake(const char * fmt, ...) { (void)fmt; }
+#define NRF_LOG_INFO(...)    nrf_log_fake(__VA_ARGS__);
+#define NRF_LOG_DEBUG(...)   nrf_log_fake(__VA_ARGS__);
+#define NRF_LOG_WARNING(...) nrf_log_fake(__VA_ARGS__);
+#define NRF_LOG_ERROR(...)   nrf_log_fake(__VA_ARGS__);
+#define NRF_LOG_RAW_INFO(...) nrf_log_fake(__VA_ARGS__);
+#define NRF_LOG_HEXDUMP_INFO(p, len) ((void)(p), (void)(len))
+#endif
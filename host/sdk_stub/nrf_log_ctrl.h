@@ -0,0 +1,8 @@
+/* Host stand-in for nrf_log_ctrl.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef NRF_LOG_CTRL_H
+#define NRF_LOG_CTRL_H
+#include "nrf_sdk_fake.h"
+#define NRF_LOG_INIT(timestamp_func) NRF_SUCCESS
+#define NRF_LOG_PROCESS() false
+#define NRF_LOG_FLUSH() ((void)0)
+#endif
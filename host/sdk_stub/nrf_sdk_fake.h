@@ -0,0 +1,73 @@
+/* Host stand-in for common types and macros of nRF5 SDK 12 and S132 v3, see sdk_stub.h */
+#ifndef NRF_SDK_FAKE_H__
+#define NRF_SDK_FAKE_H__
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#define NRF_SUCCESS                 0
+#define NRF_ERROR_BASE_NUM          0x0
+#define NRF_ERROR_INTERNAL          3
+#define NRF_ERROR_NO_MEM            4
+#define NRF_ERROR_NOT_FOUND         5
+#define NRF_ERROR_NOT_SUPPORTED     6
+#define NRF_ERROR_INVALID_PARAM     7
+#define NRF_ERROR_INVALID_STATE     8
+#define NRF_ERROR_INVALID_LENGTH    9
+#define NRF_ERROR_INVALID_FLAGS     10
+#define NRF_ERROR_INVALID_DATA      11
+#define NRF_ERROR_DATA_SIZE         12
+#define NRF_ERROR_TIMEOUT           13
+#define NRF_ERROR_NULL              14
+#define NRF_ERROR_FORBIDDEN         15
+#define NRF_ERROR_INVALID_ADDR      16
+#define NRF_ERROR_BUSY              17
+#define NRF_ERROR_CONN_COUNT        18
+#define NRF_ERROR_RESOURCES         19
+#define BLE_ERROR_NOT_ENABLED       0x3001
+#define BLE_ERROR_INVALID_CONN_HANDLE 0x3002
+#define BLE_ERROR_INVALID_ATTR_HANDLE 0x3003
+#define BLE_ERROR_NO_TX_PACKETS     0x3004
+#define BLE_ERROR_GATTS_SYS_ATTR_MISSING 0x3401
+typedef uint32_t ret_code_t;
+
+#define UNUSED_PARAMETER(X) ((void)(X))
+#define UNUSED_VARIABLE(X)  ((void)(X))
+#define STATIC_ASSERT(EXPR) _Static_assert((EXPR), #EXPR)
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) < (b) ? (b) : (a))
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+#define ROUNDED_DIV(A, B) (((A) + ((B) / 2)) / (B))
+#define CEIL_DIV(A, B) (((A) + (B) - 1) / (B))
+#define UNIT_0_625_MS 625
+#define UNIT_1_25_MS  1250
+#define UNIT_10_MS    10000
+#define MSEC_TO_UNITS(TIME, RESOLUTION) (((TIME) * 1000) / (RESOLUTION))
+#define __WEAK __attribute__((weak))
+#define __ALIGN(n) __attribute__((aligned(n)))
+#define __STATIC_INLINE static inline
+/* Host run is single-threaded, DMB orders only compiler accesses as on single core M4 */
+#define __DMB() __asm__ volatile ("" ::: "memory")
+#define __DSB() __sync_synchronize()
+#define __ISB() __sync_synchronize()
+static inline uint8_t battery_level_in_percent(const uint16_t mvolts)
+{
+    uint8_t battery_level;
+    if (mvolts >= 3000) battery_level = 100;
+    else if (mvolts > 2900) battery_level = 100 - ((3000 - mvolts) * 58) / 100;
+    else if (mvolts > 2740) battery_level = 42 - ((2900 - mvolts) * 24) / 160;
+    else if (mvolts > 2440) battery_level = 18 - ((2740 - mvolts) * 12) / 300;
+    else if (mvolts > 2100) battery_level = 6 - ((2440 - mvolts) * 6) / 340;
+    else battery_level = 0;
+    return battery_level;
+}
+typedef struct { uint16_t size; uint8_t * p_data; } uint8_array_t;
+static inline uint8_t uint16_encode(uint16_t value, uint8_t * p_encoded_data)
+{ p_encoded_data[0] = (uint8_t)value; p_encoded_data[1] = (uint8_t)(value >> 8); return 2; }
+static inline uint8_t uint32_encode(uint32_t value, uint8_t * p_encoded_data)
+{ p_encoded_data[0] = (uint8_t)value; p_encoded_data[1] = (uint8_t)(value >> 8);
+  p_encoded_data[2] = (uint8_t)(value >> 16); p_encoded_data[3] = (uint8_t)(value >> 24); return 4; }
+static inline uint16_t uint16_decode(const uint8_t * p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t uint32_decode(const uint8_t * p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+#endif
@@ -0,0 +1,15 @@
+/* Host stand-in for nrf_soc.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef NRF_SOC_H__
+#define NRF_SOC_H__
+#include "ble.h"
+enum NRF_RADIO_NOTIFICATION_DISTANCES {
+    NRF_RADIO_NOTIFICATION_DISTANCE_NONE = 0, NRF_RADIO_NOTIFICATION_DISTANCE_800US, NRF_RADIO_NOTIFICATION_DISTANCE_1740US,
+    NRF_RADIO_NOTIFICATION_DISTANCE_2680US, NRF_RADIO_NOTIFICATION_DISTANCE_3620US, NRF_RADIO_NOTIFICATION_DISTANCE_4560US,
+    NRF_RADIO_NOTIFICATION_DISTANCE_5500US
+};
+enum NRF_RADIO_NOTIFICATION_TYPES {
+    NRF_RADIO_NOTIFICATION_TYPE_NONE = 0, NRF_RADIO_NOTIFICATION_TYPE_INT_ON_ACTIVE, NRF_RADIO_NOTIFICATION_TYPE_INT_ON_INACTIVE,
+    NRF_RADIO_NOTIFICATION_TYPE_INT_ON_BOTH
+};
+uint32_t sd_radio_notification_cfg_set(uint8_t type, uint8_t distance);
+#endif
@@ -0,0 +1,45 @@
+/* Host stand-in for peer_manager.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef PEER_MANAGER_H__
+#define PEER_MANAGER_H__
+#include "ble.h"
+#include "fds.h"
+typedef uint16_t pm_peer_id_t;
+#define PM_PEER_ID_INVALID 0xFFFF
+typedef enum {
+    PM_EVT_BONDED_PEER_CONNECTED, PM_EVT_CONN_SEC_START, PM_EVT_CONN_SEC_SUCCEEDED, PM_EVT_CONN_SEC_FAILED,
+    PM_EVT_CONN_SEC_CONFIG_REQ, PM_EVT_STORAGE_FULL, PM_EVT_ERROR_UNEXPECTED, PM_EVT_PEER_DATA_UPDATE_SUCCEEDED,
+    PM_EVT_PEER_DATA_UPDATE_FAILED, PM_EVT_PEER_DELETE_SUCCEEDED, PM_EVT_PEER_DELETE_FAILED, PM_EVT_PEERS_DELETE_SUCCEEDED,
+    PM_EVT_PEERS_DELETE_FAILED, PM_EVT_LOCAL_DB_CACHE_APPLIED, PM_EVT_LOCAL_DB_CACHE_APPLY_FAILED,
+    PM_EVT_SERVICE_CHANGED_IND_SENT, PM_EVT_SERVICE_CHANGED_IND_CONFIRMED
+} pm_evt_id_t;
+typedef struct { uint8_t procedure; } pm_conn_sec_succeeded_evt_t;
+typedef struct { uint8_t procedure; uint16_t error; uint8_t error_src; } pm_conn_sec_failed_evt_t;
+typedef struct { ret_code_t error; } pm_failure_evt_t;
+typedef struct {
+    pm_evt_id_t evt_id; uint16_t conn_handle; pm_peer_id_t peer_id;
+    union {
+        pm_conn_sec_succeeded_evt_t conn_sec_succeeded; pm_conn_sec_failed_evt_t conn_sec_failed;
+        pm_failure_evt_t peer_data_update_failed; pm_failure_evt_t peer_delete_failed;
+        pm_failure_evt_t peers_delete_failed_evt; pm_failure_evt_t error_unexpected;
+    } params;
+} pm_evt_t;
+typedef struct { bool allow_repairing; } pm_conn_sec_config_t;
+typedef struct { ble_gap_irk_t id_info; ble_gap_addr_t id_addr_info; } ble_gap_id_key_t;
+typedef struct { uint8_t own_role; ble_gap_id_key_t peer_ble_id; } pm_peer_data_bonding_t;
+typedef void (*pm_evt_handler_t)(pm_evt_t const * p_event);
+ret_code_t pm_init(void);
+ret_code_t pm_register(pm_evt_handler_t event_handler);
+void pm_on_ble_evt(ble_evt_t * p_ble_evt);
+ret_code_t pm_sec_params_set(ble_gap_sec_params_t * p_sec_params);
+ret_code_t pm_peers_delete(void);
+ret_code_t pm_peer_delete(pm_peer_id_t peer_id);
+void pm_conn_sec_config_reply(uint16_t conn_handle, pm_conn_sec_config_t * p_conn_sec_config);
+void pm_local_database_has_changed(void);
+ret_code_t pm_peer_id_get(uint16_t conn_handle, pm_peer_id_t * p_peer_id);
+pm_peer_id_t pm_next_peer_id_get(pm_peer_id_t prev_peer_id);
+uint32_t pm_peer_count(void);
+ret_code_t pm_peer_data_bonding_load(pm_peer_id_t peer_id, pm_peer_data_bonding_t * p_data);
+ret_code_t pm_whitelist_set(pm_peer_id_t const * p_peers, uint32_t peer_cnt);
+ret_code_t pm_whitelist_get(ble_gap_addr_t * p_addrs, uint32_t * p_addr_cnt, ble_gap_irk_t * p_irks, uint32_t * p_irk_cnt);
+ret_code_t pm_device_identities_list_set(pm_peer_id_t const * p_peers, uint32_t peer_cnt);
+#endif
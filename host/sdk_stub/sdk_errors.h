@@ -0,0 +1,2 @@
+/* Host stand-in for sdk_errors.h of nRF5 SDK 12, see sdk_stub.h */
+#include "nrf_sdk_fake.h"
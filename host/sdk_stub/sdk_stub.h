@@ -0,0 +1,115 @@
+/*!
+    @brief Control interface of host stand-in for nRF5 SDK 12 and S132 v3.
+
+    Application modules are compiled for host without changes, SDK headers
+    are replaced by headers of this directory. Fake layer:
+        - records every sd_* call (name, connection, handle, data);
+        - keeps GATT database, values of attributes and CCCDs;
+        - keeps bonds of peer manager and its whitelist;
+        - queues BLE events, SAADC and FDS events and replays them to
+          registered handlers from fake_events_process() or sd_app_evt_wait();
+        - runs app_timer on virtual RTC1 time;
+        - keeps levels of pins, FDS records in RAM "flash";
+        - keeps data written to RTT channels.
+*/
+
+#ifndef SDK_STUB_H__
+#define SDK_STUB_H__
+
+#include <stdio.h>
+#include "ble.h"
+#include "softdevice_handler.h"
+#include "peer_manager.h"
+
+#define FAKE_CALL_DATA_MAX      64U     /**< Bytes of data stored for every recorded call, advertising and scan response data fit */
+#define FAKE_CALL_LOG_SIZE      4096U   /**< Count of recorded calls, older are overwritten */
+
+/**
+    @brief One recorded call of SoftDevice or SDK
+*/
+typedef struct {
+    const char * name;                      /**< name of function */
+    uint64_t     ticks;                     /**< virtual time of call */
+    uint16_t     conn_handle;
+    uint16_t     handle;
+    uint32_t     result;                    /**< returned error code */
+    uint16_t     len;                       /**< length of data, can be more than stored */
+    uint8_t      data[FAKE_CALL_DATA_MAX];
+} fake_call_t;
+
+/**@brief Hook called from sd_app_evt_wait() when there are no pending events. */
+typedef void (*fake_idle_hook_t)(void);
+
+/**@brief Hook called for every notification accepted by sd_ble_gatts_hvx(). */
+typedef void (*fake_hvx_hook_t)(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len);
+
+/* ------------------------------ control ------------------------------ */
+
+void fake_reset(void);
+void fake_idle_hook_set(fake_idle_hook_t hook);
+ble_evt_handler_t fake_ble_evt_handler_get(void);
+bool fake_system_is_off(void);
+
+/* --------------------------- recorded calls -------------------------- */
+
+uint32_t fake_calls_total(void);
+uint32_t fake_call_count(const char * name);
+fake_call_t const * fake_call_last(const char * name);
+void fake_calls_clear(void);
+void fake_calls_summary(FILE * p_file);
+
+void fake_call_record(const char * name, uint16_t conn_handle, uint16_t handle,
+                      uint8_t const * p_data, uint16_t len, uint32_t result);
+
+/* ------------------------------- events ------------------------------ */
+
+void fake_ble_evt_push(ble_evt_t const * p_evt);
+void fake_ble_evt_connected(uint16_t conn_handle);
+void fake_ble_evt_disconnected(uint16_t conn_handle, uint8_t reason);
+void fake_ble_evt_write(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len);
+void fake_ble_evt_read(uint16_t conn_handle, uint16_t handle, uint16_t offset);
+void fake_ble_evt_tx_complete(uint16_t conn_handle, uint8_t count);
+void fake_ble_evt_rssi(uint16_t conn_handle, int8_t rssi);
+void fake_sys_evt_push(uint32_t sys_evt);
+
+uint32_t fake_events_process(void);
+
+/* ---------------------------- GATT database -------------------------- */
+
+uint16_t fake_gatts_value_handle_find(uint16_t uuid);
+uint16_t fake_gatts_cccd_handle_find(uint16_t uuid);
+uint16_t fake_gatts_value_read(uint16_t handle, uint8_t * p_buf, uint16_t max_len);
+void fake_gatts_notify_enable(uint16_t conn_handle, uint16_t uuid, bool enable);
+
+void fake_sd_tx_buffers_set(uint8_t count);
+void fake_sd_rssi_set(int8_t rssi);
+void fake_sd_att_mtu_set(uint16_t conn_handle, uint16_t att_mtu);
+void fake_hvx_hook_set(fake_hvx_hook_t hook);
+
+/* -------------------------------- time ------------------------------- */
+
+uint64_t fake_time_ticks(void);
+void fake_time_advance(uint32_t ticks);
+bool fake_time_next_expiry(uint64_t * p_ticks);
+
+/* ---------------------------- peer manager --------------------------- */
+
+pm_peer_id_t fake_pm_bond(uint16_t conn_handle);
+
+/* ----------------------------- peripherals --------------------------- */
+
+void fake_gpio_input_set(uint32_t pin, uint32_t level);
+uint32_t fake_gpio_output_get(uint32_t pin);
+
+void fake_saadc_values_set(int16_t const * p_values, uint8_t count);
+void fake_dwt_host_clock_set(double cycles_per_ns);
+
+void fake_fds_erase(void);
+
+uint32_t fake_rtt_data_get(uint8_t channel, uint8_t const ** pp_data);
+
+/* -------------------------------- errors ----------------------------- */
+
+uint32_t fake_app_error_count(void);
+
+#endif
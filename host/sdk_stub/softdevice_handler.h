@@ -0,0 +1,16 @@
+/* Host stand-in for softdevice_handler.h of nRF5 SDK 12, see sdk_stub.h */
+#ifndef SOFTDEVICE_HANDLER_H__
+#define SOFTDEVICE_HANDLER_H__
+#include "ble.h"
+typedef struct { uint8_t source; uint8_t rc_ctiv; uint8_t rc_temp_ctiv; uint8_t xtal_accuracy; } nrf_clock_lf_cfg_t;
+#define NRF_CLOCK_LF_SRC_XTAL 1
+#define NRF_CLOCK_LF_XTAL_ACCURACY_20_PPM 7
+typedef void (*ble_evt_handler_t)(ble_evt_t * p_ble_evt);
+typedef void (*sys_evt_handler_t)(uint32_t evt_id);
+#define SOFTDEVICE_HANDLER_INIT(CLOCK_SOURCE, EVT_HANDLER) do { (void)(CLOCK_SOURCE); } while (0)
+#define CHECK_RAM_START_ADDR(C, P) do { } while (0)
+uint32_t softdevice_enable_get_default_config(uint8_t central_links_count, uint8_t periph_links_count, ble_enable_params_t * p_ble_enable_params);
+uint32_t softdevice_enable(ble_enable_params_t * p_ble_enable_params);
+uint32_t softdevice_ble_evt_handler_set(ble_evt_handler_t ble_evt_handler);
+uint32_t softdevice_sys_evt_handler_set(sys_evt_handler_t sys_evt_handler);
+#endif
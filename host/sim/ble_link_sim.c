@@ -0,0 +1,347 @@
+/**
+    @brief Discrete-event model of BLE link, see ble_link_sim.h
+
+    Time of model is kept in microseconds, time of fake layer (RTC1 ticks)
+    follows it, so timers of application expire between connection events
+    like on target.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <string.h>
+#include "ble_link_sim.h"
+#include "sdk_stub.h"
+#include "sq_service.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define RTC_HZ                  32768U
+#define RTC_MASK                0x00FFFFFFU     /**< RTC1 counter is 24 bits */
+
+#define LL_T_IFS_US             150U            /**< inter frame space */
+#define LL_EMPTY_PDU_US         80U             /**< empty packet of central at 1 Mbps */
+#define LL_OVERHEAD_BYTES       10U             /**< preamble, access address, header, CRC */
+#define L2CAP_ATT_HEADER_BYTES  7U              /**< L2CAP header and ATT opcode with handle */
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief Notification in TX buffer of SoftDevice
+*/
+typedef struct {
+    uint64_t hvx_us;                /**< time of sd_ble_gatts_hvx() */
+    uint16_t handle;
+    uint16_t len;
+    uint16_t frags_total;
+    uint16_t frags_sent;
+    uint8_t  data[LINK_SIM_DATA_MAX];
+} link_sim_packet_t;
+
+static link_sim_config_t m_config;
+static link_sim_stats_t  m_stats;
+static uint16_t          m_conn_handle;
+static uint16_t          m_input_evt_handle;
+static uint32_t          m_rand;
+
+static link_sim_packet_t m_queue[LINK_SIM_QUEUE_SIZE];
+static uint32_t          m_queue_head = 0;
+static uint32_t          m_queue_tail = 0;
+
+static uint64_t m_now_us = 0;
+static uint64_t m_next_event_us = 0;
+static uint32_t m_interval_us = 0;
+static uint16_t m_skipped = 0;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static uint64_t ticks_to_us(uint64_t ticks);
+static uint64_t us_to_ticks(uint64_t us);
+static uint32_t rand_next(void);
+static void hist_add(link_sim_hist_t * p_hist, uint64_t latency_us);
+static void hist_print(FILE * p_file, const char * p_title, link_sim_hist_t const * p_hist);
+static void time_advance_to(uint64_t us);
+static void hvx_hook(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len);
+static void packet_delivered(link_sim_packet_t const * p_packet, uint64_t at_us);
+static void conn_event(void);
+
+static uint64_t ticks_to_us(uint64_t ticks) {
+    return (ticks * 1000000U) / RTC_HZ;
+}
+
+static uint64_t us_to_ticks(uint64_t us) {
+    return (us * RTC_HZ) / 1000000U;
+}
+
+/** @brief xorshift32, sequence depends only on seed
+*/
+static uint32_t rand_next(void) {
+
+    m_rand ^= m_rand << 13;
+    m_rand ^= m_rand >> 17;
+    m_rand ^= m_rand << 5;
+    return m_rand;
+}
+
+static void hist_add(link_sim_hist_t * p_hist, uint64_t latency_us) {
+
+    uint32_t ms     = (uint32_t)(latency_us / 1000U);
+    uint8_t  bucket = 0;
+
+    while ((ms != 0) && (bucket < LINK_SIM_HIST_BUCKETS - 1)) {
+        ms >>= 1;
+        bucket++;
+    }
+
+    p_hist->buckets[bucket]++;
+    p_hist->count++;
+    p_hist->sum_us += latency_us;
+    if (latency_us > p_hist->max_us)
+        p_hist->max_us = (uint32_t)latency_us;
+}
+
+static void hist_print(FILE * p_file, const char * p_title, link_sim_hist_t const * p_hist) {
+
+    fprintf(p_file, "%s: %u samples", p_title, p_hist->count);
+    if (p_hist->count == 0) {
+        fprintf(p_file, "\n");
+        return;
+    }
+    fprintf(p_file, ", avg %.2f ms, max %.2f ms\n",
+            (double)p_hist->sum_us / p_hist->count / 1000.0, p_hist->max_us / 1000.0);
+
+    for (uint8_t i = 0; i < LINK_SIM_HIST_BUCKETS; i++) {
+        uint32_t low  = (i == 0) ? 0 : (1U << (i - 1));
+        uint32_t pct  = (uint32_t)(((uint64_t)p_hist->buckets[i] * 100U + p_hist->count / 2) / p_hist->count);
+        char     bar[51];
+
+        if (p_hist->buckets[i] == 0)
+            continue;
+
+        memset(bar, '#', pct / 2);
+        bar[pct / 2] = '\0';
+        if (i == LINK_SIM_HIST_BUCKETS - 1)
+            fprintf(p_file, "  >= %4u ms      %7u %3u%% %s\n", low, p_hist->buckets[i], pct, bar);
+        else
+            fprintf(p_file, "  %4u..%4u ms   %7u %3u%% %s\n", low, 1U << i, p_hist->buckets[i], pct, bar);
+    }
+}
+
+/** @brief Time of model and time of fake layer go together, timers of application expire on the way
+*/
+static void time_advance_to(uint64_t us) {
+
+    uint64_t target = us_to_ticks(us);
+    uint64_t now    = fake_time_ticks();
+
+    m_now_us = us;
+    if (target > now)
+        fake_time_advance((uint32_t)(target - now));
+    else
+        fake_events_process();
+}
+
+/** @brief Notification accepted by stack waits in TX buffer for connection event
+*/
+static void hvx_hook(uint16_t conn_handle, uint16_t handle, uint8_t const * p_data, uint16_t len) {
+
+    if (conn_handle != m_conn_handle)
+        return;
+
+    if ((m_queue_head - m_queue_tail) == LINK_SIM_QUEUE_SIZE) {
+        fprintf(stderr, "link sim: more notifications than TX buffers\n");
+        return;
+    }
+
+    link_sim_packet_t * p_packet = &m_queue[m_queue_head % LINK_SIM_QUEUE_SIZE];
+    uint32_t            bytes    = len + L2CAP_ATT_HEADER_BYTES;
+
+    p_packet->hvx_us      = ticks_to_us(fake_time_ticks());
+    p_packet->handle      = handle;
+    p_packet->len         = len;
+    p_packet->frags_total = (uint16_t)((bytes + m_config.ll_payload - 1) / m_config.ll_payload);
+    p_packet->frags_sent  = 0;
+    memcpy(p_packet->data, p_data, MIN(len, LINK_SIM_DATA_MAX));
+    m_queue_head++;
+}
+
+/** @brief Central got the last fragment, events of input characteristic carry time of their detection
+*/
+static void packet_delivered(link_sim_packet_t const * p_packet, uint64_t at_us) {
+
+    m_stats.notifications++;
+    m_stats.bytes += p_packet->len;
+    hist_add(&m_stats.hvx_latency, at_us - p_packet->hvx_us);
+
+    if ((p_packet->handle != m_input_evt_handle) || (p_packet->len > LINK_SIM_DATA_MAX))
+        return;
+
+    uint32_t at_ticks = (uint32_t)us_to_ticks(at_us);
+    uint16_t count    = (p_packet->len - 1) / SQS_INPUT_EVT_SIZE;
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t const * p_evt = &p_packet->data[1 + i * SQS_INPUT_EVT_SIZE];
+        uint32_t ticks = p_evt[0] | ((uint32_t)p_evt[1] << 8) | ((uint32_t)p_evt[2] << 16);
+
+        hist_add(&m_stats.input_latency, ticks_to_us((at_ticks - ticks) & RTC_MASK));
+        m_stats.input_events++;
+    }
+}
+
+/** @brief One connection event, peripheral sends queued notifications or skips event
+*/
+static void conn_event(void) {
+
+    m_stats.events_total++;
+
+    if ((m_queue_head == m_queue_tail) && (m_skipped < m_config.slave_latency)) {
+        m_skipped++;
+        return;
+    }
+    m_skipped = 0;
+    m_stats.events_attended++;
+
+    uint64_t t       = m_now_us;
+    uint64_t end     = m_now_us + m_interval_us - LL_T_IFS_US;
+    uint8_t  sent    = 0;
+    uint8_t  acked   = 0;
+
+    while ((m_queue_head != m_queue_tail) && (sent < m_config.packets_per_event)) {
+
+        link_sim_packet_t * p_packet = &m_queue[m_queue_tail % LINK_SIM_QUEUE_SIZE];
+        uint32_t bytes_left = p_packet->len + L2CAP_ATT_HEADER_BYTES - p_packet->frags_sent * m_config.ll_payload;
+        uint32_t payload    = MIN(bytes_left, m_config.ll_payload);
+        uint32_t pair_us    = LL_EMPTY_PDU_US + LL_T_IFS_US + (LL_OVERHEAD_BYTES + payload) * 8U + LL_T_IFS_US;
+
+        if (t + pair_us > end)
+            break;
+
+        t += pair_us;
+        sent++;
+        m_stats.ll_packets++;
+
+        /// central doesn't acknowledge lost packet, event is closed
+        if ((rand_next() % 1000U) < m_config.loss_permille) {
+            m_stats.ll_lost++;
+            break;
+        }
+
+        p_packet->frags_sent++;
+        if (p_packet->frags_sent == p_packet->frags_total) {
+            packet_delivered(p_packet, t);
+            m_queue_tail++;
+            acked++;
+        }
+    }
+
+    time_advance_to(t);
+
+    if (acked != 0) {
+        fake_ble_evt_tx_complete(m_conn_handle, acked);
+        fake_events_process();
+    }
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Defaults of S132 v3 for link of peripheral without DLE
+*/
+void link_sim_config_default(link_sim_config_t * p_config) {
+
+    p_config->conn_interval     = 24;       /// 30 ms
+    p_config->slave_latency     = 0;
+    p_config->tx_buffers        = 6;
+    p_config->att_mtu           = GATT_MTU_SIZE_DEFAULT;
+    p_config->ll_payload        = 27;
+    p_config->packets_per_event = 6;
+    p_config->loss_permille     = 0;
+    p_config->seed              = 1;
+}
+
+/**
+    @brief Start model of link, tx_buffers must be set in fake layer before connection
+*/
+void link_sim_start(uint16_t conn_handle, link_sim_config_t const * p_config, uint16_t input_evt_handle) {
+
+    m_config           = *p_config;
+    m_conn_handle      = conn_handle;
+    m_input_evt_handle = input_evt_handle;
+    m_rand             = (p_config->seed != 0) ? p_config->seed : 1;
+    m_queue_head       = 0;
+    m_queue_tail       = 0;
+    m_skipped          = 0;
+    m_interval_us      = p_config->conn_interval * 1250U;
+    m_now_us           = ticks_to_us(fake_time_ticks());
+    m_next_event_us    = m_now_us + m_interval_us;
+    memset(&m_stats, 0, sizeof(m_stats));
+
+    fake_sd_att_mtu_set(conn_handle, p_config->att_mtu);
+    fake_hvx_hook_set(hvx_hook);
+}
+
+/**
+    @brief Run link for duration, producer is called with its rate between connection events
+*/
+void link_sim_run(uint32_t duration_ms, link_sim_producer_t producer, uint32_t producer_rate_hz) {
+
+    uint64_t start_us   = m_now_us;
+    uint64_t end_us     = m_now_us + (uint64_t)duration_ms * 1000U;
+    uint64_t period_us  = (producer_rate_hz != 0) ? (1000000U / producer_rate_hz) : 0;
+    uint64_t produce_us = m_now_us + period_us;
+
+    if (period_us == 0)
+        producer = NULL;
+
+    for (;;) {
+        bool     produce = (producer != NULL) && (produce_us < m_next_event_us);
+        uint64_t next    = produce ? produce_us : m_next_event_us;
+
+        if (next >= end_us)
+            break;
+
+        time_advance_to(next);
+
+        if (produce) {
+            producer();
+            fake_events_process();
+            produce_us += period_us;
+        } else {
+            conn_event();
+            m_next_event_us += m_interval_us;
+        }
+    }
+
+    time_advance_to(end_us);
+    m_stats.duration_us += end_us - start_us;
+}
+
+link_sim_stats_t const * link_sim_stats_get(void) {
+    return &m_stats;
+}
+
+void link_sim_report(FILE * p_file) {
+
+    double seconds = (double)m_stats.duration_us / 1000000.0;
+
+    fprintf(p_file, "link: interval %.2f ms, latency %u, tx buffers %u, ATT MTU %u, LL payload %u, "
+                    "%u packets/event, loss %u permille, seed %u\n",
+            m_config.conn_interval * 1.25, m_config.slave_latency, m_config.tx_buffers, m_config.att_mtu,
+            m_config.ll_payload, m_config.packets_per_event, m_config.loss_permille, m_config.seed);
+    fprintf(p_file, "time %.3f s, events %u, attended %u (%.1f%%)\n", seconds, m_stats.events_total,
+            m_stats.events_attended,
+            (m_stats.events_total != 0) ? 100.0 * m_stats.events_attended / m_stats.events_total : 0.0);
+    fprintf(p_file, "LL packets %u, lost %u\n", m_stats.ll_packets, m_stats.ll_lost);
+    fprintf(p_file, "notifications %u, %.1f /s, %.1f bytes/s\n", m_stats.notifications,
+            m_stats.notifications / seconds, (double)m_stats.bytes / seconds);
+    fprintf(p_file, "input events %u, %.1f /s\n", m_stats.input_events, m_stats.input_events / seconds);
+    hist_print(p_file, "latency hvx -> central", &m_stats.hvx_latency);
+    hist_print(p_file, "latency input event -> central", &m_stats.input_latency);
+}
@@ -0,0 +1,79 @@
+/*!
+    @brief Discrete-event model of BLE link between application on fake
+    SoftDevice and one central.
+
+    Link has connection events every connection interval. Peripheral skips
+    up to slave latency events when it has nothing to send. In attended event
+    queued notifications are sent in order, split to LL packets by LL payload
+    size, up to packets per event and length of interval. Lost packet ends the
+    event, it is retransmitted in the next attended event. After every event
+    TX_COMPLETE is reported to application for delivered notifications.
+
+    All random values come from seeded generator, so run is repeatable.
+*/
+
+#ifndef BLE_LINK_SIM_H__
+#define BLE_LINK_SIM_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LINK_SIM_HIST_BUCKETS   12U     /**< latency buckets 0-1-2-4-...-1024 ms and more */
+#define LINK_SIM_QUEUE_SIZE     32U     /**< max notifications in TX buffers of SoftDevice */
+#define LINK_SIM_DATA_MAX       64U
+
+/**
+    @brief Parameters of link
+*/
+typedef struct {
+    uint16_t conn_interval;         /**< in 1.25 ms units, 6..3200 */
+    uint16_t slave_latency;         /**< count of events peripheral can skip */
+    uint8_t  tx_buffers;            /**< notifications queued in SoftDevice */
+    uint16_t att_mtu;               /**< after MTU exchange, 23..247 */
+    uint8_t  ll_payload;            /**< max payload of LL packet, 27 or up to 251 with DLE */
+    uint8_t  packets_per_event;     /**< max LL packets from peripheral in one event */
+    uint16_t loss_permille;         /**< probability of loss of LL packet */
+    uint32_t seed;
+} link_sim_config_t;
+
+/**
+    @brief Latency histogram
+*/
+typedef struct {
+    uint32_t count;
+    uint64_t sum_us;
+    uint32_t max_us;
+    uint32_t buckets[LINK_SIM_HIST_BUCKETS];
+} link_sim_hist_t;
+
+/**
+    @brief Results of run
+*/
+typedef struct {
+    uint64_t        duration_us;
+    uint32_t        events_total;
+    uint32_t        events_attended;
+    uint32_t        ll_packets;         /**< sent LL packets with data, with retransmissions */
+    uint32_t        ll_lost;
+    uint32_t        notifications;      /**< delivered notifications */
+    uint64_t        bytes;              /**< delivered bytes of ATT payload */
+    uint32_t        input_events;       /**< delivered events of input event characteristic */
+    link_sim_hist_t hvx_latency;        /**< from sd_ble_gatts_hvx() to delivery */
+    link_sim_hist_t input_latency;      /**< from detection of input event to delivery */
+} link_sim_stats_t;
+
+/**@brief Producer of traffic, called at its rate. */
+typedef void (*link_sim_producer_t)(void);
+
+void link_sim_config_default(link_sim_config_t * p_config);
+
+/** Link must be connected, handle of input event characteristic is used for decoding of timestamps */
+void link_sim_start(uint16_t conn_handle, link_sim_config_t const * p_config, uint16_t input_evt_handle);
+
+void link_sim_run(uint32_t duration_ms, link_sim_producer_t producer, uint32_t producer_rate_hz);
+
+link_sim_stats_t const * link_sim_stats_get(void);
+void link_sim_report(FILE * p_file);
+
+#endif
@@ -0,0 +1,185 @@
+/**
+    @brief Throughput simulator: application on fake SoftDevice with model of BLE link.
+
+    Usage: nrfblesq_sim [options]
+        --interval-ms X     connection interval, 7.5..4000 ms (30)
+        --latency N         slave latency (0)
+        --tx-buffers N      TX buffers of SoftDevice (6)
+        --mtu N             ATT MTU (23)
+        --ll-payload N      LL payload, 27..251 (27)
+        --packets N         LL packets per connection event (6)
+        --loss N            loss of LL packets, permille (0)
+        --seed N            seed of random generator (1)
+        --duration-ms N     time of run (10000)
+        --workload W        input | adc | none (input)
+        --rate N            events of workload per second (100)
+
+    Workload "input" pushes events to FIFO of input event characteristic, they
+    are batched to notifications. Workload "adc" notifies new ADC value, if
+    stack has no free buffer, the value is counted as dropped: only the latest
+    one is sent on TX_COMPLETE.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <getopt.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdk_stub.h"
+#include "ble_link_sim.h"
+#include "sq_service_handler.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define SIM_TICKS_PER_MS(MS)    ((uint32_t)(((uint64_t)(MS) * 32768U) / 1000U))
+#define SIM_CONN_HANDLE         0U
+#define SIM_BOOT_MS             1500U       /**< deferred init and first samples of application */
+
+/// UUIDs of characteristics of sq_service.c
+#define SIM_IN_UUID             0x08
+#define SIM_ADC_UUID            0x0F
+#define SIM_IN_EVT_UUID         0x40
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+static link_sim_config_t   m_config;
+static uint32_t            m_duration_ms = 10000;
+static uint32_t            m_rate_hz = 100;
+static link_sim_producer_t m_producer = NULL;
+
+static jmp_buf  m_run_end;
+static bool     m_run_done = false;
+static uint32_t m_produced = 0;
+static uint32_t m_dropped = 0;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+int app_main(void);
+
+static void producer_input(void);
+static void producer_adc(void);
+static void sim_session(void);
+static void usage(const char * p_name);
+
+/** @brief Input changes, events wait in FIFO until they are sent
+*/
+static void producer_input(void) {
+
+    sq_service_push_input_event((uint8_t)(m_produced & 0x01), SQ_INPUT_EVT_CODE(0, 1));
+    sq_service_input_events_flush();
+    m_produced++;
+}
+
+/** @brief New value of ADC, it is replaced by next one if it can't be notified now
+*/
+static void producer_adc(void) {
+
+    if (sq_service_update_adc_characteristic((uint16_t)m_produced) != NRF_SUCCESS)
+        m_dropped++;
+    m_produced++;
+}
+
+/**
+    @brief Session is played when application waits for events first time
+*/
+static void sim_session(void) {
+
+    if (m_run_done)
+        longjmp(m_run_end, 1);
+    m_run_done = true;
+
+    fake_time_advance(SIM_TICKS_PER_MS(SIM_BOOT_MS));
+
+    fake_ble_evt_connected(SIM_CONN_HANDLE);
+    fake_events_process();
+    link_sim_start(SIM_CONN_HANDLE, &m_config, fake_gatts_value_handle_find(SIM_IN_EVT_UUID));
+
+    fake_gatts_notify_enable(SIM_CONN_HANDLE, SIM_IN_UUID, true);
+    fake_gatts_notify_enable(SIM_CONN_HANDLE, SIM_ADC_UUID, true);
+    fake_gatts_notify_enable(SIM_CONN_HANDLE, SIM_IN_EVT_UUID, true);
+    fake_events_process();
+
+    link_sim_run(m_duration_ms, m_producer, m_rate_hz);
+
+    longjmp(m_run_end, 1);
+}
+
+static void usage(const char * p_name) {
+
+    fprintf(stderr, "usage: %s [--interval-ms X] [--latency N] [--tx-buffers N] [--mtu N] [--ll-payload N]\n"
+                    "       [--packets N] [--loss N] [--seed N] [--duration-ms N] [--workload input|adc|none] [--rate N]\n",
+            p_name);
+    exit(2);
+}
+
+int main(int argc, char * argv[]) {
+
+    static const struct option options[] = {
+        {"interval-ms", required_argument, NULL, 'i'},
+        {"latency",     required_argument, NULL, 'l'},
+        {"tx-buffers",  required_argument, NULL, 'b'},
+        {"mtu",         required_argument, NULL, 'm'},
+        {"ll-payload",  required_argument, NULL, 'p'},
+        {"packets",     required_argument, NULL, 'n'},
+        {"loss",        required_argument, NULL, 'x'},
+        {"seed",        required_argument, NULL, 's'},
+        {"duration-ms", required_argument, NULL, 'd'},
+        {"workload",    required_argument, NULL, 'w'},
+        {"rate",        required_argument, NULL, 'r'},
+        {NULL, 0, NULL, 0}
+    };
+    const char * p_workload = "input";
+    int          opt;
+
+    link_sim_config_default(&m_config);
+
+    while ((opt = getopt_long(argc, argv, "", options, NULL)) != -1) {
+        switch (opt)
+        {
+            case 'i': m_config.conn_interval     = (uint16_t)(atof(optarg) / 1.25 + 0.5); break;
+            case 'l': m_config.slave_latency     = (uint16_t)atoi(optarg); break;
+            case 'b': m_config.tx_buffers        = (uint8_t)atoi(optarg); break;
+            case 'm': m_config.att_mtu           = (uint16_t)atoi(optarg); break;
+            case 'p': m_config.ll_payload        = (uint8_t)atoi(optarg); break;
+            case 'n': m_config.packets_per_event = (uint8_t)atoi(optarg); break;
+            case 'x': m_config.loss_permille     = (uint16_t)atoi(optarg); break;
+            case 's': m_config.seed              = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': m_duration_ms              = (uint32_t)atoi(optarg); break;
+            case 'w': p_workload                 = optarg; break;
+            case 'r': m_rate_hz                  = (uint32_t)atoi(optarg); break;
+            default:  usage(argv[0]);
+        }
+    }
+
+    if      (strcmp(p_workload, "input") == 0) m_producer = producer_input;
+    else if (strcmp(p_workload, "adc") == 0)   m_producer = producer_adc;
+    else if (strcmp(p_workload, "none") != 0)  usage(argv[0]);
+
+    if ((m_config.conn_interval < 6) || (m_config.conn_interval > 3200) ||
+        (m_config.tx_buffers == 0) || (m_config.tx_buffers > LINK_SIM_QUEUE_SIZE) ||
+        (m_config.att_mtu < 23) || (m_config.att_mtu > 247) ||
+        (m_config.ll_payload < 27) || (m_config.ll_payload > 251) ||
+        (m_config.packets_per_event == 0) || (m_config.loss_permille > 1000))
+        usage(argv[0]);
+
+    fake_reset();
+    fake_sd_tx_buffers_set(m_config.tx_buffers);
+    fake_idle_hook_set(sim_session);
+
+    if (setjmp(m_run_end) == 0)
+        app_main();
+
+    printf("workload %s, %u /s: produced %u, dropped %u\n", p_workload, m_rate_hz, m_produced, m_dropped);
+    link_sim_report(stdout);
+
+    return (fake_app_error_count() == 0) ? 0 : 1;
+}
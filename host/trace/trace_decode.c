@@ -0,0 +1,260 @@
+/**
+    @brief Decoder of event trace of my_trace_manager.
+
+    Usage: nrfblesq_trace_decode <trace>
+
+    Value of trace diagnostic characteristic of sq-service (trace of run
+    before the last reset) is printed as text. File is raw value or hex text
+    as it is copied from GATT client ("01-3F-00-00...", "0x013F0000...").
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "my_trace_manager.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define DECODE_RTC_HZ           32768.0
+#define DECODE_TICKS_MASK       0x00FFFFFFU
+#define DECODE_TYPE_POS         24U
+#define DECODE_FILE_MAX         4096U
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief Name of value
+*/
+typedef struct {
+    uint32_t     value;
+    char const * p_name;
+} decode_name_t;
+
+static decode_name_t const m_type_names[] = {
+    {TRACE_TYPE_BOOT,       "boot"},
+    {TRACE_TYPE_BLE_EVT,    "ble_evt"},
+    {TRACE_TYPE_ENTER,      "enter"},
+    {TRACE_TYPE_EXIT,       "exit"},
+    {TRACE_TYPE_VALUE,      "value"},
+    {TRACE_TYPE_ERROR,      "error"},
+    {TRACE_TYPE_ERROR_FILE, "error_file"},
+    {TRACE_TYPE_FAULT_PC,   "fault_pc"},
+    {TRACE_TYPE_FAULT_LR,   "fault_lr"},
+    {TRACE_TYPE_FAULT_CFSR, "fault_cfsr"},
+};
+
+static decode_name_t const m_point_names[] = {
+    {TRACE_POINT_BLE_DISPATCH,  "ble_dispatch"},
+    {TRACE_POINT_SAADC,         "saadc"},
+    {TRACE_POINT_ADC_TIMER,     "adc_timer"},
+    {TRACE_POINT_LED_TIMER,     "led_timer"},
+    {TRACE_POINT_INPUT_GPIOTE,  "input_gpiote"},
+    {TRACE_POINT_INPUT_TIMER,   "input_timer"},
+    {TRACE_POINT_STORAGE_TIMER, "storage_timer"},
+    {TRACE_POINT_STORAGE_FDS,   "storage_fds"},
+    {TRACE_POINT_RSSI_START,    "rssi_start"},
+    {TRACE_POINT_RSSI_STOP,     "rssi_stop"},
+    {TRACE_POINT_OUT_REG1,      "out_reg1"},
+    {TRACE_POINT_ADC_MV,        "adc_mv"},
+    {TRACE_POINT_TX_POWER,      "tx_power"},
+};
+
+/// IDs of events of S132 v3
+static decode_name_t const m_evt_names[] = {
+    {0x01, "TX_COMPLETE"},
+    {0x02, "USER_MEM_REQUEST"},
+    {0x03, "USER_MEM_RELEASE"},
+    {0x04, "DATA_LENGTH_CHANGED"},
+    {0x10, "GAP_CONNECTED"},
+    {0x11, "GAP_DISCONNECTED"},
+    {0x12, "GAP_CONN_PARAM_UPDATE"},
+    {0x13, "GAP_SEC_PARAMS_REQUEST"},
+    {0x14, "GAP_SEC_INFO_REQUEST"},
+    {0x15, "GAP_PASSKEY_DISPLAY"},
+    {0x16, "GAP_KEY_PRESSED"},
+    {0x17, "GAP_AUTH_KEY_REQUEST"},
+    {0x18, "GAP_LESC_DHKEY_REQUEST"},
+    {0x19, "GAP_AUTH_STATUS"},
+    {0x1A, "GAP_CONN_SEC_UPDATE"},
+    {0x1B, "GAP_TIMEOUT"},
+    {0x1C, "GAP_RSSI_CHANGED"},
+    {0x1D, "GAP_ADV_REPORT"},
+    {0x1E, "GAP_SEC_REQUEST"},
+    {0x1F, "GAP_CONN_PARAM_UPDATE_REQUEST"},
+    {0x20, "GAP_SCAN_REQ_REPORT"},
+    {0x50, "GATTS_WRITE"},
+    {0x51, "GATTS_RW_AUTHORIZE_REQUEST"},
+    {0x52, "GATTS_SYS_ATTR_MISSING"},
+    {0x53, "GATTS_HVC"},
+    {0x54, "GATTS_SC_CONFIRM"},
+    {0x55, "GATTS_EXCHANGE_MTU_REQUEST"},
+    {0x56, "GATTS_TIMEOUT"},
+};
+
+#define DECODE_NAME(TABLE, VALUE)   name_find(TABLE, sizeof(TABLE) / sizeof(TABLE[0]), VALUE)
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static char const * name_find(decode_name_t const * p_table, size_t count, uint32_t value);
+static size_t value_read(const char * p_path, uint8_t * p_buf, size_t max_len);
+static uint32_t uint32_at(uint8_t const * p_data);
+static void record_print(uint32_t word0, uint32_t word1);
+
+static char const * name_find(decode_name_t const * p_table, size_t count, uint32_t value) {
+
+    for (size_t i = 0; i < count; i++) {
+        if (p_table[i].value == value)
+            return p_table[i].p_name;
+    }
+    return "?";
+}
+
+/**
+    @brief Value from file, hex text is converted, other file is raw value
+    @return length of value, 0 if file can't be read
+*/
+static size_t value_read(const char * p_path, uint8_t * p_buf, size_t max_len) {
+
+    static char text[2 * DECODE_FILE_MAX];
+
+    FILE * p_file = fopen(p_path, "rb");
+    if (p_file == NULL)
+        return 0;
+    size_t size = fread(text, 1, sizeof(text) - 1, p_file);
+    fclose(p_file);
+    text[size] = '\0';
+
+    /// hex text has only digits, separators and 0x prefixes
+    bool is_text = (size > 0);
+    for (size_t i = 0; (i < size) && is_text; i++) {
+        char c = text[i];
+        if (!isxdigit((unsigned char)c) && !isspace((unsigned char)c) && (strchr("-:,x()", c) == NULL))
+            is_text = false;
+    }
+
+    if (!is_text) {
+        size_t len = (size < max_len) ? size : max_len;
+        memcpy(p_buf, text, len);
+        return len;
+    }
+
+    size_t len = 0;
+    char * p_char = text;
+    while ((*p_char != '\0') && (len < max_len)) {
+        if ((p_char[0] == '0') && (p_char[1] == 'x')) {
+            p_char += 2;
+        } else if (isxdigit((unsigned char)p_char[0]) && isxdigit((unsigned char)p_char[1])) {
+            char byte[3] = {p_char[0], p_char[1], '\0'};
+            p_buf[len++] = (uint8_t)strtoul(byte, NULL, 16);
+            p_char += 2;
+        } else {
+            p_char++;
+        }
+    }
+    return len;
+}
+
+static uint32_t uint32_at(uint8_t const * p_data) {
+    return (uint32_t)p_data[0] | ((uint32_t)p_data[1] << 8) |
+           ((uint32_t)p_data[2] << 16) | ((uint32_t)p_data[3] << 24);
+}
+
+/**
+    @brief Text of one record, time is printed by caller
+*/
+static void record_print(uint32_t word0, uint32_t word1) {
+
+    uint32_t type  = word0 >> DECODE_TYPE_POS;
+    uint32_t id    = word1 >> 16;
+    uint32_t value = word1 & 0xFFFF;
+
+    printf("%-11s ", DECODE_NAME(m_type_names, type));
+
+    switch (type)
+    {
+        case TRACE_TYPE_BOOT:
+            printf("reset reason 0x%08x", word1);
+            break;
+        case TRACE_TYPE_BLE_EVT:
+            printf("%s (0x%02x) conn 0x%04x", DECODE_NAME(m_evt_names, id), id, value);
+            break;
+        case TRACE_TYPE_ENTER:
+        case TRACE_TYPE_EXIT:
+            printf("%s", DECODE_NAME(m_point_names, id));
+            break;
+        case TRACE_TYPE_VALUE:
+            /// TX power is signed, dBm
+            if (id == TRACE_POINT_TX_POWER)
+                printf("%s = %d (0x%04x)", DECODE_NAME(m_point_names, id), (int16_t)value, value);
+            else
+                printf("%s = %u (0x%04x)", DECODE_NAME(m_point_names, id), value, value);
+            break;
+        case TRACE_TYPE_ERROR:
+            if (id != 0)
+                printf("line %u, error 0x%04x", id, value);
+            else
+                printf("fault id 0x%04x", value);
+            break;
+        default:
+            printf("0x%08x", word1);
+            break;
+    }
+    printf("\n");
+}
+
+int main(int argc, char * argv[]) {
+
+    static uint8_t value[DECODE_FILE_MAX];
+    uint32_t       last_ticks = 0;
+    uint64_t       wraps = 0;
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <trace>\n", argv[0]);
+        return 2;
+    }
+
+    size_t len = value_read(argv[1], value, sizeof(value));
+    if (len < TRACE_DIAG_HEADER_LEN) {
+        fprintf(stderr, "%s: no trace\n", argv[1]);
+        return 1;
+    }
+    if (value[0] != TRACE_DIAG_VERSION) {
+        fprintf(stderr, "%s: version %u isn't supported\n", argv[1], value[0]);
+        return 1;
+    }
+
+    uint32_t count = value[1];
+    uint32_t total = uint32_at(&value[4]);
+
+    if (TRACE_DIAG_HEADER_LEN + count * TRACE_DIAG_RECORD_LEN > len) {
+        fprintf(stderr, "%s: %u records don't fit %zu bytes\n", argv[1], count, len);
+        return 1;
+    }
+
+    printf("%u records of %u since boot\n", count, total);
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t const * p_record = &value[TRACE_DIAG_HEADER_LEN + i * TRACE_DIAG_RECORD_LEN];
+        uint32_t        word0 = uint32_at(p_record);
+        uint32_t        ticks = word0 & DECODE_TICKS_MASK;
+
+        /// RTC1 is 24-bit, records are in order of time
+        if (ticks < last_ticks)
+            wraps++;
+        last_ticks = ticks;
+
+        printf("[%12.6f] ", ((double)(wraps << 24) + ticks) / DECODE_RTC_HZ);
+        record_print(word0, uint32_at(p_record + 4));
+    }
+    return 0;
+}
@@ -67,12 +67,27 @@
 #include "ble_tps.h"
 #include "sq_service_handler.h"
 #include "bas_service_handler.h"
+#include "tps_service_handler.h"
 
 /* custom modules */
 #include "bsp.h"
 #include "my_adc_manager.h"
+#include "my_boot_manager.h"
+#include "my_bond_manager.h"
+#include "my_energy_manager.h"
 #include "my_gpio_manager.h"
+#include "my_input_manager.h"
+#include "my_log_manager.h"
 #include "my_rssi_manager.h"
+#include "my_link_manager.h"
+#include "my_radio_manager.h"
+#include "my_time_manager.h"
+#include "my_broadcast_manager.h"
+#include "my_adv_manager.h"
+#include "my_advdata_manager.h"
+#include "my_stats_manager.h"
+#include "my_storage_manager.h"
+#include "my_trace_manager.h"
 
 #include "nrf_gpio.h"
 #include "ble_hci.h"
@@ -99,12 +114,9 @@
 #define APP_FEATURE_NOT_SUPPORTED       BLE_GATT_STATUS_ATTERR_APP_BEGIN + 2        /**< Reply when unsupported features are requested. */
 
 #define CENTRAL_LINK_COUNT              0                                           /**< Number of central links used by the application. When changing this number remember to adjust the RAM settings*/
-#define PERIPHERAL_LINK_COUNT           1                                           /**< Number of peripheral links used by the application. When changing this number remember to adjust the RAM settings*/
+#define PERIPHERAL_LINK_COUNT           PERIPHERAL_LINK_MAX                         /**< Number of peripheral links used by the application. When changing this number remember to adjust the RAM settings*/
 
-#define DEVICE_NAME                     "sq device"                                 /**< Name of device. Will be included in the advertising data. */
 #define MANUFACTURER_NAME               "squel.ru"                                  /**< Manufacturer. Will be passed to Device Information Service. */
-#define APP_ADV_INTERVAL                300                                         /**< The advertising interval (in units of 0.625 ms. This value corresponds to 187.5 ms). */
-#define APP_ADV_TIMEOUT_IN_SECONDS      180                                         /**< The advertising timeout in units of seconds. */
 
 #define MIN_CONN_INTERVAL               MSEC_TO_UNITS(100, UNIT_1_25_MS)            /**< Minimum acceptable connection interval (0.1 seconds). */
 #define MAX_CONN_INTERVAL               MSEC_TO_UNITS(200, UNIT_1_25_MS)            /**< Maximum acceptable connection interval (0.2 second). */
@@ -130,15 +142,8 @@
 /* ============================== data ================================ */
 /* ==================================================================== */
 
-static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;                            /**< Handle of the current connection. */
-
-/*
-    YOUR_JOB: Use UUIDs for service(s) used in your application.
-*/
-static ble_uuid_t m_adv_uuids[] = {{BLE_UUID_DEVICE_INFORMATION_SERVICE, BLE_UUID_TYPE_BLE},
-                                   {BLE_UUID_BATTERY_SERVICE, BLE_UUID_TYPE_BLE},
-                                   {BLE_UUID_TX_POWER_SERVICE, BLE_UUID_TYPE_BLE},
-                                   {BLE_UUID_SQ_SERVICE, BLE_UUID_TYPE_BLE}}; /**< Universally unique service identifiers. */
+static uint16_t m_conn_handle = BLE_CONN_HANDLE_INVALID;                            /**< Handle of the newest connection, it is followed by ble_conn_params. */
+static bool     m_advertising = false;                                              /**< Advertising is running, it is stopped by SoftDevice on connection. */
 
 /* ==================================================================== */
 /* ==================== function prototypes =========================== */
@@ -172,7 +177,8 @@ void assert_nrf_callback(uint16_t line_num, const uint8_t * p_file_name)
  */
 static void pm_evt_handler(pm_evt_t const * p_evt)
 {
-    ret_code_t err_code;
+    /// cache of bonds for reconnection
+    my_bond_on_pm_evt(p_evt);
 
     switch (p_evt->evt_id)
     {
@@ -201,23 +207,15 @@ static void pm_evt_handler(pm_evt_t const * p_evt)
 
         case PM_EVT_CONN_SEC_CONFIG_REQ:
         {
-            // Reject pairing request from an already bonded peer.
-            pm_conn_sec_config_t conn_sec_config = {.allow_repairing = false};
+            /// central, which lost its keys, pairs again, its bond is replaced
+            pm_conn_sec_config_t conn_sec_config = {.allow_repairing = true};
             pm_conn_sec_config_reply(p_evt->conn_handle, &conn_sec_config);
         } break;
 
         case PM_EVT_STORAGE_FULL:
         {
-            // Run garbage collection on the flash.
-            err_code = fds_gc();
-            if (err_code == FDS_ERR_BUSY || err_code == FDS_ERR_NO_SPACE_IN_QUEUES)
-            {
-                // Retry.
-            }
-            else
-            {
-                APP_ERROR_CHECK(err_code);
-            }
+            /// GC is started at once or retried by storage, peer manager writes again after it
+            my_storage_gc_request(true);
         } break;
 
         case PM_EVT_PEERS_DELETE_SUCCEEDED:
@@ -267,6 +265,33 @@ static void pm_evt_handler(pm_evt_t const * p_evt)
 }
 
 
+/**
+    @brief Handler of configuration restored from flash: apply stored outputs and tunables
+*/
+static void storage_restore_handler(my_config_t const * p_config)
+{
+    uint32_t err_code;
+    
+    my_gpio_out_change_state(GPIO_OUT_REG1, p_config->out_reg1);
+    
+    err_code = my_adc_timer_set_interval(p_config->adc_interval_ms);
+    APP_ERROR_CHECK(err_code);
+    
+    /// service could be not initialized yet - then it takes value from storage
+    err_code = sq_service_update_out_reg1_value(p_config->out_reg1);
+    if (err_code != NRF_ERROR_INVALID_STATE)
+    {
+        APP_ERROR_CHECK(err_code);
+    }
+    
+    err_code = sq_service_update_adc_interval_value(p_config->adc_interval_ms);
+    if (err_code != NRF_ERROR_INVALID_STATE)
+    {
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
 /**@brief Function for the Timer initialization.
  *
  * @details Initializes the timer module. This creates and starts application timers.
@@ -328,8 +353,6 @@ static void gap_params_init(void)
     err_code = sd_ble_gap_ppcp_set(&gap_conn_params);
     APP_ERROR_CHECK(err_code);    
                                           
-    //err_code = sd_ble_gap_tx_power_set(TX_POWER_LEVEL);
-    //APP_ERROR_CHECK(err_code);
 }
 
 
@@ -352,6 +375,10 @@ static void services_init(void)
 
     err_code = tps_service_init();
     APP_ERROR_CHECK(err_code);    
+
+    /// TX power is set after its service is initialized
+    err_code = my_link_init();
+    APP_ERROR_CHECK(err_code);
 }
 
 
@@ -410,16 +437,19 @@ static void conn_params_init(void)
 }
 
 
-/**@brief Function for starting timers.
+/**@brief Function for deferred init, called after first advertising event.
+ *
+ * @details ADC is configured and calibrated here, its measurement timer
+ *          runs after end of calibration, while BAS or sq-service needs it.
+ *          Radio notification moves samples before connection events.
  */
-static void application_timers_start(void)
+static void deferred_init(void)
 {
-    /* YOUR_JOB: Start your timers. below is an example of how to start a timer. */
+    adc_configure();
     
-    uint32_t err_code;
-    err_code = my_adc_timer_start();
+    /// samples of connected device are aligned to connection events
+    uint32_t err_code = my_radio_init();
     APP_ERROR_CHECK(err_code);
-
 }
 
 
@@ -449,14 +479,48 @@ static void on_adv_evt(ble_adv_evt_t ble_adv_evt)
 
     switch (ble_adv_evt)
     {
+        case BLE_ADV_EVT_PEER_ADDR_REQUEST:
+            /// directed advertising to central of lost link
+            err_code = my_bond_peer_addr_reply();
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_ADV_EVT_WHITELIST_REQUEST:
+            err_code = my_bond_whitelist_reply();
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_ADV_EVT_DIRECTED:
+        case BLE_ADV_EVT_FAST_WHITELIST:
         case BLE_ADV_EVT_FAST:
             NRF_LOG_INFO("Fast advertising\r\n");
-            err_code = led_indicate_manage(ADVERTISING_IND);
+            m_advertising = true;
+            err_code = my_broadcast_advertising_set(true);
             APP_ERROR_CHECK(err_code);
+            /// connected links are indicated while device advertises for next central
+            if (ble_conn_state_n_connections() == 0)
+            {
+                err_code = led_indicate_manage(ADVERTISING_IND);
+                APP_ERROR_CHECK(err_code);
+                MY_ENERGY_RADIO(ENERGY_RADIO_ADVERTISING, my_adv_interval_get());
+            }
             break;
 
         case BLE_ADV_EVT_IDLE:
-            sleep_mode_enter();
+            /// schedule goes to next phase, it ends only if the last phase has duration
+            if (my_adv_phase_next())
+            {
+                break;
+            }
+            m_advertising = false;
+            err_code = my_broadcast_advertising_set(false);
+            APP_ERROR_CHECK(err_code);
+            /// links stay, device sleeps only without them
+            if (ble_conn_state_n_connections() == 0)
+            {
+                MY_ENERGY_RADIO(ENERGY_RADIO_IDLE, 0);
+                sleep_mode_enter();
+            }
             break;
 
         default:
@@ -477,11 +541,20 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
     {
         case BLE_GAP_EVT_DISCONNECTED:
             NRF_LOG_INFO("Disconnected.\r\n");
-            err_code = led_indicate_manage(ADVERTISING_IND);
-            APP_ERROR_CHECK(err_code);
-            /// stop measuring of RSSI
-            err_code = sd_ble_gap_rssi_stop(m_conn_handle);
-            APP_ERROR_CHECK(err_code);
+            /// measuring of RSSI is stopped by SoftDevice with link
+            my_rssi_link_remove(p_ble_evt->evt.gap_evt.conn_handle);
+            my_time_link_remove(p_ble_evt->evt.gap_evt.conn_handle);
+            if (p_ble_evt->evt.gap_evt.conn_handle == m_conn_handle)
+            {
+                m_conn_handle = BLE_CONN_HANDLE_INVALID;
+            }
+            /// other links stay connected
+            if (ble_conn_state_n_connections() == 0)
+            {
+                err_code = led_indicate_manage(ADVERTISING_IND);
+                APP_ERROR_CHECK(err_code);
+                MY_ENERGY_RADIO(ENERGY_RADIO_IDLE, 0);
+            }
             break; // BLE_GAP_EVT_DISCONNECTED
 
         case BLE_GAP_EVT_CONNECTED:
@@ -489,11 +562,20 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
             err_code = led_indicate_manage(CONNECTED_IND);
             APP_ERROR_CHECK(err_code);
             m_conn_handle = p_ble_evt->evt.gap_evt.conn_handle;        
-            /// start measuring of RSSI
-            err_code = sd_ble_gap_rssi_start(m_conn_handle, 0, 0);
+            m_advertising = false;
+            err_code = my_broadcast_advertising_set(false);
             APP_ERROR_CHECK(err_code);
+            MY_STATS_INC(STATS_COUNTER_CONNECTIONS);
+            MY_ENERGY_RADIO(ENERGY_RADIO_CONNECTED,
+                            p_ble_evt->evt.gap_evt.params.connected.conn_params.max_conn_interval);
+            /// RSSI is measured by link manager or, without control of TX power, when central enables its notification
             break; // BLE_GAP_EVT_CONNECTED
 
+        case BLE_GAP_EVT_CONN_PARAM_UPDATE:
+            MY_ENERGY_RADIO(ENERGY_RADIO_CONNECTED,
+                            p_ble_evt->evt.gap_evt.params.conn_param_update.conn_params.max_conn_interval);
+            break; // BLE_GAP_EVT_CONN_PARAM_UPDATE
+
         case BLE_GATTC_EVT_TIMEOUT:
             // Disconnect on GATT Client timeout event.
             NRF_LOG_DEBUG("GATT Client Timeout.\r\n");
@@ -522,20 +604,14 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
 
             req = p_ble_evt->evt.gatts_evt.params.authorize_request;
 
-            if (req.type != BLE_GATTS_AUTHORIZE_TYPE_INVALID)
+            /// op shares place with offset of read request, reads are replied by service
+            if (req.type == BLE_GATTS_AUTHORIZE_TYPE_WRITE)
             {
                 if ((req.request.write.op == BLE_GATTS_OP_PREP_WRITE_REQ)     ||
                     (req.request.write.op == BLE_GATTS_OP_EXEC_WRITE_REQ_NOW) ||
                     (req.request.write.op == BLE_GATTS_OP_EXEC_WRITE_REQ_CANCEL))
                 {
-                    if (req.type == BLE_GATTS_AUTHORIZE_TYPE_WRITE)
-                    {
-                        auth_reply.type = BLE_GATTS_AUTHORIZE_TYPE_WRITE;
-                    }
-                    else
-                    {
-                        auth_reply.type = BLE_GATTS_AUTHORIZE_TYPE_READ;
-                    }
+                    auth_reply.type = BLE_GATTS_AUTHORIZE_TYPE_WRITE;
                     auth_reply.params.write.gatt_status = APP_FEATURE_NOT_SUPPORTED;
                     err_code = sd_ble_gatts_rw_authorize_reply(p_ble_evt->evt.gatts_evt.conn_handle,
                                                                &auth_reply);
@@ -556,14 +632,15 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
         */        
         case BLE_GAP_EVT_RSSI_CHANGED:
         {
-            if (m_conn_handle != BLE_CONN_HANDLE_INVALID) {
-                int8_t rssi = 0x00;
-                err_code = sd_ble_gap_rssi_get(m_conn_handle, &rssi);
-                APP_ERROR_CHECK(err_code);
-                my_rssi_push_value(rssi);
-                
-                sq_service_update_rssi_value(my_rssi_get_value());
-            }
+            uint16_t conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+            int8_t   rssi = 0x00;
+            err_code = sd_ble_gap_rssi_get(conn_handle, &rssi);
+            APP_ERROR_CHECK(err_code);
+            my_rssi_push_value(conn_handle, rssi);
+            MY_STATS_INC(STATS_COUNTER_RSSI_UPDATES);
+            
+            sq_service_update_rssi_value(conn_handle, my_rssi_get_value(conn_handle));
+            my_link_rssi_update(conn_handle, my_rssi_get_value(conn_handle));
             break;
         }               
         default:
@@ -573,6 +650,36 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
 }
 
 
+/**@brief Function for advertising for next central.
+ *
+ * @details Advertising module restarts advertising only after disconnection of
+ *          one link, so it is restarted here, while there are free links.
+ *          Central of lost bonded link is reconnected by directed advertising,
+ *          also when device advertises for next central.
+ *
+ * @param[in] p_ble_evt  Bluetooth stack event.
+ */
+static void advertising_links_update(ble_evt_t * p_ble_evt)
+{
+    uint32_t err_code;
+
+    if ( ((p_ble_evt->header.evt_id == BLE_GAP_EVT_CONNECTED)
+          || (p_ble_evt->header.evt_id == BLE_GAP_EVT_DISCONNECTED))
+          && (m_advertising == false)
+          && (ble_conn_state_n_connections() < PERIPHERAL_LINK_COUNT) )
+    {
+        err_code = my_adv_start();
+        APP_ERROR_CHECK(err_code);
+    }
+    else if ( (p_ble_evt->header.evt_id == BLE_GAP_EVT_DISCONNECTED)
+              && (m_advertising == true) )
+    {
+        err_code = my_adv_reconnect();
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+
 /**@brief Function for dispatching a BLE stack event to all modules with a BLE stack event handler.
  *
  * @details This function is called from the BLE Stack event interrupt handler after a BLE stack
@@ -582,13 +689,22 @@ static void on_ble_evt(ble_evt_t * p_ble_evt)
  */
 static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
 {
+    MY_STATS_HANDLER_ENTER();
     /** The Connection state module has to be fed BLE events in order to function correctly
      * Remember to call ble_conn_state_on_ble_evt before calling any ble_conns_state_* functions. */
     ble_conn_state_on_ble_evt(p_ble_evt);
+    MY_TRACE_BLE_EVT(p_ble_evt->header.evt_id, p_ble_evt->evt.gap_evt.conn_handle);
+    MY_STATS_INC(STATS_COUNTER_BLE_EVENTS);
+    /// RSSI reports are counted as separate feature
+    MY_ENERGY_WAKEUP((p_ble_evt->header.evt_id == BLE_GAP_EVT_RSSI_CHANGED) ?
+                     ENERGY_FEATURE_RSSI : ENERGY_FEATURE_BLE);
     pm_on_ble_evt(p_ble_evt);
+    /// peer of lost link is known before advertising is restarted
+    my_bond_on_ble_evt(p_ble_evt);
     ble_conn_params_on_ble_evt(p_ble_evt);          
     on_ble_evt(p_ble_evt);
     ble_advertising_on_ble_evt(p_ble_evt);
+    advertising_links_update(p_ble_evt);
 
     /// Custom handlers:
     
@@ -598,8 +714,14 @@ static void ble_evt_dispatch(ble_evt_t * p_ble_evt)
     sq_on_ble_evt(p_ble_evt);
     /// handler of gpio events
     my_gpio_on_ble_evt(p_ble_evt);
+    /// storage runs GC without connections
+    my_storage_on_ble_evt(p_ble_evt);
+    /// TX power follows RSSI of links
+    my_link_on_ble_evt(p_ble_evt);
     
     //tps_on_ble_evt(p_ble_evt);
+    MY_TRACE_EXIT(TRACE_POINT_BLE_DISPATCH);
+    MY_STATS_HANDLER_EXIT(STATS_HANDLER_BLE_EVT);
 }
 
 
@@ -702,46 +824,9 @@ static void peer_manager_init(bool erase_bonds)
 
     err_code = pm_register(pm_evt_handler);
     APP_ERROR_CHECK(err_code);
-}
-
-
-/**@brief Function for handling events from the BSP module.
- *
- * @param[in]   event   Event generated when button is pressed.
- */
-static void bsp_event_handler(bsp_event_t event)
-{
-    uint32_t err_code;
-
-    switch (event)
-    {
-        case BSP_EVENT_SLEEP:
-            sleep_mode_enter();
-            break; // BSP_EVENT_SLEEP
 
-        case BSP_EVENT_DISCONNECT:
-            err_code = sd_ble_gap_disconnect(m_conn_handle,
-                                             BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
-            if (err_code != NRF_ERROR_INVALID_STATE)
-            {
-                APP_ERROR_CHECK(err_code);
-            }
-            break; // BSP_EVENT_DISCONNECT
-
-        case BSP_EVENT_WHITELIST_OFF:
-            if (m_conn_handle == BLE_CONN_HANDLE_INVALID)
-            {
-                err_code = ble_advertising_restart_without_whitelist();
-                if (err_code != NRF_ERROR_INVALID_STATE)
-                {
-                    APP_ERROR_CHECK(err_code);
-                }
-            }
-            break; // BSP_EVENT_KEY_0
-
-        default:
-            break;
-    }
+    err_code = my_bond_init();
+    APP_ERROR_CHECK(err_code);
 }
 
 
@@ -753,22 +838,26 @@ static void advertising_init(void)
     ble_advdata_t          advdata;
     ble_adv_modes_config_t options;
 
-    // Build advertising data struct to pass into @ref ble_advertising_init.
+    /// ble_advertising needs data, it is replaced by encoded packets of my_advdata_init()
     memset(&advdata, 0, sizeof(advdata));
-
-    advdata.name_type               = BLE_ADVDATA_FULL_NAME;
-    advdata.include_appearance      = true;
-    advdata.flags                   = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
-    advdata.uuids_complete.uuid_cnt = sizeof(m_adv_uuids) / sizeof(m_adv_uuids[0]);
-    advdata.uuids_complete.p_uuids  = m_adv_uuids;
+    advdata.flags = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
 
     memset(&options, 0, sizeof(options));
-    options.ble_adv_fast_enabled  = true;
-    options.ble_adv_fast_interval = APP_ADV_INTERVAL;
-    options.ble_adv_fast_timeout  = APP_ADV_TIMEOUT_IN_SECONDS;
+    /// restart after disconnection is done by advertising_links_update()
+    options.ble_adv_on_disconnect_disabled = true;
+    /// intervals and durations of modes are set by advertising schedule
+    my_adv_options_init(&options);
 
     err_code = ble_advertising_init(&advdata, NULL, &options, on_adv_evt, NULL);
     APP_ERROR_CHECK(err_code);
+
+    /// UUIDs of services and name are in scan response
+    err_code = my_advdata_init();
+    APP_ERROR_CHECK(err_code);
+
+    /// sensor values are patched to manufacturer specific data
+    err_code = my_broadcast_init();
+    APP_ERROR_CHECK(err_code);
 }
 
 /**@brief Function for the Power manager.
@@ -785,7 +874,7 @@ static void power_manage(void)
  */
 static void advertising_start(void)
 {
-    uint32_t err_code = ble_advertising_start(BLE_ADV_MODE_FAST);
+    uint32_t err_code = my_adv_start();
 
     APP_ERROR_CHECK(err_code);
 }
@@ -799,36 +888,69 @@ static void advertising_start(void)
 int main(void)
 {
     uint32_t err_code;
-    bool     erase_bonds;
+    bool     erase_bonds = false;
+
+    /// time of every init phase is stored by my_boot_mark()
+    my_boot_start();
+    /// trace of previous run is kept before first record of this boot
+    my_trace_init(my_boot_record_get()->reset_reason);
 
     // Initialize.
     err_code = NRF_LOG_INIT(NULL);
     APP_ERROR_CHECK(err_code);
+    my_boot_mark(BOOT_PHASE_LOG);
 
+    /// only init needed for advertising is done before its start,
+    /// other init is done by deferred_init() after first advertising event
     timers_init();
-    adc_configure();
+    /// timebase is the first, statistics and stamps of samples use it
+    err_code = my_time_init();
+    APP_ERROR_CHECK(err_code);
+    my_energy_init();
+    my_log_init();
+    err_code = my_stats_init();
+    APP_ERROR_CHECK(err_code);
+    err_code = my_boot_init(deferred_init);
+    APP_ERROR_CHECK(err_code);
+    my_boot_mark(BOOT_PHASE_TIMERS);
     my_gpio_init();
+    my_boot_mark(BOOT_PHASE_GPIO);
+    err_code = my_input_init();
+    APP_ERROR_CHECK(err_code);
+    my_boot_mark(BOOT_PHASE_INPUT);
     ble_stack_init();
+    my_boot_mark(BOOT_PHASE_STACK);
+    /// register in FDS before peer manager, it initializes FDS too
+    err_code = my_storage_init(storage_restore_handler);
+    APP_ERROR_CHECK(err_code);
+    my_boot_mark(BOOT_PHASE_STORAGE);
     peer_manager_init(erase_bonds);
     if (erase_bonds == true)
     {
         NRF_LOG_INFO("Bonds erased!\r\n");
     }
+    my_boot_mark(BOOT_PHASE_PEER_MANAGER);
     gap_params_init();
+    my_boot_mark(BOOT_PHASE_GAP);
     advertising_init();
+    my_boot_mark(BOOT_PHASE_ADVERTISING);
     services_init();
+    my_boot_mark(BOOT_PHASE_SERVICES);
     conn_params_init();
+    my_boot_mark(BOOT_PHASE_CONN_PARAMS);
 
     // Start execution.
-    NRF_LOG_INFO("Application started\r\n");
-    application_timers_start();
-    err_code = ble_advertising_start(BLE_ADV_MODE_FAST);
+    err_code = my_adv_start();
+    APP_ERROR_CHECK(err_code);
+    err_code = my_boot_advertising_started(my_adv_interval_get());
     APP_ERROR_CHECK(err_code);
+    NRF_LOG_INFO("Application started\r\n");
 
     // Enter main loop.
     for (;;)
     {
-        if (NRF_LOG_PROCESS() == false)
+        /// binary log is sent after text log
+        if ((NRF_LOG_PROCESS() == false) && (my_log_process() == false))
         {
             power_manage();
         }
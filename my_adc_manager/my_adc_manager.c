@@ -12,6 +12,13 @@
 #include "custom_board.h"
 #include "sq_service_handler.h"
 #include "bas_service_handler.h"
+#include "my_energy_manager.h"
+#include "my_log_manager.h"
+#include "my_stats_manager.h"
+#include "my_trace_manager.h"
+#include "my_broadcast_manager.h"
+#include "my_radio_manager.h"
+#include "my_storage_manager.h"
 
 #define NRF_LOG_MODULE_NAME "ADC"
 #include "nrf_log.h"
@@ -38,7 +45,7 @@ Source: Data sheet of 'SURFACE MOUNT SCHOTTKY BARRIER DIODE ARRAY' available at
         ((((ADC_VALUE) * ADC_REF_VOLTAGE_IN_MILLIVOLTS) / ADC_RES_10BIT) * ADC_PRE_SCALING_COMPENSATION)
 
 
-#define ADC_MEAS_INTERVAL   APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)       /**< ADC measurement interval (ticks). This value corresponds to 1000 ms. */
+#define ADC_MEAS_INTERVAL   APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)       /**< Default ADC measurement interval (ticks). This value corresponds to 1000 ms. */
 
 
 /* ==================================================================== */
@@ -47,6 +54,16 @@ Source: Data sheet of 'SURFACE MOUNT SCHOTTKY BARRIER DIODE ARRAY' available at
 
 APP_TIMER_DEF(m_adc_timer_id);     /**< ADC measurement timer. */
 
+/// Interval needed by every consumer (ticks), interval of sq-service is configured
+static uint32_t m_consumer_interval[ADC_CONSUMER_COUNT] = {
+    BATTERY_LEVEL_MEAS_INTERVAL, ADC_MEAS_INTERVAL, BROADCAST_MEAS_INTERVAL
+};
+static uint8_t  m_adc_consumers       = 0;         /**< Bits of active consumers */
+static uint32_t m_adc_timer_interval  = 0;         /**< Interval of running timer (ticks), 0 if timer is stopped */
+static bool     m_adc_ready           = false;     /**< SAADC is calibrated and has buffers */
+/// Sample of timer waits for radio notification, it is written only at priority of app_timer
+static volatile bool m_adc_sample_pending = false;
+
 /// Buffers for store adc values, two neds to make continious sampling if neded
 nrf_saadc_value_t adc_buf_one[USED_ADC_CHANNELS] = {0x00};
 nrf_saadc_value_t adc_buf_two[USED_ADC_CHANNELS] = {0x00};
@@ -57,6 +74,52 @@ nrf_saadc_value_t adc_buf_two[USED_ADC_CHANNELS] = {0x00};
 
 static void adc_meas_timeout_handler(void * p_context);
 static void saadc_event_handler(nrf_drv_saadc_evt_t const * p_event);
+static uint32_t adc_interval_get(void);
+static uint32_t adc_timer_update(void);
+
+/**@brief The shortest interval of active consumers, 0 without consumers
+ */
+static uint32_t adc_interval_get(void)
+{
+    uint32_t interval = 0;
+    
+    for (uint8_t i = 0; i < ADC_CONSUMER_COUNT; i++) {
+        if ((m_adc_consumers & (1U << i)) && ((interval == 0) || (m_consumer_interval[i] < interval)))
+            interval = m_consumer_interval[i];
+    }
+    return interval;
+}
+
+/**@brief Timer is started, restarted or stopped by needs of consumers.
+ *        Started timer takes the first sample at once, so new consumer
+ *        doesn't wait for the whole interval.
+ */
+static uint32_t adc_timer_update(void)
+{
+    uint32_t err_code;
+    uint32_t interval = m_adc_ready ? adc_interval_get() : 0;
+    bool     stopped  = (m_adc_timer_interval == 0);
+    
+    if (interval == m_adc_timer_interval)
+        return NRF_SUCCESS;
+    
+    if (stopped == false) {
+        err_code = app_timer_stop(m_adc_timer_id);
+        if (err_code != NRF_SUCCESS)
+            return err_code;
+    }
+    
+    m_adc_timer_interval = interval;
+    NRF_LOG_INFO("adc timer = %d ticks\r\n", interval);
+    if (interval == 0)
+        return NRF_SUCCESS;
+    
+    err_code = app_timer_start(m_adc_timer_id, interval, NULL);
+    if ((err_code != NRF_SUCCESS) || (stopped == false))
+        return err_code;
+    
+    return nrf_drv_saadc_sample();
+}
 
 /**@brief Function for handling the Battery measurement timer timeout.
  *
@@ -68,12 +131,22 @@ static void saadc_event_handler(nrf_drv_saadc_evt_t const * p_event);
  */
 static void adc_meas_timeout_handler(void * p_context)
 {
-    NRF_LOG_INFO("adc_meas_timeout_handler\r\n");
+    MY_STATS_HANDLER_ENTER();
+    MY_TRACE_ENTER(TRACE_POINT_ADC_TIMER);
+    MY_LOG("adc_meas_timeout_handler");
     
     UNUSED_PARAMETER(p_context);
-    uint32_t err_code;
-    err_code = nrf_drv_saadc_sample();
-    APP_ERROR_CHECK(err_code);
+    MY_ENERGY_WAKEUP(ENERGY_FEATURE_ADC);
+    /// with links sample is taken just before connection event
+    if (my_radio_sync_active()) {
+        m_adc_sample_pending = true;
+    } else {
+        uint32_t err_code;
+        err_code = nrf_drv_saadc_sample();
+        APP_ERROR_CHECK(err_code);
+    }
+    MY_TRACE_EXIT(TRACE_POINT_ADC_TIMER);
+    MY_STATS_HANDLER_EXIT(STATS_HANDLER_ADC_TIMER);
 }
 
 /**@brief Function for handling the ADC interrupt.
@@ -83,13 +156,19 @@ static void adc_meas_timeout_handler(void * p_context)
  */
 static void saadc_event_handler(nrf_drv_saadc_evt_t const * p_event) {
     
+    MY_STATS_HANDLER_ENTER();
+    MY_TRACE_ENTER(TRACE_POINT_SAADC);
+    
     if (p_event->type == NRF_DRV_SAADC_EVT_DONE)
     {       
+        MY_STATS_INC(STATS_COUNTER_SAADC_CONVERSIONS);
         nrf_saadc_value_t adc_result, adc_result2;
         uint16_t          batt_lvl_in_milli_volts, adc_lvl_in_milli_volts;
         uint8_t           percentage_batt_lvl;
         uint32_t          err_code;
 
+        MY_ENERGY_SAADC_CONVERSION();
+
         adc_result = p_event->data.done.p_buffer[0];
 
         err_code = nrf_drv_saadc_buffer_convert(p_event->data.done.p_buffer, USED_ADC_CHANNELS);
@@ -116,10 +195,12 @@ static void saadc_event_handler(nrf_drv_saadc_evt_t const * p_event) {
         adc_lvl_in_milli_volts = ADC_RESULT_IN_MILLI_VOLTS(adc_result2) +
                                   DIODE_FWD_VOLT_DROP_MILLIVOLTS;
         
-        NRF_LOG_INFO("batt_lvl_in_milli_volts = %d\r\n", batt_lvl_in_milli_volts);
-        NRF_LOG_INFO("adc_lvl_in_milli_volts = %d\r\n", adc_lvl_in_milli_volts);
+        MY_LOG("batt_lvl_in_milli_volts = %d, adc_lvl_in_milli_volts = %d",
+               batt_lvl_in_milli_volts, adc_lvl_in_milli_volts);
+        MY_TRACE_VALUE(TRACE_POINT_ADC_MV, adc_lvl_in_milli_volts);
         
         err_code = sq_service_update_adc_characteristic(adc_lvl_in_milli_volts);
+        my_broadcast_adc_set(adc_lvl_in_milli_volts, percentage_batt_lvl);
         //if (
         //    (err_code != NRF_SUCCESS)
         //    &&
@@ -134,6 +215,27 @@ static void saadc_event_handler(nrf_drv_saadc_evt_t const * p_event) {
         //}
         
     }
+    else if (p_event->type == NRF_DRV_SAADC_EVT_CALIBRATEDONE)
+    {
+        uint32_t err_code;
+        
+        MY_LOG("saadc calibration finished");
+        
+        /// buffers can be set only to idle SAADC, so after calibration
+        err_code = nrf_drv_saadc_buffer_convert(&adc_buf_one[0], USED_ADC_CHANNELS);
+        APP_ERROR_CHECK(err_code);
+
+        err_code = nrf_drv_saadc_buffer_convert(&adc_buf_two[0], USED_ADC_CHANNELS);
+        APP_ERROR_CHECK(err_code);
+        
+        /// measurements are started when SAADC is ready, if somebody needs them
+        m_adc_ready = true;
+        err_code = adc_timer_update();
+        APP_ERROR_CHECK(err_code);
+    }
+    
+    MY_TRACE_EXIT(TRACE_POINT_SAADC);
+    MY_STATS_HANDLER_EXIT(STATS_HANDLER_SAADC);
 }
 
 /* ==================================================================== */
@@ -154,18 +256,71 @@ uint32_t my_adc_timer_init(void)
     return err_code;
 }
 
-/** @brief Run ADC timer 
-  *
+/** @brief Set ADC measurement interval of sq-service, running timer is restarted with new interval
+    @param[in] interval_ms - new interval in milliseconds
   */
-uint32_t my_adc_timer_start(void)
+uint32_t my_adc_timer_set_interval(const uint16_t interval_ms)
 {
-    uint32_t err_code;    
-    err_code = app_timer_start(m_adc_timer_id, ADC_MEAS_INTERVAL, NULL);            
-    return err_code;
+    uint32_t interval = APP_TIMER_TICKS(interval_ms, APP_TIMER_PRESCALER);
+    
+    if (interval < APP_TIMER_MIN_TIMEOUT_TICKS)
+        return NRF_ERROR_INVALID_PARAM;
+    
+    m_consumer_interval[ADC_CONSUMER_SQS] = interval;
+    NRF_LOG_INFO("adc interval = %d ms\r\n", interval_ms);
+    
+    return adc_timer_update();
+}
+
+/** @brief Interval written by central: it is applied and stored in configuration,
+           flash is written after delay of storage
+    @param[in] interval_ms - new interval in milliseconds
+    @return NRF_ERROR_INVALID_PARAM if interval is shorter than timer allows
+  */
+uint32_t my_adc_interval_store(const uint16_t interval_ms)
+{
+    uint32_t err_code = my_adc_timer_set_interval(interval_ms);
+    
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+    
+    my_config_t config = *my_storage_config_get();
+    config.adc_interval_ms = interval_ms;
+    my_storage_config_save(&config);
+    
+    return NRF_SUCCESS;
+}
+
+/** @brief Register or release consumer of measurements, timer runs only while
+           there are consumers, with the shortest interval of them
+    @param[in] consumer - consumer of measurements
+    @param[in] active - true if consumer needs measurements
+  */
+uint32_t my_adc_consumer_set(adc_consumer_t consumer, bool active)
+{
+    if (active)
+        m_adc_consumers |= (uint8_t)(1U << consumer);
+    else
+        m_adc_consumers &= (uint8_t)~(1U << consumer);
+    
+    return adc_timer_update();
+}
+
+/** @brief Radio event follows, pending sample is taken and notified in it
+  */
+void my_adc_on_radio_active(void)
+{
+    if (m_adc_sample_pending == false)
+        return;
+    
+    m_adc_sample_pending = false;
+    uint32_t err_code = nrf_drv_saadc_sample();
+    APP_ERROR_CHECK(err_code);
 }
 
 /**
-    @brief Function for configuring ADC
+    @brief Function for configuring ADC. Offset calibration is started,
+           measurement timer is started after end of calibration.
  */
 void adc_configure(void) {
        
@@ -180,10 +335,7 @@ void adc_configure(void) {
     nrf_saadc_channel_config_t config2 = NRF_DRV_SAADC_DEFAULT_CHANNEL_CONFIG_SE(ADC_INPUT_CHANNEL_NUM);
     err_code = nrf_drv_saadc_channel_init(1, &config2);
     APP_ERROR_CHECK(err_code);
-        
-    err_code = nrf_drv_saadc_buffer_convert(&adc_buf_one[0], USED_ADC_CHANNELS);
-    APP_ERROR_CHECK(err_code);
-
-    err_code = nrf_drv_saadc_buffer_convert(&adc_buf_two[0], USED_ADC_CHANNELS);
+    
+    err_code = nrf_drv_saadc_calibrate_offset();
     APP_ERROR_CHECK(err_code);
 }
@@ -2,6 +2,9 @@
     @brief Module for manage of SAADC in nrf52. 
            It uses timer for checking all adc channels after timeout.
            In simple case there is only one channel for battery measurment service.           
+           Timer runs only while there are consumers of measurements.
+           With links sample of timer is taken before connection event,
+           see my_radio_manager.h.
     
 */
 
@@ -9,12 +12,29 @@
 #ifndef __MY_ADC_MANAGER__
 #define __MY_ADC_MANAGER__
 
+#include <stdbool.h>
 #include "app_timer.h"
 
 
+/**
+    @brief Consumers of measurements, every one needs own interval
+*/
+typedef enum {
+    ADC_CONSUMER_BAS = 0,       /**< battery level notification of BAS */
+    ADC_CONSUMER_SQS,           /**< ADC value notification of sq-service, interval is configured */
+    ADC_CONSUMER_BROADCAST,     /**< sensor values in advertising */
+    ADC_CONSUMER_COUNT
+} adc_consumer_t;
+
 uint32_t my_adc_timer_init(void);
 
-uint32_t my_adc_timer_start(void);
+uint32_t my_adc_timer_set_interval(const uint16_t interval_ms);
+
+uint32_t my_adc_interval_store(const uint16_t interval_ms);
+
+uint32_t my_adc_consumer_set(adc_consumer_t consumer, bool active);
+
+void my_adc_on_radio_active(void);
 
 void adc_configure(void);
 
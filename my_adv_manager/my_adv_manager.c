@@ -0,0 +1,192 @@
+/**
+    @brief Advertising schedule, see my_adv_manager.h
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include "my_adv_manager.h"
+#include "my_advdata_manager.h"
+#include "my_bond_manager.h"
+#include "my_storage_manager.h"
+#include "app_error.h"
+#include "app_util.h"
+#include "nordic_common.h"
+#include "ble_gap.h"
+
+#define NRF_LOG_MODULE_NAME "ADV"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+static ble_adv_modes_config_t m_options;                    /**< options of application */
+static adv_phase_t            m_phase = ADV_PHASE_BURST;    /**< actual or the last phase */
+static uint16_t               m_interval = BLE_GAP_ADV_INTERVAL_MIN;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static bool adv_phase_used(adv_phase_t phase);
+static uint32_t adv_phase_start(adv_phase_t phase);
+
+/** @brief Reconnection phases are used only with their centrals
+*/
+static bool adv_phase_used(adv_phase_t phase) {
+
+    switch (phase)
+    {
+        case ADV_PHASE_DIRECTED:
+            return (my_bond_lost_peer_get() != PM_PEER_ID_INVALID);
+
+        case ADV_PHASE_WHITELIST:
+            return (my_bond_offline_count() != 0);
+
+        default:
+            return true;
+    }
+}
+
+/** @brief Start the first used phase from given one, interval and duration are from configuration
+*/
+static uint32_t adv_phase_start(adv_phase_t phase) {
+
+    my_config_t const *    p_config = my_storage_config_get();
+    ble_adv_modes_config_t options  = m_options;
+    ble_adv_mode_t         mode     = BLE_ADV_MODE_FAST;
+    uint8_t                flags    = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+    uint32_t               interval;
+    uint32_t               err_code;
+
+    while (adv_phase_used(phase) == false)
+        phase = (adv_phase_t)(phase + 1);
+
+    /// whitelist phase has interval of burst
+    interval   = MSEC_TO_UNITS((uint32_t)p_config->adv_interval_ms[MAX(phase, ADV_PHASE_CONFIG_FIRST) -
+                                                                   ADV_PHASE_CONFIG_FIRST], UNIT_0_625_MS);
+    m_phase    = phase;
+    m_interval = (uint16_t)MAX(BLE_GAP_ADV_INTERVAL_MIN, MIN(interval, BLE_GAP_ADV_INTERVAL_MAX));
+
+    options.ble_adv_directed_enabled      = false;
+    options.ble_adv_directed_slow_enabled = false;
+    options.ble_adv_whitelist_enabled     = false;
+    options.ble_adv_fast_enabled          = true;
+    options.ble_adv_fast_interval         = m_interval;
+    options.ble_adv_slow_enabled          = false;
+
+    switch (phase)
+    {
+        case ADV_PHASE_DIRECTED:
+            /// duration of high duty directed advertising is fixed by stack
+            options.ble_adv_directed_enabled = true;
+            options.ble_adv_fast_enabled     = false;
+            mode = BLE_ADV_MODE_DIRECTED;
+            break;
+
+        case ADV_PHASE_WHITELIST:
+            options.ble_adv_whitelist_enabled = true;
+            options.ble_adv_fast_timeout      = ADV_WHITELIST_TIMEOUT_S;
+            flags = BLE_GAP_ADV_FLAG_BR_EDR_NOT_SUPPORTED;
+            break;
+
+        default:
+            options.ble_adv_fast_timeout = p_config->adv_timeout_s[phase - ADV_PHASE_CONFIG_FIRST];
+            break;
+    }
+    ble_advertising_modes_config_set(&options);
+
+    NRF_LOG_INFO("phase %d, interval %d\r\n", phase, m_interval);
+    err_code = ble_advertising_start(mode);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return my_advdata_flags_set(flags);
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Options for ble_advertising_init(), modes are set by schedule
+    @param[in,out] p_options - options of application, fast mode gets burst phase
+*/
+void my_adv_options_init(ble_adv_modes_config_t * p_options) {
+
+    STATIC_ASSERT(ADV_PHASE_COUNT - ADV_PHASE_CONFIG_FIRST == STORAGE_ADV_PHASES);
+
+    m_options = *p_options;
+
+    p_options->ble_adv_fast_enabled  = true;
+    p_options->ble_adv_fast_interval = BLE_GAP_ADV_INTERVAL_MIN;
+    p_options->ble_adv_fast_timeout  = 0;
+    p_options->ble_adv_slow_enabled  = false;
+}
+
+/**
+    @brief Start schedule, from reconnection phases if there are bonded centrals without link
+*/
+uint32_t my_adv_start(void) {
+    return adv_phase_start(ADV_PHASE_DIRECTED);
+}
+
+/**
+    @brief Start next phase, it is called when ble_advertising reports idle
+    @return false after the last phase, device can sleep
+*/
+bool my_adv_phase_next(void) {
+
+    if (m_phase + 1 >= ADV_PHASE_COUNT)
+        return false;
+
+    uint32_t err_code = adv_phase_start((adv_phase_t)(m_phase + 1));
+    APP_ERROR_CHECK(err_code);
+    return true;
+}
+
+/**
+    @brief User action: running advertising starts again from burst phase
+*/
+uint32_t my_adv_wakeup(void) {
+
+    if (m_phase == ADV_PHASE_BURST)
+        return NRF_SUCCESS;
+
+    /// advertising is stopped by connection or the last phase
+    uint32_t err_code = sd_ble_gap_adv_stop();
+    if (err_code == NRF_ERROR_INVALID_STATE)
+        return NRF_SUCCESS;
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return adv_phase_start(ADV_PHASE_BURST);
+}
+
+/**
+    @brief Link ended while bonded central is lost: running advertising starts
+           again from directed phase, like advertising started after disconnection
+*/
+uint32_t my_adv_reconnect(void) {
+
+    if ((my_bond_lost_peer_get() == PM_PEER_ID_INVALID) || (m_phase == ADV_PHASE_DIRECTED))
+        return NRF_SUCCESS;
+
+    /// advertising for next central is stopped by the last free link
+    uint32_t err_code = sd_ble_gap_adv_stop();
+    if (err_code == NRF_ERROR_INVALID_STATE)
+        return NRF_SUCCESS;
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return adv_phase_start(ADV_PHASE_DIRECTED);
+}
+
+/**
+    @brief Interval of actual phase, in units of 0.625 ms
+*/
+uint16_t my_adv_interval_get(void) {
+    return m_interval;
+}
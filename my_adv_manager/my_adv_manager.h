@@ -0,0 +1,60 @@
+/*!
+    @brief Module of advertising schedule. Advertising goes through phases
+           with longer intervals: burst, fast, slow and beacon. Interval and
+           duration of every phase are stored in configuration
+           (my_storage_manager.h). Beacon lasts until connection, so device
+           stays reachable with low average current; it ends by system off
+           only if its duration is configured.
+
+           Schedule starts by reconnection phases, when there are bonded
+           centrals without link (my_bond_manager.h): high duty directed
+           advertising to central of lost link, then whitelist advertising
+           with burst interval for ADV_WHITELIST_TIMEOUT_S. Phases without
+           their centrals are skipped.
+
+           Every phase is run as one mode of ble_advertising, next phase is
+           started when ble_advertising reports idle. Schedule starts again
+           after disconnection and for next central, change of inputs starts
+           it from burst, so device is discoverable after user action. Lost
+           link of bonded central restarts also running schedule, from
+           directed phase.
+*/
+
+#ifndef __MY_ADV_MANAGER__
+#define __MY_ADV_MANAGER__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ble_advertising.h"
+
+/**
+    @brief Phases of advertising schedule
+*/
+typedef enum {
+    ADV_PHASE_DIRECTED = 0,     /**< high duty directed advertising to central of lost link */
+    ADV_PHASE_WHITELIST,        /**< only bonded centrals can connect */
+    ADV_PHASE_BURST,            /**< the shortest interval after start or user action */
+    ADV_PHASE_FAST,             /**< interval for fast connection */
+    ADV_PHASE_SLOW,             /**< power saving */
+    ADV_PHASE_BEACON,           /**< reachability with current near to sleep */
+    ADV_PHASE_COUNT
+} adv_phase_t;
+
+/// Phases from burst are configured in storage, see my_storage_manager.h
+#define ADV_PHASE_CONFIG_FIRST      ADV_PHASE_BURST
+/// Duration of whitelist phase, it has interval of burst phase
+#define ADV_WHITELIST_TIMEOUT_S     10U
+
+void my_adv_options_init(ble_adv_modes_config_t * p_options);
+
+uint32_t my_adv_start(void);
+
+bool my_adv_phase_next(void);
+
+uint32_t my_adv_wakeup(void);
+
+uint32_t my_adv_reconnect(void);
+
+uint16_t my_adv_interval_get(void);
+
+#endif
@@ -0,0 +1,154 @@
+/**
+    @brief Encoded advertising data, see my_advdata_manager.h
+
+    Layouts are structures of bytes without padding, every AD structure is
+    length, type and data. Buffers are written only in init and by
+    my_advdata_manuf_update(), which is called by timer handler of broadcast,
+    and by my_advdata_flags_set() of advertising schedule at the same priority.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <string.h>
+#include "my_advdata_manager.h"
+#include "my_broadcast_manager.h"
+#include "sq_service.h"
+#include "ble.h"
+#include "ble_gap.h"
+#include "ble_srv_common.h"
+#include "app_util.h"
+#include "nordic_common.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define ADVDATA_UUID16_COUNT    2U
+#define ADVDATA_NAME_LEN        (sizeof(DEVICE_NAME) - 1)
+/// Length byte of AD structure counts type and data
+#define ADVDATA_AD_LEN(FIELD)   ((uint8_t)(sizeof(FIELD) + 1))
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief Layout of advertising packet
+*/
+typedef struct {
+    uint8_t flags_len;
+    uint8_t flags_type;
+    uint8_t flags;
+    uint8_t appearance_len;
+    uint8_t appearance_type;
+    uint8_t appearance[2];
+    uint8_t uuid16_len;
+    uint8_t uuid16_type;
+    uint8_t uuid16[2 * ADVDATA_UUID16_COUNT];
+#ifdef ADV_BROADCAST
+    uint8_t manuf_len;
+    uint8_t manuf_type;
+    uint8_t manuf[2 + BROADCAST_PAYLOAD_LEN];           /**< company identifier and payload */
+#endif
+} advdata_adv_t;
+
+/** @brief Layout of scan response packet
+*/
+typedef struct {
+    uint8_t uuid128_len;
+    uint8_t uuid128_type;
+    uint8_t uuid128[16];
+    uint8_t name_len;
+    uint8_t name_type;
+    uint8_t name[ADVDATA_NAME_LEN];
+} advdata_sr_t;
+
+STATIC_ASSERT(sizeof(advdata_adv_t) <= BLE_GAP_ADV_MAX_SIZE);
+STATIC_ASSERT(sizeof(advdata_sr_t) <= BLE_GAP_ADV_MAX_SIZE);
+
+static advdata_adv_t m_adv;
+static advdata_sr_t  m_sr;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static uint32_t advdata_set(void);
+
+/** @brief Encoded packets to SoftDevice, it copies them
+*/
+static uint32_t advdata_set(void) {
+    return sd_ble_gap_adv_data_set((uint8_t const *)&m_adv, sizeof(m_adv),
+                                   (uint8_t const *)&m_sr, sizeof(m_sr));
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Encode packets and set them, after ble_advertising_init(), which sets its own data
+*/
+uint32_t my_advdata_init(void) {
+
+    ble_uuid128_t sq_uuid = { .uuid128 = BLE_BASE_UUID_SQ_SERVICE };
+
+    m_adv.flags_len       = ADVDATA_AD_LEN(m_adv.flags);
+    m_adv.flags_type      = BLE_GAP_AD_TYPE_FLAGS;
+    m_adv.flags           = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+
+    m_adv.appearance_len  = ADVDATA_AD_LEN(m_adv.appearance);
+    m_adv.appearance_type = BLE_GAP_AD_TYPE_APPEARANCE;
+    (void)uint16_encode(BLE_APPEARANCE_GENERIC_TAG, m_adv.appearance);
+
+    m_adv.uuid16_len      = ADVDATA_AD_LEN(m_adv.uuid16);
+    m_adv.uuid16_type     = BLE_GAP_AD_TYPE_16BIT_SERVICE_UUID_COMPLETE;
+    (void)uint16_encode(BLE_UUID_BATTERY_SERVICE, &m_adv.uuid16[0]);
+    (void)uint16_encode(BLE_UUID_TX_POWER_SERVICE, &m_adv.uuid16[2]);
+
+#ifdef ADV_BROADCAST
+    m_adv.manuf_len       = ADVDATA_AD_LEN(m_adv.manuf);
+    m_adv.manuf_type      = BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA;
+    memset(m_adv.manuf, 0, sizeof(m_adv.manuf));
+    (void)uint16_encode(BROADCAST_COMPANY_ID, m_adv.manuf);
+#endif
+
+    /// 16-bit UUID of service is bytes 12 and 13 of base
+    (void)uint16_encode(BLE_UUID_SQ_SERVICE, &sq_uuid.uuid128[12]);
+    m_sr.uuid128_len      = ADVDATA_AD_LEN(m_sr.uuid128);
+    m_sr.uuid128_type     = BLE_GAP_AD_TYPE_128BIT_SERVICE_UUID_COMPLETE;
+    memcpy(m_sr.uuid128, sq_uuid.uuid128, sizeof(m_sr.uuid128));
+
+    m_sr.name_len         = ADVDATA_AD_LEN(m_sr.name);
+    m_sr.name_type        = BLE_GAP_AD_TYPE_COMPLETE_LOCAL_NAME;
+    memcpy(m_sr.name, DEVICE_NAME, sizeof(m_sr.name));
+
+    return advdata_set();
+}
+
+/**
+    @brief New payload of manufacturer specific data
+    @param[in] p_payload - BROADCAST_PAYLOAD_LEN bytes, see my_broadcast_manager.h
+*/
+uint32_t my_advdata_manuf_update(uint8_t const * p_payload) {
+
+#ifdef ADV_BROADCAST
+    memcpy(&m_adv.manuf[2], p_payload, BROADCAST_PAYLOAD_LEN);
+    return advdata_set();
+#else
+    UNUSED_PARAMETER(p_payload);
+    return NRF_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+/**
+    @brief Flags of advertising phase, data is set again after start of
+           ble_advertising, which can set its own data on start
+    @param[in] flags - BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE for discovery,
+                       BLE_GAP_ADV_FLAG_BR_EDR_NOT_SUPPORTED for whitelist
+*/
+uint32_t my_advdata_flags_set(uint8_t flags) {
+
+    m_adv.flags = flags;
+    return advdata_set();
+}
@@ -0,0 +1,28 @@
+/*!
+    @brief Module of encoded advertising data. Advertising and scan response
+           packets are encoded once to fixed layouts, their sizes are checked
+           at compile time. Dynamic fields are patched in place, so update of
+           advertising data is copy of field and one SVC call.
+
+           Advertising packet, connection and broadcast:
+               flags, appearance,
+               16-bit UUIDs of battery and TX power services,
+               manufacturer specific data (ADV_BROADCAST)
+
+           Scan response packet, discovery by scanners:
+               128-bit UUID of sq-service, complete name (DEVICE_NAME)
+*/
+
+#ifndef __MY_ADVDATA_MANAGER__
+#define __MY_ADVDATA_MANAGER__
+
+#include <stdint.h>
+#include "custom_board.h"
+
+uint32_t my_advdata_init(void);
+
+uint32_t my_advdata_manuf_update(uint8_t const * p_payload);
+
+uint32_t my_advdata_flags_set(uint8_t flags);
+
+#endif
@@ -0,0 +1,287 @@
+/**
+    @brief Cache of bonded centrals, see my_bond_manager.h
+
+    Peer of every link is set by peer manager event after encryption, so
+    link of central without bond has no peer. Handlers of peer manager and
+    BLE events run at the same priority.
+
+    Identity address of every bond is cached with its peer ID when bond is
+    added, so directed advertising doesn't read FDS, which can be busy by
+    garbage collection. Repeated pairing of central updates its address.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stdbool.h>
+#include "my_bond_manager.h"
+#include "ble_advertising.h"
+#include "ble_hci.h"
+#include "app_error.h"
+#include "nordic_common.h"
+
+#define NRF_LOG_MODULE_NAME "BOND"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+/** @brief Peer of link
+*/
+typedef struct {
+    uint16_t     conn_handle;
+    pm_peer_id_t peer_id;
+} bond_link_t;
+
+/** @brief Cached metadata of bond
+*/
+typedef struct {
+    ble_gap_addr_t addr;                                    /**< identity address */
+    bool           addr_valid;
+} bond_peer_t;
+
+static pm_peer_id_t m_peers[BOND_PEERS_MAX];                /**< bonded peers */
+static bond_peer_t  m_peer_data[BOND_PEERS_MAX];            /**< metadata of m_peers[] */
+static uint32_t     m_peer_count = 0;
+static bond_link_t  m_links[PERIPHERAL_LINK_MAX];           /**< bonded peers of links */
+static pm_peer_id_t m_lost_peer = PM_PEER_ID_INVALID;       /**< peer of lost link, it isn't connected again */
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static int32_t bond_peer_find(pm_peer_id_t peer_id);
+static void bond_peer_add(pm_peer_id_t peer_id);
+static void bond_peer_remove(pm_peer_id_t peer_id);
+static void bond_link_set(uint16_t conn_handle, pm_peer_id_t peer_id);
+static bond_link_t * bond_link_find(uint16_t conn_handle);
+
+/** @return index of peer in cache, -1 if it isn't cached
+*/
+static int32_t bond_peer_find(pm_peer_id_t peer_id) {
+
+    for (uint32_t i = 0; i < m_peer_count; i++) {
+        if (m_peers[i] == peer_id)
+            return (int32_t)i;
+    }
+    return -1;
+}
+
+/** @brief Add new bond to cache or update address of repaired one
+*/
+static void bond_peer_add(pm_peer_id_t peer_id) {
+
+    pm_peer_data_bonding_t bonding;
+    int32_t                index = bond_peer_find(peer_id);
+
+    if (index < 0) {
+        /// peer manager stores more bonds, reconnection is limited by whitelist
+        if (m_peer_count >= BOND_PEERS_MAX)
+            return;
+        index = (int32_t)m_peer_count++;
+        m_peers[index] = peer_id;
+    }
+
+    m_peer_data[index].addr_valid = (pm_peer_data_bonding_load(peer_id, &bonding) == NRF_SUCCESS);
+    if (m_peer_data[index].addr_valid)
+        m_peer_data[index].addr = bonding.peer_ble_id.id_addr_info;
+}
+
+/** @brief Remove deleted bond from cache and links
+*/
+static void bond_peer_remove(pm_peer_id_t peer_id) {
+
+    int32_t index = bond_peer_find(peer_id);
+
+    if (index >= 0) {
+        m_peer_count--;
+        m_peers[index]     = m_peers[m_peer_count];
+        m_peer_data[index] = m_peer_data[m_peer_count];
+    }
+    for (uint32_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        if (m_links[i].peer_id == peer_id)
+            m_links[i].peer_id = PM_PEER_ID_INVALID;
+    }
+    if (m_lost_peer == peer_id)
+        m_lost_peer = PM_PEER_ID_INVALID;
+}
+
+/** @brief Peer of secured link, peer of lost link is reconnected
+*/
+static void bond_link_set(uint16_t conn_handle, pm_peer_id_t peer_id) {
+
+    bond_link_t * p_link = bond_link_find(conn_handle);
+
+    if (p_link == NULL)
+        p_link = bond_link_find(BLE_CONN_HANDLE_INVALID);
+    if (p_link == NULL)
+        return;
+
+    p_link->conn_handle = conn_handle;
+    p_link->peer_id     = peer_id;
+    if (m_lost_peer == peer_id)
+        m_lost_peer = PM_PEER_ID_INVALID;
+}
+
+static bond_link_t * bond_link_find(uint16_t conn_handle) {
+
+    for (uint32_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        if (m_links[i].conn_handle == conn_handle)
+            return &m_links[i];
+    }
+    return NULL;
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Cache bonds, after pm_init()
+*/
+uint32_t my_bond_init(void) {
+
+    pm_peer_id_t peer_id = pm_next_peer_id_get(PM_PEER_ID_INVALID);
+
+    m_peer_count = 0;
+    m_lost_peer  = PM_PEER_ID_INVALID;
+    for (uint32_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        m_links[i].conn_handle = BLE_CONN_HANDLE_INVALID;
+        m_links[i].peer_id     = PM_PEER_ID_INVALID;
+    }
+
+    while (peer_id != PM_PEER_ID_INVALID) {
+        bond_peer_add(peer_id);
+        peer_id = pm_next_peer_id_get(peer_id);
+    }
+
+    NRF_LOG_INFO("%d bonds\r\n", m_peer_count);
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Handler of peer manager events: new bonds, deleted bonds and peers of links
+*/
+void my_bond_on_pm_evt(pm_evt_t const * p_evt) {
+
+    switch (p_evt->evt_id)
+    {
+        case PM_EVT_BONDED_PEER_CONNECTED:
+            bond_link_set(p_evt->conn_handle, p_evt->peer_id);
+            break;
+
+        case PM_EVT_CONN_SEC_SUCCEEDED:
+            /// new bond is stored by peer manager before this event
+            if (p_evt->peer_id != PM_PEER_ID_INVALID) {
+                bond_peer_add(p_evt->peer_id);
+                bond_link_set(p_evt->conn_handle, p_evt->peer_id);
+            }
+            break;
+
+        case PM_EVT_PEER_DATA_UPDATE_SUCCEEDED:
+            /// bonding data can be stored after end of pairing
+            if (bond_peer_find(p_evt->peer_id) >= 0)
+                bond_peer_add(p_evt->peer_id);
+            break;
+
+        case PM_EVT_PEER_DELETE_SUCCEEDED:
+            bond_peer_remove(p_evt->peer_id);
+            break;
+
+        case PM_EVT_PEERS_DELETE_SUCCEEDED:
+            while (m_peer_count != 0)
+                bond_peer_remove(m_peers[0]);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+    @brief Handler of BLE events: bonded peer of lost link, before start of advertising
+*/
+void my_bond_on_ble_evt(ble_evt_t * p_ble_evt) {
+
+    if (p_ble_evt->header.evt_id != BLE_GAP_EVT_DISCONNECTED)
+        return;
+
+    bond_link_t * p_link = bond_link_find(p_ble_evt->evt.gap_evt.conn_handle);
+    if (p_link == NULL)
+        return;
+
+    uint8_t reason = p_ble_evt->evt.gap_evt.params.disconnected.reason;
+
+    /// link closed by central or application doesn't need reconnection
+    if ((p_link->peer_id != PM_PEER_ID_INVALID) &&
+        (reason != BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION) &&
+        (reason != BLE_HCI_LOCAL_HOST_TERMINATED_CONNECTION))
+        m_lost_peer = p_link->peer_id;
+
+    p_link->conn_handle = BLE_CONN_HANDLE_INVALID;
+    p_link->peer_id     = PM_PEER_ID_INVALID;
+}
+
+/**
+    @brief Bonded peer of the last lost link, its address is known
+    @return PM_PEER_ID_INVALID if there isn't such peer or it is connected again
+*/
+pm_peer_id_t my_bond_lost_peer_get(void) {
+
+    int32_t index = bond_peer_find(m_lost_peer);
+
+    if ((index < 0) || (m_peer_data[index].addr_valid == false))
+        return PM_PEER_ID_INVALID;
+    return m_lost_peer;
+}
+
+/**
+    @brief Count of bonded peers without link, they can reconnect
+*/
+uint32_t my_bond_offline_count(void) {
+
+    uint32_t count = m_peer_count;
+
+    for (uint32_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        if ((m_links[i].peer_id != PM_PEER_ID_INVALID) && (count != 0))
+            count--;
+    }
+    return count;
+}
+
+/**
+    @brief Reply to BLE_ADV_EVT_PEER_ADDR_REQUEST: cached identity address of lost peer
+*/
+uint32_t my_bond_peer_addr_reply(void) {
+
+    int32_t index = bond_peer_find(m_lost_peer);
+
+    if ((m_lost_peer == PM_PEER_ID_INVALID) || (index < 0) || (m_peer_data[index].addr_valid == false))
+        return NRF_ERROR_INVALID_STATE;
+
+    return ble_advertising_peer_addr_reply(&m_peer_data[index].addr);
+}
+
+/**
+    @brief Reply to BLE_ADV_EVT_WHITELIST_REQUEST: all cached peers
+*/
+uint32_t my_bond_whitelist_reply(void) {
+
+    ble_gap_addr_t addrs[BOND_PEERS_MAX];
+    ble_gap_irk_t  irks[BOND_PEERS_MAX];
+    uint32_t       addr_count = BOND_PEERS_MAX;
+    uint32_t       irk_count  = BOND_PEERS_MAX;
+    ret_code_t     err_code;
+
+    err_code = pm_whitelist_set(m_peers, m_peer_count);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    err_code = pm_whitelist_get(addrs, &addr_count, irks, &irk_count);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return ble_advertising_whitelist_reply(addrs, addr_count, irks, irk_count);
+}
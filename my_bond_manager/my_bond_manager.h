@@ -0,0 +1,38 @@
+/*!
+    @brief Module of bonded centrals for fast reconnection. Peer IDs of
+           bonds are cached in RAM at start (peer manager loads them from
+           FDS) and are followed by events of peer manager, so advertising
+           doesn't search flash.
+
+           Bonded central, whose link is lost, is reconnected by high duty
+           directed advertising, then all bonded centrals are accepted by
+           whitelist advertising (my_adv_manager.h). Peer of lost link is
+           kept only in RAM, after reset reconnection starts from whitelist.
+*/
+
+#ifndef __MY_BOND_MANAGER__
+#define __MY_BOND_MANAGER__
+
+#include <stdint.h>
+#include "ble.h"
+#include "peer_manager.h"
+#include "custom_board.h"
+
+/// Max count of cached peers, all of them fit whitelist
+#define BOND_PEERS_MAX              BLE_GAP_WHITELIST_ADDR_MAX_COUNT
+
+uint32_t my_bond_init(void);
+
+void my_bond_on_pm_evt(pm_evt_t const * p_evt);
+
+void my_bond_on_ble_evt(ble_evt_t * p_ble_evt);
+
+pm_peer_id_t my_bond_lost_peer_get(void);
+
+uint32_t my_bond_offline_count(void);
+
+uint32_t my_bond_peer_addr_reply(void);
+
+uint32_t my_bond_whitelist_reply(void);
+
+#endif
@@ -0,0 +1,260 @@
+/**
+    @brief This module used to defer not critical init to time after
+    first advertising event and to measure time of every boot phase.
+
+    main() does only init needed for advertising and starts it, then this
+    module starts single-shot timer for one advertising interval. When it
+    expires, first advertising packet is already sent, so deferred handler
+    (ADC configure and calibration, measurement timers) doesn't delay it.
+
+    Phases before start of advertising are measured by DWT cycle counter,
+    it is exact and works before app_timer is started. CPU sleeps while
+    deferred init waits, DWT doesn't count in sleep, so the last phase
+    is measured by RTC1. Record of boot is in retained RAM, after reset
+    record of previous boot is kept, so time of boot which was finished
+    by reset (watchdog, fault) is available too.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stddef.h>
+#include <string.h>
+#include "my_boot_manager.h"
+#include "retained_ram.h"
+#include "sq_service_handler.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_util.h"
+
+#define NRF_LOG_MODULE_NAME "BOOT"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define BOOT_CPU_FREQ_MHZ   64U         /**< DWT cycles in microsecond */
+#define BOOT_RTC_MASK       0x00FFFFFF  /**< RTC1 counter is 24 bit */
+
+/// RTC1 ticks to microseconds
+#define BOOT_TICKS_TO_US(ticks) \
+    ((uint32_t)(((uint64_t)(ticks) * 1000000 * (APP_TIMER_PRESCALER + 1)) / APP_TIMER_CLOCK_FREQ))
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+APP_TIMER_DEF(m_boot_timer_id); /**< timer of deferred init. */
+
+static my_boot_deferred_handler_t m_deferred_handler = NULL;
+
+/** @brief Record of current boot, it isn't cleared by reset
+*/
+static my_boot_record_t m_boot_record RETAINED_RAM;
+
+/** @brief Copy of record of previous boot
+*/
+static my_boot_record_t m_boot_previous;
+
+/** @brief Names of phases for log
+*/
+static const char * const m_phase_names[BOOT_PHASE_COUNT] = {
+    "log", "timers", "gpio", "input", "stack", "storage", "peer_manager",
+    "gap", "advertising", "services", "conn_params", "adv_start", "deferred",
+};
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static uint32_t boot_checksum(my_boot_record_t const * p_record);
+static bool boot_record_is_valid(my_boot_record_t const * p_record);
+static void boot_timer_callback(void * p_context);
+static void boot_report(void);
+
+/** @brief Checksum of record, all fields before checksum
+*/
+static uint32_t boot_checksum(my_boot_record_t const * p_record) {
+
+    uint32_t const * p_word = (uint32_t const *)p_record;
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < offsetof(my_boot_record_t, checksum) / sizeof(uint32_t); i++) {
+        sum = (sum << 1 | sum >> 31) ^ p_word[i];
+    }
+    return ~sum;
+}
+
+/** @brief Check that record in retained RAM isn't random data after power-on
+*/
+static bool boot_record_is_valid(my_boot_record_t const * p_record) {
+    return ((p_record->magic == RETAINED_RAM_MAGIC_BOOT)
+            && (p_record->checksum == boot_checksum(p_record)));
+}
+
+/** @brief Print time of every boot phase
+*/
+static void boot_report(void) {
+
+    NRF_LOG_INFO("boot %d, reset reason 0x%x\r\n", m_boot_record.boot_count, m_boot_record.reset_reason);
+
+    for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+        NRF_LOG_INFO("%s: %d us\r\n", (uint32_t)(uintptr_t)m_phase_names[i],
+                     my_boot_phase_us_get(&m_boot_record, (boot_phase_t)i));
+    }
+
+    if (m_boot_previous.magic == RETAINED_RAM_MAGIC_BOOT) {
+        NRF_LOG_INFO("previous boot: advertising %d us, deferred %d us\r\n",
+                     my_boot_phase_us_get(&m_boot_previous, BOOT_PHASE_ADV_START),
+                     my_boot_phase_us_get(&m_boot_previous, BOOT_PHASE_DEFERRED));
+    }
+}
+
+/** @brief Callback of deferred init timer
+*/
+static void boot_timer_callback(void * p_context) {
+
+    UNUSED_PARAMETER(p_context);
+
+    if (m_deferred_handler != NULL)
+        m_deferred_handler();
+
+    my_boot_mark(BOOT_PHASE_DEFERRED);
+    boot_report();
+
+    uint8_t  diag[BOOT_DIAG_LEN];
+    uint16_t len = my_boot_diag_encode(diag);
+
+    uint32_t err_code = sq_service_update_boot_diag(diag, len);
+    APP_ERROR_CHECK(err_code);
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Start measuring of boot, must be called first in main().
+           Record of previous boot is saved, DWT cycle counter is started from 0.
+*/
+void my_boot_start(void) {
+
+    STATIC_ASSERT(BOOT_DIAG_LEN <= SQS_BOOT_DIAG_MAX_LEN);
+
+    uint32_t boot_count = 1;
+
+    if (boot_record_is_valid(&m_boot_record)) {
+        m_boot_previous = m_boot_record;
+        boot_count      = m_boot_record.boot_count + 1;
+    }
+
+    memset(&m_boot_record, 0, sizeof(m_boot_record));
+    m_boot_record.magic        = RETAINED_RAM_MAGIC_BOOT;
+    m_boot_record.boot_count   = boot_count;
+
+    /// SoftDevice isn't enabled yet - register can be accessed directly
+    m_boot_record.reset_reason = NRF_POWER->RESETREAS;
+    NRF_POWER->RESETREAS       = m_boot_record.reset_reason;   /// cleared by writing 1
+
+    m_boot_record.checksum     = boot_checksum(&m_boot_record);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT       = 0;
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+    @brief Init timer of deferred init, app_timer must be initialized
+    @param[in] deferred_handler - init called after first advertising event
+*/
+uint32_t my_boot_init(my_boot_deferred_handler_t deferred_handler) {
+
+    m_deferred_handler = deferred_handler;
+
+    return app_timer_create(&m_boot_timer_id,
+                            APP_TIMER_MODE_SINGLE_SHOT,
+                            boot_timer_callback);
+}
+
+/**
+    @brief Store time of the end of boot phase
+*/
+void my_boot_mark(boot_phase_t phase) {
+
+    if (phase >= BOOT_PHASE_COUNT)
+        return;
+
+    m_boot_record.cycles[phase] = DWT->CYCCNT;
+    app_timer_cnt_get(&m_boot_record.ticks[phase]);
+    m_boot_record.checksum = boot_checksum(&m_boot_record);
+}
+
+/**
+    @brief Must be called after start of advertising, starts deferred init
+    @param[in] adv_interval - advertising interval in units of 0.625 ms
+*/
+uint32_t my_boot_advertising_started(uint32_t adv_interval) {
+
+    my_boot_mark(BOOT_PHASE_ADV_START);
+
+    /// first advertising event is sent during one interval after start
+    uint32_t timeout = APP_TIMER_TICKS((adv_interval * 5) / 8 + 1, APP_TIMER_PRESCALER);
+    if (timeout < APP_TIMER_MIN_TIMEOUT_TICKS)
+        timeout = APP_TIMER_MIN_TIMEOUT_TICKS;
+
+    return app_timer_start(m_boot_timer_id, timeout, NULL);
+}
+
+/**
+    @brief Time from start of main() to end of phase
+    @return time in microseconds, 0 if phase isn't finished
+*/
+uint32_t my_boot_phase_us_get(my_boot_record_t const * p_record, boot_phase_t phase) {
+
+    if ((phase >= BOOT_PHASE_COUNT) || (p_record->cycles[phase] == 0))
+        return 0;
+
+    if (phase <= BOOT_PHASE_ADV_START)
+        return p_record->cycles[phase] / BOOT_CPU_FREQ_MHZ;
+
+    /// CPU could sleep after start of advertising - RTC1 is used
+    uint32_t ticks = (p_record->ticks[phase] - p_record->ticks[BOOT_PHASE_ADV_START]) & BOOT_RTC_MASK;
+    return my_boot_phase_us_get(p_record, BOOT_PHASE_ADV_START) + BOOT_TICKS_TO_US(ticks);
+}
+
+/**
+    @brief return record of current boot
+*/
+my_boot_record_t const * my_boot_record_get(void) {
+    return &m_boot_record;
+}
+
+/**
+    @brief return record of previous boot, magic is 0 if there is no valid record
+*/
+my_boot_record_t const * my_boot_previous_record_get(void) {
+    return &m_boot_previous;
+}
+
+/**
+    @brief Encode timing of current boot for diagnostic characteristic, little endian:
+           boot count (2 bytes), reset reason (4), count of phases (1),
+           time of end of every phase in microseconds (4 each)
+    @param[out] p_buf - buffer of BOOT_DIAG_LEN bytes
+    @return length of data
+*/
+uint16_t my_boot_diag_encode(uint8_t * p_buf) {
+
+    uint16_t len = 0;
+
+    len += uint16_encode((uint16_t)m_boot_record.boot_count, &p_buf[len]);
+    len += uint32_encode(m_boot_record.reset_reason, &p_buf[len]);
+    p_buf[len++] = BOOT_PHASE_COUNT;
+
+    for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+        len += uint32_encode(my_boot_phase_us_get(&m_boot_record, (boot_phase_t)i), &p_buf[len]);
+    }
+    return len;
+}
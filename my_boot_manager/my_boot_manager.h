@@ -0,0 +1,74 @@
+/*!
+    @brief Module for fast start of application.
+           Only init needed for advertising is done before first advertising,
+           all other init (ADC calibration, measurement timers) is deferred
+           by single-shot timer to time after first advertising event.
+           End of every init phase is stored (DWT cycles and RTC1 ticks) in
+           retained RAM, so timing of previous boot is available after reset.
+           Timing is printed to log and exposed by diagnostic characteristic.
+*/
+
+#ifndef __MY_BOOT_MANAGER__
+#define __MY_BOOT_MANAGER__
+
+#include <stdint.h>
+#include "app_timer.h"
+#include "custom_board.h"
+
+/**
+    @brief Phases of boot, one phase per init call of main(),
+           time is stored at the end of every phase
+*/
+typedef enum {
+    BOOT_PHASE_LOG = 0,         /**< log is initialized */
+    BOOT_PHASE_TIMERS,          /**< app_timer is started, RTC1 counts from 0 */
+    BOOT_PHASE_GPIO,            /**< outputs and LED are configured */
+    BOOT_PHASE_INPUT,           /**< inputs are configured */
+    BOOT_PHASE_STACK,           /**< SoftDevice is enabled, LFCLK is running */
+    BOOT_PHASE_STORAGE,         /**< FDS is initialized */
+    BOOT_PHASE_PEER_MANAGER,    /**< peer manager is initialized */
+    BOOT_PHASE_GAP,             /**< GAP parameters are set */
+    BOOT_PHASE_ADVERTISING,     /**< advertising data is set */
+    BOOT_PHASE_SERVICES,        /**< GATT services are added */
+    BOOT_PHASE_CONN_PARAMS,     /**< connection parameters module is initialized */
+    BOOT_PHASE_ADV_START,       /**< advertising is started */
+    BOOT_PHASE_DEFERRED,        /**< deferred init is finished */
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+/**
+    @brief Timing of one boot, stored in retained RAM
+*/
+typedef struct {
+    uint32_t magic;                         /**< RETAINED_RAM_MAGIC_BOOT if record is complete */
+    uint32_t boot_count;                    /**< count of boots without power loss */
+    uint32_t reset_reason;                  /**< value of RESETREAS register */
+    uint32_t cycles[BOOT_PHASE_COUNT];      /**< DWT cycles from start of main() at end of phase */
+    uint32_t ticks[BOOT_PHASE_COUNT];       /**< RTC1 ticks at end of phase */
+    uint32_t checksum;                      /**< checksum of all previous fields */
+} my_boot_record_t;
+
+/// Length of diagnostic value: boot count, reset reason, count of phases, time of every phase
+#define BOOT_DIAG_LEN       (sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint8_t) \
+                             + BOOT_PHASE_COUNT * sizeof(uint32_t))
+
+/**@brief Handler of deferred init, called after first advertising event. */
+typedef void (*my_boot_deferred_handler_t)(void);
+
+void my_boot_start(void);
+
+uint32_t my_boot_init(my_boot_deferred_handler_t deferred_handler);
+
+void my_boot_mark(boot_phase_t phase);
+
+uint32_t my_boot_advertising_started(uint32_t adv_interval);
+
+uint32_t my_boot_phase_us_get(my_boot_record_t const * p_record, boot_phase_t phase);
+
+my_boot_record_t const * my_boot_record_get(void);
+
+my_boot_record_t const * my_boot_previous_record_get(void);
+
+uint16_t my_boot_diag_encode(uint8_t * p_buf);
+
+#endif
@@ -0,0 +1,193 @@
+/**
+    @brief Broadcast of sensor values in advertising, see my_broadcast_manager.h
+
+    Values are written by handlers of different priorities, payload is
+    encoded and patched to advertising data only by timer handler.
+    The first change starts timer, timer encodes changes collected during
+    BROADCAST_MIN_INTERVAL and runs again while values change.
+
+    ADC is measured for broadcast only while device advertises.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include "my_broadcast_manager.h"
+#include "my_adc_manager.h"
+#include "my_advdata_manager.h"
+#include "app_error.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define BROADCAST_MIN_INTERVAL  APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+#ifdef ADV_BROADCAST
+
+APP_TIMER_DEF(m_broadcast_timer_id);    /**< timer of rate limit */
+
+/** @brief Latest values, they are encoded to payload by timer
+*/
+typedef struct {
+    uint16_t adc_mv;
+    uint8_t  battery_percent;
+    uint8_t  input_reg;
+} broadcast_values_t;
+
+static broadcast_values_t       m_values;
+static volatile bool            m_dirty = false;            /**< values are changed after last encoding */
+static volatile bool            m_timer_running = false;
+static uint8_t                  m_sequence = 0;
+
+static uint8_t                  m_payload[BROADCAST_PAYLOAD_LEN];
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void broadcast_encode(void);
+static void broadcast_changed(void);
+static void broadcast_timer_callback(void * p_context);
+
+/** @brief Encode latest values to payload
+*/
+static void broadcast_encode(void) {
+
+    broadcast_values_t values;
+
+    CRITICAL_REGION_ENTER();
+    values  = m_values;
+    m_dirty = false;
+    CRITICAL_REGION_EXIT();
+
+    m_payload[0] = BROADCAST_VERSION;
+    m_payload[1] = m_sequence++;
+    (void)uint16_encode(values.adc_mv, &m_payload[2]);
+    m_payload[4] = values.battery_percent;
+    m_payload[5] = values.input_reg;
+}
+
+/** @brief Value is changed: timer is started, if it doesn't run
+*/
+static void broadcast_changed(void) {
+
+    bool start;
+
+    CRITICAL_REGION_ENTER();
+    m_dirty = true;
+    start   = (m_timer_running == false);
+    m_timer_running = true;
+    CRITICAL_REGION_EXIT();
+
+    if (start) {
+        uint32_t err_code = app_timer_start(m_broadcast_timer_id, BROADCAST_MIN_INTERVAL, NULL);
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/** @brief Advertising data is updated with changes, timer stops without them
+*/
+static void broadcast_timer_callback(void * p_context) {
+
+    uint32_t err_code;
+
+    UNUSED_PARAMETER(p_context);
+
+    CRITICAL_REGION_ENTER();
+    m_timer_running = m_dirty;
+    CRITICAL_REGION_EXIT();
+
+    if (m_timer_running == false)
+        return;
+
+    broadcast_encode();
+    err_code = my_advdata_manuf_update(m_payload);
+    APP_ERROR_CHECK(err_code);
+
+    err_code = app_timer_start(m_broadcast_timer_id, BROADCAST_MIN_INTERVAL, NULL);
+    APP_ERROR_CHECK(err_code);
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Put initial payload to advertising data, after my_advdata_init(),
+           app_timer must be initialized
+*/
+uint32_t my_broadcast_init(void) {
+
+    uint32_t err_code;
+
+    m_values.adc_mv          = 0;
+    m_values.battery_percent = 0xFF;
+    m_values.input_reg       = 0;
+    broadcast_encode();
+
+    err_code = my_advdata_manuf_update(m_payload);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return app_timer_create(&m_broadcast_timer_id, APP_TIMER_MODE_SINGLE_SHOT, broadcast_timer_callback);
+}
+
+/**
+    @brief State of advertising, ADC is measured for broadcast only while device advertises
+*/
+uint32_t my_broadcast_advertising_set(bool advertising) {
+    return my_adc_consumer_set(ADC_CONSUMER_BROADCAST, advertising);
+}
+
+/**
+    @brief New measurement of ADC
+*/
+void my_broadcast_adc_set(uint16_t adc_mv, uint8_t battery_percent) {
+
+    if ((m_values.adc_mv == adc_mv) && (m_values.battery_percent == battery_percent))
+        return;
+
+    CRITICAL_REGION_ENTER();
+    m_values.adc_mv          = adc_mv;
+    m_values.battery_percent = battery_percent;
+    CRITICAL_REGION_EXIT();
+    broadcast_changed();
+}
+
+/**
+    @brief New value of input register
+*/
+void my_broadcast_input_set(uint8_t input_reg) {
+
+    if (m_values.input_reg == input_reg)
+        return;
+
+    m_values.input_reg = input_reg;
+    broadcast_changed();
+}
+
+#else
+
+uint32_t my_broadcast_init(void) {
+    return NRF_SUCCESS;
+}
+
+uint32_t my_broadcast_advertising_set(bool advertising) {
+    return NRF_SUCCESS;
+}
+
+void my_broadcast_adc_set(uint16_t adc_mv, uint8_t battery_percent) {
+}
+
+void my_broadcast_input_set(uint8_t input_reg) {
+}
+
+#endif
@@ -0,0 +1,40 @@
+/*!
+    @brief Module of connectionless broadcast of sensor values.
+           Latest values are put to manufacturer specific data of advertising,
+           so scanners read them without connection. Payload is patched in
+           encoded advertising data (my_advdata_manager.h) on change, not more
+           often than BROADCAST_MIN_INTERVAL, later changes are sent together.
+
+           Manufacturer specific data (version 1), little-endian:
+               0..1 - company identifier (BROADCAST_COMPANY_ID)
+               2    - version
+               3    - sequence number, it is incremented on every update
+               4..5 - ADC input, mV
+               6    - battery level, %, 0xFF until the first measurement
+               7    - input register
+
+           Broadcast is compiled in when ADV_BROADCAST is defined in
+           custom_board.h, otherwise functions are empty.
+*/
+
+#ifndef __MY_BROADCAST_MANAGER__
+#define __MY_BROADCAST_MANAGER__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "custom_board.h"
+
+#define BROADCAST_VERSION           1U
+/// Company identifier reserved for tests by Bluetooth SIG
+#define BROADCAST_COMPANY_ID        0xFFFF
+#define BROADCAST_PAYLOAD_LEN       6U
+
+uint32_t my_broadcast_init(void);
+
+uint32_t my_broadcast_advertising_set(bool advertising);
+
+void my_broadcast_adc_set(uint16_t adc_mv, uint8_t battery_percent);
+
+void my_broadcast_input_set(uint8_t input_reg);
+
+#endif
@@ -0,0 +1,186 @@
+/**
+    @brief Counters of energy accounting, see my_energy_manager.h
+
+    Radio events are counted from time in state: time is kept in units of
+    1/100 RTC1 tick, so intervals of 0.625 ms (20.48 ticks) and 1.25 ms
+    (40.96 ticks) are exact. Random delay of advertising is not counted.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <string.h>
+#include "my_energy_manager.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+/// Intervals of radio in 1/100 RTC1 ticks
+#define ENERGY_ADV_UNIT_X100    2048U       /**< 0.625 ms */
+#define ENERGY_CONN_UNIT_X100   4096U       /**< 1.25 ms */
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+#ifdef ENERGY_ACCOUNTING
+
+static my_energy_counters_t m_counters;
+
+static uint32_t             m_last_ticks = 0;           /**< RTC1 counter at last record */
+static energy_radio_state_t m_radio_state = ENERGY_RADIO_IDLE;
+static uint32_t             m_radio_interval_x100 = 0;  /**< interval of radio events */
+static uint32_t             m_radio_rest_x100 = 0;      /**< time from last counted radio event */
+static bool                 m_led_on = false;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void energy_time_update(void);
+
+/** @brief Time from last record is added to active states, must be called in critical region
+*/
+static void energy_time_update(void) {
+
+    uint32_t now;
+    uint32_t diff;
+
+    (void)app_timer_cnt_get(&now);
+    (void)app_timer_cnt_diff_compute(now, m_last_ticks, &diff);
+    m_last_ticks = now;
+
+    m_counters.total_ticks += diff;
+
+    if (m_led_on)
+        m_counters.led_on_ticks += diff;
+
+    if ((m_radio_state == ENERGY_RADIO_IDLE) || (m_radio_interval_x100 == 0))
+        return;
+
+    m_radio_rest_x100 += diff * 100U;
+    uint32_t events    = m_radio_rest_x100 / m_radio_interval_x100;
+    m_radio_rest_x100 -= events * m_radio_interval_x100;
+
+    if (m_radio_state == ENERGY_RADIO_ADVERTISING) {
+        m_counters.adv_ticks  += diff;
+        m_counters.adv_events += events;
+    } else {
+        m_counters.conn_ticks  += diff;
+        m_counters.conn_events += events;
+    }
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Start of accounting, app_timer must be initialized
+*/
+void my_energy_init(void) {
+
+    memset(&m_counters, 0, sizeof(m_counters));
+    (void)app_timer_cnt_get(&m_last_ticks);
+}
+
+/**
+    @brief CPU is woken up by timer, interrupt or event of feature
+*/
+void my_energy_wakeup(energy_feature_t feature) {
+
+    CRITICAL_REGION_ENTER();
+    energy_time_update();
+    m_counters.wakeups[feature]++;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+    @brief Notification of feature is accepted by stack, it is sent in connection event
+*/
+void my_energy_tx_packet(energy_feature_t feature) {
+
+    CRITICAL_REGION_ENTER();
+    m_counters.tx_packets[feature]++;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+    @brief SAADC finished conversion, its interrupt is wakeup of ADC feature
+*/
+void my_energy_saadc_conversion(void) {
+
+    CRITICAL_REGION_ENTER();
+    energy_time_update();
+    m_counters.saadc_conversions++;
+    m_counters.wakeups[ENERGY_FEATURE_ADC]++;
+    CRITICAL_REGION_EXIT();
+}
+
+void my_energy_flash_write(uint32_t words) {
+
+    CRITICAL_REGION_ENTER();
+    m_counters.flash_words += words;
+    CRITICAL_REGION_EXIT();
+}
+
+void my_energy_flash_gc(void) {
+
+    CRITICAL_REGION_ENTER();
+    m_counters.flash_gc_runs++;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+    @brief New state of radio
+    @param[in] interval - advertising interval in 0.625 ms units or
+                          connection interval in 1.25 ms units
+*/
+void my_energy_radio(energy_radio_state_t state, uint16_t interval) {
+
+    CRITICAL_REGION_ENTER();
+    energy_time_update();
+    if (state != m_radio_state)
+        m_radio_rest_x100 = 0;
+    m_radio_state = state;
+    if (state == ENERGY_RADIO_ADVERTISING)
+        m_radio_interval_x100 = (uint32_t)interval * ENERGY_ADV_UNIT_X100;
+    else if (state == ENERGY_RADIO_CONNECTED)
+        m_radio_interval_x100 = (uint32_t)interval * ENERGY_CONN_UNIT_X100;
+    else
+        m_radio_interval_x100 = 0;
+    CRITICAL_REGION_EXIT();
+}
+
+void my_energy_led(bool on) {
+
+    CRITICAL_REGION_ENTER();
+    energy_time_update();
+    m_led_on = on;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+    @brief Snapshot of counters, time is counted to this moment
+*/
+void my_energy_counters_get(my_energy_counters_t * p_counters) {
+
+    CRITICAL_REGION_ENTER();
+    energy_time_update();
+    *p_counters = m_counters;
+    CRITICAL_REGION_EXIT();
+}
+
+#else
+
+void my_energy_init(void) {
+}
+
+void my_energy_counters_get(my_energy_counters_t * p_counters) {
+    memset(p_counters, 0, sizeof(*p_counters));
+}
+
+#endif
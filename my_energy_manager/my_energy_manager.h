@@ -0,0 +1,96 @@
+/*!
+    @brief Module for energy accounting. Every feature counts its CPU wakeups
+           and queued notifications, radio activity is counted as advertising
+           and connection events from time in radio state and its interval,
+           SAADC conversions, flash writes and time of LED are counted too.
+           Counters are turned to average current by host estimator
+           (host/energy) with datasheet constants.
+
+           Counting is compiled in when ENERGY_ACCOUNTING is defined in
+           custom_board.h, otherwise macros are empty.
+
+           Time is taken from RTC1 at every record, 24-bit counter wraps
+           after 512 s, so some record must be done in this time (ADC timer).
+*/
+
+#ifndef __MY_ENERGY_MANAGER__
+#define __MY_ENERGY_MANAGER__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "custom_board.h"
+
+/**
+    @brief Features, which cost is estimated
+*/
+typedef enum {
+    ENERGY_FEATURE_BLE = 0,     /**< events of stack not related to other features */
+    ENERGY_FEATURE_ADC,         /**< ADC timer, SAADC, battery and ADC notifications */
+    ENERGY_FEATURE_LED,         /**< LED blinking */
+    ENERGY_FEATURE_INPUT,       /**< button debouncing, input notifications */
+    ENERGY_FEATURE_RSSI,        /**< RSSI reporting */
+    ENERGY_FEATURE_STORAGE,     /**< delayed write of configuration */
+    ENERGY_FEATURE_COUNT
+} energy_feature_t;
+
+/**
+    @brief State of radio
+*/
+typedef enum {
+    ENERGY_RADIO_IDLE = 0,
+    ENERGY_RADIO_ADVERTISING,   /**< interval in 0.625 ms units */
+    ENERGY_RADIO_CONNECTED,     /**< interval in 1.25 ms units */
+} energy_radio_state_t;
+
+/**
+    @brief All counters, layout is stable - new fields are added to the end
+*/
+typedef struct {
+    uint32_t wakeups[ENERGY_FEATURE_COUNT];     /**< timer callbacks, interrupts and BLE events */
+    uint32_t tx_packets[ENERGY_FEATURE_COUNT];  /**< notifications accepted by stack */
+    uint32_t saadc_conversions;
+    uint32_t flash_words;                       /**< words written to flash, with headers of records */
+    uint32_t flash_gc_runs;                     /**< every GC erases at least one page */
+    uint32_t adv_events;
+    uint32_t conn_events;                       /**< events of interval, slave latency is not counted */
+    uint32_t adv_ticks;                         /**< RTC1 ticks in states */
+    uint32_t conn_ticks;
+    uint32_t led_on_ticks;
+    uint32_t total_ticks;
+} my_energy_counters_t;
+
+#ifdef ENERGY_ACCOUNTING
+
+#define MY_ENERGY_WAKEUP(FEATURE)               my_energy_wakeup(FEATURE)
+#define MY_ENERGY_TX_PACKET(FEATURE)            my_energy_tx_packet(FEATURE)
+#define MY_ENERGY_SAADC_CONVERSION()            my_energy_saadc_conversion()
+#define MY_ENERGY_FLASH_WRITE(WORDS)            my_energy_flash_write(WORDS)
+#define MY_ENERGY_FLASH_GC()                    my_energy_flash_gc()
+#define MY_ENERGY_RADIO(STATE, INTERVAL)        my_energy_radio(STATE, INTERVAL)
+#define MY_ENERGY_LED(ON)                       my_energy_led(ON)
+
+#else
+
+#define MY_ENERGY_WAKEUP(FEATURE)               do { } while (0)
+#define MY_ENERGY_TX_PACKET(FEATURE)            do { } while (0)
+#define MY_ENERGY_SAADC_CONVERSION()            do { } while (0)
+#define MY_ENERGY_FLASH_WRITE(WORDS)            do { } while (0)
+#define MY_ENERGY_FLASH_GC()                    do { } while (0)
+#define MY_ENERGY_RADIO(STATE, INTERVAL)        do { } while (0)
+#define MY_ENERGY_LED(ON)                       do { } while (0)
+
+#endif
+
+void my_energy_init(void);
+
+void my_energy_wakeup(energy_feature_t feature);
+void my_energy_tx_packet(energy_feature_t feature);
+void my_energy_saadc_conversion(void);
+void my_energy_flash_write(uint32_t words);
+void my_energy_flash_gc(void);
+void my_energy_radio(energy_radio_state_t state, uint16_t interval);
+void my_energy_led(bool on);
+
+void my_energy_counters_get(my_energy_counters_t * p_counters);
+
+#endif
@@ -1,5 +1,6 @@
 /**
-    @brief This module used to manage all gpios, led and button
+    @brief This module used to manage all output gpios and led.
+    Inputs (button) are managed by my_input_manager.
   
 */
 
@@ -7,10 +8,12 @@
 /* ========================== include files =========================== */
 /* ==================================================================== */
 #include "my_gpio_manager.h"
-#include "nrf_drv_gpiote.h"
+#include "my_storage_manager.h"
+#include "my_energy_manager.h"
+#include "my_log_manager.h"
+#include "my_trace_manager.h"
 #include "nrf_gpio.h"
 #include "app_timer.h"
-#include "sq_service_handler.h"
 
 #define NRF_LOG_MODULE_NAME "GPIO"
 #include "nrf_log.h"
@@ -29,25 +32,18 @@
 APP_TIMER_DEF(m_led_timer_id); /**< led blinking timer. */
 #endif
 
-APP_TIMER_DEF(m_button_timer_id); /**< button timer. */
-
 /**
     @brief struct to describe curent state of gpios
 */
 typedef struct {
     uint8_t output_reg1;
-    uint8_t output_reg2;    
-    uint8_t input_reg;          
+    uint8_t output_reg2;
 } my_gpio_state_t;
 
 /** @brief main struct with actual values of gpios
 */
 my_gpio_state_t gpio_state;
 
-/** @brief button short press flag to detect long press
-*/
-static bool button_short_pres_made_flag = false;
-
 /** @brief Numbers of pins in gpio_reg1:
 */
 uint8_t out_reg1_pin_numbers[COUNT_OF_BITS_IN_BYTE] = {28, 0x00, 0x00, 0x00,
@@ -59,7 +55,6 @@ uint8_t out_reg2_pin_numbers[COUNT_OF_BITS_IN_BYTE] = {0x00, 0x00, 0x00, 0x00,
 /* ==================== function prototypes =========================== */
 /* ==================================================================== */
 
-static void button_event_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
 static void led_timer_callback(void * p_context);
 static void led_on(void);
 static void led_off(void);
@@ -70,6 +65,7 @@ static bool get_led_state(void);
 static void led_on(void) {
     gpio_state.output_reg2 |= LED_BIT_NUMBER;
     nrf_gpio_pin_write(LED_PIN_NUMBER, LEDS_ACTIVE_STATE ? 1 : 0);
+    MY_ENERGY_LED(true);
 }
 
 /** @brief Turn LED off
@@ -77,6 +73,7 @@ static void led_on(void) {
 static void led_off(void) {
     gpio_state.output_reg2 &= ~LED_BIT_NUMBER;
     nrf_gpio_pin_write(LED_PIN_NUMBER, LEDS_ACTIVE_STATE ? 0 : 1);    
+    MY_ENERGY_LED(false);
 }
 
 /** @brief Return state of LED
@@ -88,80 +85,18 @@ static bool get_led_state(void) {
     else 
         return false;
 }
-/**
-    @brief Handler of gpiote (button) event
-*/
-static void button_event_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
-    
-    if (pin == BUTTON_PIN_NUMBER) {        
-        /// if button pushed event
-        if (action == GPIOTE_CONFIG_POLARITY_HiToLo) {
-            
-            NRF_LOG_INFO("button_event_handler()\r\n");
-            nrf_drv_gpiote_in_event_disable(BUTTON_PIN_NUMBER);          
-            
-            /// start timer and after it will overrun, check button state
-            uint32_t err_code = app_timer_start(m_button_timer_id, BUT_SHORT_INTERVAL, NULL);
-            APP_ERROR_CHECK(err_code);
-        }
-    }
-}
-
 /** @brief Callback overrun of led timer
 */
 static void led_timer_callback(void * p_context) {
+    MY_TRACE_ENTER(TRACE_POINT_LED_TIMER);
+    MY_ENERGY_WAKEUP(ENERGY_FEATURE_LED);
     /// if led not active - start it
     if (get_led_state()) {
         led_off();
     } else {
         led_on();        
     }    
-}
-
-/** @brief Callback overrun of button timer
-*/
-static void buton_timer_callback(void * p_context) {
-    
-    /// check short press or long push
-    if (button_short_pres_made_flag == false) {
-        /// waiting short press
-        if (nrf_gpio_pin_read(BUTTON_PIN_NUMBER) == 1) {
-            /// short push detected
-            button_short_pres_made_flag = true;
-            uint32_t err_code = app_timer_stop(m_button_timer_id);
-            err_code = app_timer_start(m_button_timer_id,
-                                                BUT_LONG_INTERVAL, NULL);
-        }
-        else        
-            nrf_drv_gpiote_in_event_enable(BUTTON_PIN_NUMBER, true);
-    } else {
-        button_short_pres_made_flag = false;
-        /// start waiting of long push
-        if (nrf_gpio_pin_read(BUTTON_PIN_NUMBER) == 1) {
-            /// long push detected
-            if ((gpio_state.input_reg & BUT_LONG_BIT_NUMBER) == 1)
-                gpio_state.input_reg &= ~BUT_LONG_BIT_NUMBER;
-            else
-                gpio_state.input_reg |= BUT_LONG_BIT_NUMBER;
-            
-            gpio_state.input_reg &= ~BUT_SHORT_BIT_NUMBER;
-            NRF_LOG_INFO("buton_timer_callback() - BUT_LONG\r\n");
-        }
-        else {
-            /// short push detected            
-            if ((gpio_state.input_reg & BUT_SHORT_BIT_NUMBER) == 1)
-                gpio_state.input_reg &= ~BUT_SHORT_BIT_NUMBER;
-            else
-                gpio_state.input_reg |= BUT_SHORT_BIT_NUMBER;
-            
-            gpio_state.input_reg &= ~BUT_LONG_BIT_NUMBER;
-            NRF_LOG_INFO("buton_timer_callback() - BUT_SHORT\r\n");            
-        }
-        /// update characteristic
-        sq_service_update_input_characteristic(gpio_state.input_reg);
-        
-        nrf_drv_gpiote_in_event_enable(BUTTON_PIN_NUMBER, true);
-    }    
+    MY_TRACE_EXIT(TRACE_POINT_LED_TIMER);
 }
 
 /* ==================================================================== */
@@ -169,7 +104,7 @@ static void buton_timer_callback(void * p_context) {
 /* ==================================================================== */
 
 /**
-    @brief Init gpios, timer for led and gpiote module for button
+    @brief Init gpios and timer for led
 */
 uint32_t my_gpio_init(void) {
    
@@ -184,31 +119,15 @@ uint32_t my_gpio_init(void) {
     nrf_gpio_pin_write(ADC_INPUT_HIGH_SIDE_PIN_NUMBER, 1);
     nrf_gpio_pin_write(ADC_INPUT_LOW_SIDE_PIN_NUMBER, 0);
     
-    /// init button as gpiote
-    uint32_t err_code;
-    if(!nrf_drv_gpiote_is_init())
-    {   // init of gpiote driver
-        err_code = nrf_drv_gpiote_init();
-    }
-    // init button as gpiote
-    nrf_drv_gpiote_in_config_t config = GPIOTE_CONFIG_IN_SENSE_HITOLO(false);
-    config.pull = NRF_GPIO_PIN_PULLUP;
-    err_code = nrf_drv_gpiote_in_init(BUTTON_PIN_NUMBER, &config, button_event_handler); 
-    uint32_t ppi_event_addr = nrf_drv_gpiote_in_event_addr_get(BUTTON_PIN_NUMBER);
-    nrf_drv_gpiote_in_event_enable(BUTTON_PIN_NUMBER, true);
-    
+    uint32_t err_code = NRF_SUCCESS;
+
     #ifdef LED_INDICATE    
     /// init timer to blinking led    
     err_code = app_timer_create(&m_led_timer_id,
                                 APP_TIMER_MODE_REPEATED,
                                 led_timer_callback);   
     #endif
-    
-    // init buton timer
-    err_code = app_timer_create(&m_button_timer_id,
-                            APP_TIMER_MODE_SINGLE_SHOT,
-                            buton_timer_callback); 
-        
+
     //init gpio_reg1
     uint8_t i = 0;
     
@@ -223,7 +142,7 @@ uint32_t my_gpio_init(void) {
     @param new_state[IN] - type of blinking
 */
 uint32_t led_indicate_manage(const led_indication_state_t new_state) {
-    uint32_t err_code;  
+    uint32_t err_code = NRF_SUCCESS;
     
     switch (new_state) 
     {
@@ -263,7 +182,8 @@ void my_gpio_on_ble_evt(ble_evt_t * p_ble_evt) {
 }
 
 /**
-    @brief Callback for writing to out_registers
+    @brief Callback for writing to out_registers.
+           Value is also stored in flash and restored after reset.
 */
 void my_gpio_out_change_state (const gpio_out_regs_t reg_number, 
                                const uint8_t new_state) {
@@ -273,17 +193,22 @@ void my_gpio_out_change_state (const gpio_out_regs_t reg_number,
     if (GPIO_OUT_REG1 == reg_number) {                                  
         for (i = 0; i < COUNT_OF_BITS_IN_BYTE; i++) {
             if ( ((1 << i) & gpio_state.output_reg1) != ((1 << i) & new_state) ) {
-                if (((1 << i) & new_state) == 1) {
+                if (((1 << i) & new_state) != 0) {
                     gpio_state.output_reg1 |= (1 << i);
                     nrf_gpio_pin_write(out_reg1_pin_numbers[i], 1);
-                    NRF_LOG_INFO("my_gpio_out_change_state %d to 1\r\n", out_reg1_pin_numbers[i]);
+                    MY_LOG("my_gpio_out_change_state %d to 1", out_reg1_pin_numbers[i]);
                 } else {
                     gpio_state.output_reg1 &= ~(1 << i);
                     nrf_gpio_pin_write(out_reg1_pin_numbers[i], 0);
-                    NRF_LOG_INFO("my_gpio_out_change_state %d to 0\r\n", out_reg1_pin_numbers[i]);
+                    MY_LOG("my_gpio_out_change_state %d to 0", out_reg1_pin_numbers[i]);
                 }
             }                
         }
+        
+        /// store new state, it is written to flash after delay
+        my_config_t config = *my_storage_config_get();
+        config.out_reg1 = gpio_state.output_reg1;
+        my_storage_config_save(&config);
     } else if (GPIO_OUT_REG2 == reg_number) {
         /// TODO
         /// ...
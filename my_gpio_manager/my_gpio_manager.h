@@ -12,10 +12,6 @@
 #define LED_ADVERTISING_INTERVAL    APP_TIMER_TICKS(500, APP_TIMER_PRESCALER)
 #define LED_CONNECTED_INTERVAL      APP_TIMER_TICKS(750, APP_TIMER_PRESCALER)
 
-// time to detecting long and short pushes of button
-#define BUT_SHORT_INTERVAL          APP_TIMER_TICKS(100, APP_TIMER_PRESCALER)
-#define BUT_LONG_INTERVAL           APP_TIMER_TICKS(250, APP_TIMER_PRESCALER)
-
 /**
     @brief Possible led states for indication processes
 */
@@ -0,0 +1,314 @@
+/**
+    @brief This module used to manage all digital inputs (buttons).
+
+    Every input from the table has low power GPIOTE event (PORT event with
+    sense of pin level). First event from any input disables all events and
+    starts one shared debounce timer, which samples all inputs on every tick
+    and detects gestures. When all inputs are released and no gesture is
+    pending, timer is stopped and events are enabled again, so idle inputs
+    cost no wakeups.
+    All gestures detected on one tick are written to input_reg and
+    reported by one update of characteristic. Every gesture is also stored
+    with timestamp in FIFO of sq service, so central gets all transitions
+    in order even if several of them happen between connection events.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include "my_input_manager.h"
+#include "nrf_drv_gpiote.h"
+#include "nrf_gpio.h"
+#include "sq_service_handler.h"
+#include "my_energy_manager.h"
+#include "my_log_manager.h"
+#include "my_stats_manager.h"
+#include "my_trace_manager.h"
+#include "my_broadcast_manager.h"
+#include "my_adv_manager.h"
+
+#define NRF_LOG_MODULE_NAME "INPUT"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define INPUT_COUNT     (sizeof(m_inputs) / sizeof(m_inputs[0]))
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+APP_TIMER_DEF(m_input_timer_id); /**< shared debounce timer. */
+
+/** @brief Table of inputs
+*/
+static const my_input_cfg_t m_inputs[] = {
+    {
+        .pin          = BUTTON_PIN_NUMBER,
+        .active_state = BUTTON_ACTIVE_STATE,
+        .short_mask   = BUT_SHORT_BIT_NUMBER,
+        .long_mask    = BUT_LONG_BIT_NUMBER,
+        .double_mask  = BUT_DOUBLE_BIT_NUMBER,
+        .repeat_mask  = BUT_REPEAT_BIT_NUMBER,
+    },
+};
+
+/**
+    @brief struct to describe curent state of input
+*/
+typedef struct {
+    uint8_t  integrator;    /**< debounce counter, 0..INPUT_DEBOUNCE_TICKS */
+    bool     pressed;       /**< debounced state */
+    bool     long_sent;     /**< long press already reported for this press */
+    uint8_t  clicks;        /**< count of short clicks waiting for double-click window */
+    uint16_t ticks;         /**< ticks since last press or release */
+} input_state_t;
+
+static input_state_t m_input_state[INPUT_MAX_COUNT];
+
+/** @brief actual value of input register
+*/
+static uint8_t input_reg = 0x00;
+
+/** @brief debounce timer is running
+*/
+static bool m_timer_active = false;
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void input_port_event_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
+static void input_timer_callback(void * p_context);
+static void input_events_enable(bool enable);
+static bool input_is_active(const my_input_cfg_t * p_cfg);
+static uint8_t input_gesture_apply(const my_input_cfg_t * p_cfg, input_gesture_t gesture);
+static bool input_process(const my_input_cfg_t * p_cfg, input_state_t * p_state, uint8_t * p_changes);
+
+/** @brief Return current (not debounced) state of input
+*/
+static bool input_is_active(const my_input_cfg_t * p_cfg) {
+    return (nrf_gpio_pin_read(p_cfg->pin) == p_cfg->active_state);
+}
+
+/** @brief Enable or disable events of all inputs
+*/
+static void input_events_enable(bool enable) {
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        if (enable)
+            nrf_drv_gpiote_in_event_enable(m_inputs[i].pin, true);
+        else
+            nrf_drv_gpiote_in_event_disable(m_inputs[i].pin);
+    }
+}
+
+/** @brief Toggle bits of gesture in input_reg, other gesture bits of
+           this input are cleared.
+    @return mask of changed bits
+*/
+static uint8_t input_gesture_apply(const my_input_cfg_t * p_cfg, input_gesture_t gesture) {
+
+    uint8_t all_mask = p_cfg->short_mask | p_cfg->long_mask
+                     | p_cfg->double_mask | p_cfg->repeat_mask;
+    uint8_t mask = 0x00;
+
+    switch (gesture)
+    {
+        case INPUT_GESTURE_SHORT:  mask = p_cfg->short_mask;  break;
+        case INPUT_GESTURE_LONG:   mask = p_cfg->long_mask;   break;
+        case INPUT_GESTURE_DOUBLE: mask = p_cfg->double_mask; break;
+        case INPUT_GESTURE_REPEAT: mask = p_cfg->repeat_mask; break;
+        default: break;
+    }
+
+    uint8_t old_reg = input_reg;
+    input_reg = (input_reg & ~(all_mask & ~mask)) ^ mask;
+
+    sq_service_push_input_event(input_reg, SQ_INPUT_EVT_CODE(p_cfg - m_inputs, gesture));
+
+    MY_LOG("pin %d gesture %d, input_reg = 0x%x", p_cfg->pin, gesture, input_reg);
+    return (old_reg ^ input_reg);
+}
+
+/** @brief Debounce one input and detect its gestures
+    @param[out] p_changes - accumulated mask of changed bits of input_reg
+    @return true if input is idle: released and no gesture pending
+*/
+static bool input_process(const my_input_cfg_t * p_cfg, input_state_t * p_state, uint8_t * p_changes) {
+
+    /// integrating debounce
+    if (input_is_active(p_cfg)) {
+        if (p_state->integrator < INPUT_DEBOUNCE_TICKS)
+            p_state->integrator++;
+    } else {
+        if (p_state->integrator > 0)
+            p_state->integrator--;
+    }
+
+    if (p_state->ticks < UINT16_MAX)
+        p_state->ticks++;
+
+    if ((p_state->pressed == false) && (p_state->integrator == INPUT_DEBOUNCE_TICKS)) {
+        /// press detected
+        p_state->pressed   = true;
+        p_state->long_sent = false;
+        p_state->ticks     = 0;
+    } else if ((p_state->pressed == true) && (p_state->integrator == 0)) {
+        /// release detected
+        p_state->pressed = false;
+        p_state->ticks   = 0;
+        if (p_state->long_sent == false) {
+            p_state->clicks++;
+            if (p_cfg->double_mask == 0) {
+                /// double-click is not used - report short without waiting
+                *p_changes |= input_gesture_apply(p_cfg, INPUT_GESTURE_SHORT);
+                p_state->clicks = 0;
+            } else if (p_state->clicks >= 2) {
+                *p_changes |= input_gesture_apply(p_cfg, INPUT_GESTURE_DOUBLE);
+                p_state->clicks = 0;
+            }
+        }
+    }
+
+    if (p_state->pressed) {
+        if ((p_state->long_sent == false) && (p_state->ticks >= INPUT_LONG_TICKS)) {
+            /// click before long press can't be double-click any more
+            if (p_state->clicks != 0) {
+                *p_changes |= input_gesture_apply(p_cfg, INPUT_GESTURE_SHORT);
+                p_state->clicks = 0;
+            }
+            *p_changes |= input_gesture_apply(p_cfg, INPUT_GESTURE_LONG);
+            p_state->long_sent = true;
+        } else if ((p_state->long_sent == true) && (p_cfg->repeat_mask != 0)
+                   && (p_state->ticks >= INPUT_REPEAT_START_TICKS)
+                   && (((p_state->ticks - INPUT_REPEAT_START_TICKS) % INPUT_REPEAT_PERIOD_TICKS) == 0)) {
+            *p_changes |= input_gesture_apply(p_cfg, INPUT_GESTURE_REPEAT);
+        }
+    } else if ((p_state->clicks != 0) && (p_state->ticks >= INPUT_DOUBLE_WINDOW_TICKS)) {
+        /// double-click window is over
+        *p_changes |= input_gesture_apply(p_cfg, INPUT_GESTURE_SHORT);
+        p_state->clicks = 0;
+    }
+
+    return ((p_state->pressed == false) && (p_state->integrator == 0) && (p_state->clicks == 0));
+}
+
+/**
+    @brief Handler of gpiote PORT event of any input
+*/
+static void input_port_event_handler(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
+
+    UNUSED_PARAMETER(pin);
+    UNUSED_PARAMETER(action);
+    MY_TRACE_ENTER(TRACE_POINT_INPUT_GPIOTE);
+    MY_ENERGY_WAKEUP(ENERGY_FEATURE_INPUT);
+
+    if (m_timer_active == false) {
+        /// bouncing of contacts is handled by timer, not by events
+        input_events_enable(false);
+
+        uint32_t err_code = app_timer_start(m_input_timer_id, INPUT_TICK_INTERVAL, NULL);
+        APP_ERROR_CHECK(err_code);
+        m_timer_active = true;
+    }
+    MY_TRACE_EXIT(TRACE_POINT_INPUT_GPIOTE);
+}
+
+/** @brief Callback of debounce timer
+*/
+static void input_timer_callback(void * p_context) {
+
+    UNUSED_PARAMETER(p_context);
+    MY_STATS_HANDLER_ENTER();
+    MY_TRACE_ENTER(TRACE_POINT_INPUT_TIMER);
+    MY_ENERGY_WAKEUP(ENERGY_FEATURE_INPUT);
+
+    bool    all_idle = true;
+    uint8_t changes  = 0x00;
+
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        if (input_process(&m_inputs[i], &m_input_state[i], &changes) == false)
+            all_idle = false;
+    }
+
+    if (changes != 0) {
+        /// one update of characteristic for all gestures of this tick
+        sq_service_update_input_characteristic(input_reg);
+        sq_service_input_events_flush();
+        my_broadcast_input_set(input_reg);
+        /// user is near device - it advertises with the shortest interval again
+        uint32_t err_code = my_adv_wakeup();
+        APP_ERROR_CHECK(err_code);
+    }
+
+    if (all_idle) {
+        uint32_t err_code = app_timer_stop(m_input_timer_id);
+        APP_ERROR_CHECK(err_code);
+        m_timer_active = false;
+
+        /// sense of every pin is set from its current level
+        input_events_enable(true);
+
+        /// input could be pressed before events were enabled
+        for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+            if (input_is_active(&m_inputs[i])) {
+                input_port_event_handler(m_inputs[i].pin, NRF_GPIOTE_POLARITY_TOGGLE);
+                break;
+            }
+        }
+    }
+    MY_TRACE_EXIT(TRACE_POINT_INPUT_TIMER);
+    MY_STATS_HANDLER_EXIT(STATS_HANDLER_INPUT_TIMER);
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Init gpiote events for all inputs and debounce timer
+*/
+uint32_t my_input_init(void) {
+
+    STATIC_ASSERT(INPUT_COUNT <= INPUT_MAX_COUNT);
+    STATIC_ASSERT(INPUT_COUNT <= GPIOTE_CONFIG_NUM_OF_LOW_POWER_EVENTS);
+
+    uint32_t err_code = NRF_SUCCESS;
+
+    if (!nrf_drv_gpiote_is_init())
+    {
+        err_code = nrf_drv_gpiote_init();
+        if (err_code != NRF_SUCCESS)
+            return err_code;
+    }
+
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        /// low power PORT event on both edges
+        nrf_drv_gpiote_in_config_t config = GPIOTE_CONFIG_IN_SENSE_TOGGLE(false);
+        config.pull = m_inputs[i].active_state ? NRF_GPIO_PIN_PULLDOWN : NRF_GPIO_PIN_PULLUP;
+
+        err_code = nrf_drv_gpiote_in_init(m_inputs[i].pin, &config, input_port_event_handler);
+        if (err_code != NRF_SUCCESS)
+            return err_code;
+    }
+
+    err_code = app_timer_create(&m_input_timer_id,
+                                APP_TIMER_MODE_REPEATED,
+                                input_timer_callback);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    input_events_enable(true);
+
+    return err_code;
+}
+
+/**
+    @brief return actual value of input register
+*/
+uint8_t my_input_get_reg(void) {
+    return input_reg;
+}
@@ -0,0 +1,58 @@
+/*!
+    @brief Module for manage of digital inputs (buttons).
+           All inputs are described in one table, share one GPIOTE PORT event
+           and one debounce timer (RTC1 ticks of app_timer). Detected gestures
+           (short, long, double-click, hold-repeat) toggle bits in input_reg.
+*/
+
+#ifndef __MY_INPUT_MANAGER__
+#define __MY_INPUT_MANAGER__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_timer.h"
+#include "custom_board.h"
+
+#define INPUT_MAX_COUNT             8U      /**< Max count of inputs in the table */
+
+/// Period of debounce timer, all inputs are sampled on every tick
+#define INPUT_TICK_MS               10U
+#define INPUT_TICK_INTERVAL         APP_TIMER_TICKS(INPUT_TICK_MS, APP_TIMER_PRESCALER)
+
+/// Count of equal samples to accept new level of input
+#define INPUT_DEBOUNCE_TICKS        3U
+/// Time to detecting gestures, in ticks of debounce timer
+#define INPUT_LONG_TICKS            (350U / INPUT_TICK_MS)
+#define INPUT_DOUBLE_WINDOW_TICKS   (250U / INPUT_TICK_MS)
+#define INPUT_REPEAT_START_TICKS    (1000U / INPUT_TICK_MS)
+#define INPUT_REPEAT_PERIOD_TICKS   (200U / INPUT_TICK_MS)
+
+/**
+    @brief Gestures detected by input engine
+*/
+typedef enum {
+    INPUT_GESTURE_NONE   = 0,
+    INPUT_GESTURE_SHORT  = 1,
+    INPUT_GESTURE_LONG   = 2,
+    INPUT_GESTURE_DOUBLE = 3,
+    INPUT_GESTURE_REPEAT = 4,
+} input_gesture_t;
+
+/**
+    @brief Description of one input. Gesture masks are bits of input_reg,
+           which are toggled by gesture, 0 - gesture is not detected for input.
+*/
+typedef struct {
+    uint8_t pin;            /**< Number of pin */
+    uint8_t active_state;   /**< Level of pin in pressed state */
+    uint8_t short_mask;     /**< Bits toggled by short press */
+    uint8_t long_mask;      /**< Bits toggled by long press */
+    uint8_t double_mask;    /**< Bits toggled by double-click */
+    uint8_t repeat_mask;    /**< Bits toggled on every repeat of hold */
+} my_input_cfg_t;
+
+uint32_t my_input_init(void);
+
+uint8_t my_input_get_reg(void);
+
+#endif
@@ -0,0 +1,235 @@
+/**
+    @brief TX power from RSSI of links, see my_link_manager.h
+
+    Every link has index of its required level in m_levels[], all events
+    are handled at priority of BLE events, so state isn't shared with
+    interrupts. SoftDevice is called only when the highest level changes.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stdbool.h>
+#include "my_link_manager.h"
+#include "tps_service_handler.h"
+#include "app_error.h"
+#include "nordic_common.h"
+#include "my_trace_manager.h"
+
+#define NRF_LOG_MODULE_NAME "LINK"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+#ifdef TX_POWER_CONTROL
+
+/// TX power levels of nRF52, ascending
+static int8_t const m_nrf52_levels[] = {-40, -20, -16, -12, -8, -4, 0, 3, 4};
+
+STATIC_ASSERT(LINK_TX_POWER_MIN < LINK_TX_POWER_MAX);
+
+/// levels of nRF52 in range of control, filled by my_link_init()
+static int8_t  m_levels[ARRAY_SIZE(m_nrf52_levels)];
+static uint8_t m_level_count;
+
+/** @brief Control state of link
+*/
+typedef struct {
+    uint16_t conn_handle;       /**< BLE_CONN_HANDLE_INVALID for free entry */
+    uint8_t  level;             /**< index of required level */
+    uint8_t  samples;           /**< RSSI values after the last step */
+} link_state_t;
+
+static link_state_t m_links[PERIPHERAL_LINK_MAX];
+static uint8_t      m_default_level = 0;            /**< level of TX_POWER_LEVEL */
+static int8_t       m_tx_power = TX_POWER_LEVEL;    /**< actual TX power */
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static link_state_t * link_find(uint16_t conn_handle);
+static uint32_t link_tx_power_apply(void);
+
+static link_state_t * link_find(uint16_t conn_handle) {
+
+    for (uint8_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        if (m_links[i].conn_handle == conn_handle)
+            return &m_links[i];
+    }
+    return NULL;
+}
+
+/** @brief Set the highest level of links to SoftDevice and TX power service
+*/
+static uint32_t link_tx_power_apply(void) {
+
+    bool     connected = false;
+    uint8_t  level = 0;
+    uint32_t err_code;
+
+    for (uint8_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        if (m_links[i].conn_handle != BLE_CONN_HANDLE_INVALID) {
+            connected = true;
+            level     = MAX(level, m_links[i].level);
+        }
+    }
+    if (connected == false)
+        level = m_default_level;
+
+    if (m_levels[level] == m_tx_power)
+        return NRF_SUCCESS;
+
+    err_code = sd_ble_gap_tx_power_set(m_levels[level]);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    m_tx_power = m_levels[level];
+    NRF_LOG_INFO("TX power %d dBm\r\n", m_tx_power);
+    MY_TRACE_VALUE(TRACE_POINT_TX_POWER, (uint16_t)m_tx_power);
+    return tps_service_tx_power_set(m_tx_power);
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Set default TX power, after TX power service is initialized
+*/
+uint32_t my_link_init(void) {
+
+    uint32_t err_code;
+
+    m_level_count = 0;
+    for (uint8_t i = 0; i < ARRAY_SIZE(m_nrf52_levels); i++) {
+        if ((m_nrf52_levels[i] >= LINK_TX_POWER_MIN) && (m_nrf52_levels[i] <= LINK_TX_POWER_MAX))
+            m_levels[m_level_count++] = m_nrf52_levels[i];
+    }
+    if (m_level_count == 0)
+        return NRF_ERROR_INVALID_PARAM;
+
+    m_default_level = 0;
+    for (uint8_t i = 0; i < m_level_count; i++) {
+        if (m_levels[i] <= TX_POWER_LEVEL)
+            m_default_level = i;
+    }
+    for (uint8_t i = 0; i < PERIPHERAL_LINK_MAX; i++)
+        m_links[i].conn_handle = BLE_CONN_HANDLE_INVALID;
+
+    m_tx_power = m_levels[m_default_level];
+    err_code   = sd_ble_gap_tx_power_set(m_tx_power);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return tps_service_tx_power_set(m_tx_power);
+}
+
+/**
+    @brief Handler of BLE events: RSSI is measured from connection, link starts with actual power
+*/
+void my_link_on_ble_evt(ble_evt_t * p_ble_evt) {
+
+    uint16_t       conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+    link_state_t * p_link;
+    uint32_t       err_code;
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            p_link = link_find(BLE_CONN_HANDLE_INVALID);
+            if (p_link == NULL)
+                break;
+            p_link->conn_handle = conn_handle;
+            p_link->samples     = 0;
+            p_link->level       = m_default_level;
+            for (uint8_t i = 0; i < m_level_count; i++) {
+                if (m_levels[i] == m_tx_power)
+                    p_link->level = i;
+            }
+            /// link could be already gone, when disconnect is pending in stack
+            err_code = sd_ble_gap_rssi_start(conn_handle, 0, 0);
+            MY_TRACE_VALUE(TRACE_POINT_RSSI_START, err_code);
+            if (err_code != BLE_ERROR_INVALID_CONN_HANDLE)
+                APP_ERROR_CHECK(err_code);
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            /// measuring of RSSI is stopped with link
+            p_link = link_find(conn_handle);
+            if (p_link == NULL)
+                break;
+            p_link->conn_handle = BLE_CONN_HANDLE_INVALID;
+            err_code = link_tx_power_apply();
+            APP_ERROR_CHECK(err_code);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+    @brief New filtered RSSI of link
+    @param[in] conn_handle - link
+    @param[in] rssi - filtered RSSI, dBm
+*/
+void my_link_rssi_update(uint16_t conn_handle, int8_t rssi) {
+
+    link_state_t * p_link = link_find(conn_handle);
+
+    if ((p_link == NULL) || (conn_handle == BLE_CONN_HANDLE_INVALID))
+        return;
+
+    if (p_link->samples < LINK_SETTLE_SAMPLES) {
+        p_link->samples++;
+        return;
+    }
+
+    if ((rssi > LINK_RSSI_HIGH_DBM) && (p_link->level > 0))
+        p_link->level--;
+    else if ((rssi < LINK_RSSI_LOW_DBM) && (p_link->level < m_level_count - 1))
+        p_link->level++;
+    else
+        return;
+
+    p_link->samples = 0;
+    uint32_t err_code = link_tx_power_apply();
+    APP_ERROR_CHECK(err_code);
+}
+
+/**
+    @brief Actual TX power, dBm
+*/
+int8_t my_link_tx_power_get(void) {
+    return m_tx_power;
+}
+
+#else
+
+/**
+    @brief Control is off: fixed TX power
+*/
+uint32_t my_link_init(void) {
+
+    uint32_t err_code = sd_ble_gap_tx_power_set(TX_POWER_LEVEL);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return tps_service_tx_power_set(TX_POWER_LEVEL);
+}
+
+void my_link_on_ble_evt(ble_evt_t * p_ble_evt) {
+}
+
+void my_link_rssi_update(uint16_t conn_handle, int8_t rssi) {
+}
+
+int8_t my_link_tx_power_get(void) {
+    return TX_POWER_LEVEL;
+}
+
+#endif
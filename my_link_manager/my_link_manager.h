@@ -0,0 +1,43 @@
+/*!
+    @brief Module of link quality: TX power follows filtered RSSI of links.
+           RSSI is measured on every link from connection, filtered value
+           (my_rssi_manager.h) moves required TX power of link by one step:
+           down when it is above LINK_RSSI_HIGH_DBM, up when it is below
+           LINK_RSSI_LOW_DBM. Between them power is kept (hysteresis), and
+           after every step LINK_SETTLE_SAMPLES new values are awaited.
+
+           S132 v3 has one TX power for all links and advertising, so the
+           highest power required by links is set, it is TX_POWER_LEVEL
+           without links. TX power service reports the actual value.
+
+           Control is compiled in when TX_POWER_CONTROL is defined in
+           custom_board.h, otherwise TX_POWER_LEVEL is fixed and RSSI is
+           measured only for its notification.
+*/
+
+#ifndef __MY_LINK_MANAGER__
+#define __MY_LINK_MANAGER__
+
+#include <stdint.h>
+#include "ble.h"
+#include "custom_board.h"
+
+/// Power is lowered above this RSSI, the central is close
+#define LINK_RSSI_HIGH_DBM          (-55)
+/// Power is raised below this RSSI, packets of far central are lost
+#define LINK_RSSI_LOW_DBM           (-75)
+/// New RSSI values after step of power, before the next step
+#define LINK_SETTLE_SAMPLES         8U
+/// Range of control, levels of nRF52 between them are used
+#define LINK_TX_POWER_MIN           (-20)
+#define LINK_TX_POWER_MAX           4
+
+uint32_t my_link_init(void);
+
+void my_link_on_ble_evt(ble_evt_t * p_ble_evt);
+
+void my_link_rssi_update(uint16_t conn_handle, int8_t rssi);
+
+int8_t my_link_tx_power_get(void);
+
+#endif
@@ -0,0 +1,151 @@
+/**
+    @brief Binary deferred log, see my_log_manager.h
+
+    Handlers of any priority write records, only idle loop reads them.
+    Records are in SPSC ring of my_ring_manager.h: writers are serialized by
+    short critical region, which reserves place of the whole record, writes
+    its words in place and commits them, so record is complete when it is
+    seen by reader. Reader does not lock: it copies record, sends it and
+    releases its words.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include "my_log_manager.h"
+#include "my_ring_manager.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+#include "SEGGER_RTT.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define LOG_RING_WORDS          512U        /**< size of ring, power of 2 */
+#define LOG_HEADER_WORDS        2U
+#define LOG_RECORD_WORDS_MAX    (LOG_HEADER_WORDS + MY_LOG_ARGS_MAX)
+#define LOG_TICKS_MASK          0x00FFFFFFU
+#define LOG_NARGS_POS           24U
+#define LOG_RTT_BUFFER_SIZE     1024U
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+#ifdef BINARY_LOG
+
+MY_RING_DEF(m_ring, uint32_t, LOG_RING_WORDS);
+static volatile uint32_t m_dropped = 0;         /**< records lost because ring is full */
+
+static uint8_t           m_rtt_buffer[LOG_RTT_BUFFER_SIZE];
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void log_word_put(my_ring_span_t const spans[2], uint32_t index, uint32_t word);
+
+/** @brief Word of record to reserved place, record can wrap to start of ring
+*/
+static void log_word_put(my_ring_span_t const spans[2], uint32_t index, uint32_t word) {
+
+    if (index < spans[0].count)
+        ((uint32_t *)spans[0].p_data)[index] = word;
+    else
+        ((uint32_t *)spans[1].p_data)[index - spans[0].count] = word;
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Init of RTT channel, app_timer must be initialized for time of records
+*/
+void my_log_init(void) {
+
+    my_ring_reset(&m_ring);
+    m_dropped = 0;
+
+    (void)SEGGER_RTT_ConfigUpBuffer(MY_LOG_RTT_CHANNEL, "mylog", m_rtt_buffer, sizeof(m_rtt_buffer),
+                                    SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+}
+
+/**
+    @brief Write record to ring, it is dropped if ring is full
+    @param[in] p_fmt - format string, it stays in flash
+    @param[in] nargs - count of arguments, up to MY_LOG_ARGS_MAX
+    @param[in] p_args - arguments
+*/
+void my_log_write(char const * p_fmt, uint32_t nargs, uint32_t const * p_args) {
+
+    my_ring_span_t spans[2];
+    uint32_t       words = LOG_HEADER_WORDS + nargs;
+    uint32_t       ticks;
+
+    (void)app_timer_cnt_get(&ticks);
+
+    CRITICAL_REGION_ENTER();
+    if (my_ring_reserve(&m_ring, words, spans)) {
+        log_word_put(spans, 0, (uint32_t)(uintptr_t)p_fmt);
+        log_word_put(spans, 1, (ticks & LOG_TICKS_MASK) | (nargs << LOG_NARGS_POS));
+        for (uint32_t i = 0; i < nargs; i++)
+            log_word_put(spans, LOG_HEADER_WORDS + i, p_args[i]);
+        my_ring_commit(&m_ring, words);
+    } else {
+        m_dropped++;
+    }
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+    @brief Send one record to RTT, must be called from idle loop
+    @return true if there are more records to send, false if ring is empty
+            or RTT buffer is full (host does not read it now)
+*/
+bool my_log_process(void) {
+
+    uint32_t record[LOG_RECORD_WORDS_MAX];
+    uint32_t dropped = m_dropped;
+    uint32_t words;
+
+    if (dropped != 0) {
+        /// record about lost records, they are counted from 0 again
+        uint32_t ticks;
+        (void)app_timer_cnt_get(&ticks);
+        record[0] = 0;
+        record[1] = (ticks & LOG_TICKS_MASK) | (1U << LOG_NARGS_POS);
+        record[2] = dropped;
+        if (SEGGER_RTT_Write(MY_LOG_RTT_CHANNEL, record, 3 * sizeof(uint32_t)) == 0)
+            return false;
+        CRITICAL_REGION_ENTER();
+        m_dropped -= dropped;
+        CRITICAL_REGION_EXIT();
+    }
+
+    /// record is pushed whole, so its words are there when header is there
+    if (my_ring_read(&m_ring, 0, record, LOG_HEADER_WORDS) == 0)
+        return false;
+
+    words = LOG_HEADER_WORDS + (record[1] >> LOG_NARGS_POS);
+    (void)my_ring_read(&m_ring, 0, record, words);
+
+    if (SEGGER_RTT_Write(MY_LOG_RTT_CHANNEL, record, words * sizeof(uint32_t)) == 0)
+        return false;
+
+    my_ring_skip(&m_ring, words);
+
+    return (my_ring_count(&m_ring) != 0);
+}
+
+#else
+
+void my_log_init(void) {
+}
+
+bool my_log_process(void) {
+    return false;
+}
+
+#endif
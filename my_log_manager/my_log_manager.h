@@ -0,0 +1,63 @@
+/*!
+    @brief Module of binary deferred log for hot handlers. Record is address
+           of format string, RTC1 time and up to 4 raw 32-bit arguments, it is
+           copied to ring buffer in tens of cycles. Records are sent from idle
+           loop by my_log_process() to RTT channel MY_LOG_RTT_CHANNEL, text is
+           made by host decoder (host/log) from strings of ELF file.
+
+           Format of record, 32-bit words:
+               0 - address of format string, 0 for record of dropped records
+               1 - bits 0..23 RTC1 ticks, bits 24..27 count of arguments
+               2.. arguments
+
+           %s argument must point to string in flash, it is read from ELF.
+
+           Binary log is compiled in when BINARY_LOG is defined in
+           custom_board.h, otherwise MY_LOG is NRF_LOG_INFO.
+*/
+
+#ifndef __MY_LOG_MANAGER__
+#define __MY_LOG_MANAGER__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "custom_board.h"
+
+#define MY_LOG_ARGS_MAX         4U
+#define MY_LOG_RTT_CHANNEL      1U
+
+/// count of arguments after format string, 0..4
+#define MY_LOG_NARGS(...)       MY_LOG_NARGS_(__VA_ARGS__, 4, 3, 2, 1, 0, ~)
+#define MY_LOG_NARGS_(FMT, A1, A2, A3, A4, N, ...)  N
+
+#define MY_LOG_CONCAT(A, B)     MY_LOG_CONCAT_(A, B)
+#define MY_LOG_CONCAT_(A, B)    A ## B
+
+#ifdef BINARY_LOG
+
+/**
+    @brief Log record, format string must be literal without new line
+*/
+#define MY_LOG(...)             MY_LOG_CONCAT(MY_LOG_, MY_LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+#define MY_LOG_0(FMT)               my_log_write(FMT, 0, NULL)
+#define MY_LOG_1(FMT, A)            my_log_write(FMT, 1, (uint32_t[]){(uint32_t)(A)})
+#define MY_LOG_2(FMT, A, B)         my_log_write(FMT, 2, (uint32_t[]){(uint32_t)(A), (uint32_t)(B)})
+#define MY_LOG_3(FMT, A, B, C)      my_log_write(FMT, 3, (uint32_t[]){(uint32_t)(A), (uint32_t)(B), \
+                                                                     (uint32_t)(C)})
+#define MY_LOG_4(FMT, A, B, C, D)   my_log_write(FMT, 4, (uint32_t[]){(uint32_t)(A), (uint32_t)(B), \
+                                                                     (uint32_t)(C), (uint32_t)(D)})
+
+#else
+
+/// nrf_log.h is included by user after NRF_LOG_MODULE_NAME
+#define MY_LOG(FMT, ...)        NRF_LOG_INFO(FMT "\r\n", ##__VA_ARGS__)
+
+#endif
+
+void my_log_init(void);
+void my_log_write(char const * p_fmt, uint32_t nargs, uint32_t const * p_args);
+bool my_log_process(void);
+
+#endif
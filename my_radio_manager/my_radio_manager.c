@@ -0,0 +1,72 @@
+/**
+    @brief Radio notification, see my_radio_manager.h
+
+    Handler runs in SWI1 at APP_IRQ_PRIORITY_LOW, the same priority as
+    app_timer, so flags of consumers aren't changed during the handler.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include "my_radio_manager.h"
+#include "ble_radio_notification.h"
+#include "ble_conn_state.h"
+#include "app_util_platform.h"
+#include "my_adc_manager.h"
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+#ifdef RADIO_SYNC
+
+static bool m_radio_sync = false;     /**< notification is configured */
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void radio_notification_handler(bool radio_active);
+
+/** @brief Signal before radio event and after it, work is done before event
+*/
+static void radio_notification_handler(bool radio_active) {
+
+    if (radio_active)
+        my_adc_on_radio_active();
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Enable notification before radio events, SoftDevice must be enabled
+*/
+uint32_t my_radio_init(void) {
+
+    uint32_t err_code = ble_radio_notification_init(APP_IRQ_PRIORITY_LOW,
+                                                    RADIO_NOTIFICATION_DISTANCE,
+                                                    radio_notification_handler);
+    m_radio_sync = (err_code == NRF_SUCCESS);
+    return err_code;
+}
+
+/**
+    @brief Work is deferred to radio notification, when there are connection events
+*/
+bool my_radio_sync_active(void) {
+    return m_radio_sync && (ble_conn_state_n_connections() != 0);
+}
+
+#else
+
+uint32_t my_radio_init(void) {
+    return NRF_SUCCESS;
+}
+
+bool my_radio_sync_active(void) {
+    return false;
+}
+
+#endif
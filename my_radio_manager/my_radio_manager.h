@@ -0,0 +1,31 @@
+/*!
+    @brief Module of radio notification: work is aligned to connection events.
+           SoftDevice signals RADIO_NOTIFICATION_DISTANCE before every radio
+           event, measurement requested by timer while there are links waits
+           for this signal, so the new value is notified in the next
+           connection event and data age is only time of conversion.
+
+           Timer still sets rate of sampling, connection interval sets only
+           the moment, so rate of samples and connection events isn't changed.
+           Without links sampling is done by timer at once.
+
+           Alignment is compiled in when RADIO_SYNC is defined in
+           custom_board.h, otherwise samples are taken by timer.
+*/
+
+#ifndef __MY_RADIO_MANAGER__
+#define __MY_RADIO_MANAGER__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nrf_soc.h"
+#include "custom_board.h"
+
+/// Time from signal to radio event: SAADC conversion and notification fit it
+#define RADIO_NOTIFICATION_DISTANCE     NRF_RADIO_NOTIFICATION_DISTANCE_800US
+
+uint32_t my_radio_init(void);
+
+bool my_radio_sync_active(void);
+
+#endif
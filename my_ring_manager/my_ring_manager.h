@@ -0,0 +1,247 @@
+/*!
+    @brief Module of lock-free ring buffer with one producer and one consumer
+           (SPSC), header only. Producer and consumer may run at different
+           interrupt priorities without critical region: head is written only
+           by producer, tail only by consumer. Several producers (or consumers)
+           must be serialized by the user, e.g. by critical region.
+
+           Size is power of 2, indexes are free running and masked at access,
+           so all elements are used and count is (head - tail).
+
+           Elements are copied in bulk by up to two memcpy. Producer can also
+           write elements in place by my_ring_reserve() and publish them by
+           my_ring_commit(), consumer can take elements in place by
+           my_ring_peek() and release them by my_ring_skip().
+
+           Order of accesses on Cortex-M4: data are written before head is
+           published and read before tail is released, __DMB() keeps this
+           order in both compiler and bus.
+*/
+
+#ifndef __MY_RING_MANAGER__
+#define __MY_RING_MANAGER__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "nrf.h"
+#include "nrf_error.h"
+#include "app_util.h"
+
+/**
+    @brief Ring, it is made by MY_RING_DEF or my_ring_init()
+*/
+typedef struct {
+    uint8_t *         p_buf;
+    uint16_t          elem_size;        /**< bytes of element */
+    uint16_t          mask;             /**< count of elements - 1 */
+    volatile uint32_t head;             /**< free running, written by producer */
+    volatile uint32_t tail;             /**< free running, written by consumer */
+} my_ring_t;
+
+/**
+    @brief Elements in place: the second span is not empty when elements wrap
+*/
+typedef struct {
+    void *   p_data;
+    uint32_t count;
+} my_ring_span_t;
+
+/// Static ring of SIZE elements of TYPE, SIZE is power of 2
+#define MY_RING_DEF(NAME, TYPE, SIZE)                                           \
+    STATIC_ASSERT(((SIZE) & ((SIZE) - 1)) == 0);                                \
+    static TYPE      NAME##_buf[SIZE];                                          \
+    static my_ring_t NAME = {(uint8_t *)NAME##_buf, sizeof(TYPE), (SIZE) - 1, 0, 0}
+
+/**
+    @brief Ring on buffer of user, it is empty
+    @param[in] p_buf - buffer of size * elem_size bytes
+    @param[in] size - count of elements, power of 2
+    @return NRF_ERROR_INVALID_PARAM if size isn't power of 2
+*/
+__STATIC_INLINE uint32_t my_ring_init(my_ring_t * p_ring, void * p_buf, uint16_t elem_size, uint32_t size) {
+
+    if ((size == 0) || ((size & (size - 1)) != 0) || (size > 0x10000U))
+        return NRF_ERROR_INVALID_PARAM;
+
+    p_ring->p_buf     = (uint8_t *)p_buf;
+    p_ring->elem_size = elem_size;
+    p_ring->mask      = (uint16_t)(size - 1);
+    p_ring->head      = 0;
+    p_ring->tail      = 0;
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Empty ring, only when neither producer nor consumer runs
+*/
+__STATIC_INLINE void my_ring_reset(my_ring_t * p_ring) {
+    p_ring->head = 0;
+    p_ring->tail = 0;
+}
+
+__STATIC_INLINE uint32_t my_ring_size(my_ring_t const * p_ring) {
+    return (uint32_t)p_ring->mask + 1;
+}
+
+/**
+    @brief Count of elements, exact for consumer, lower bound for producer
+*/
+__STATIC_INLINE uint32_t my_ring_count(my_ring_t const * p_ring) {
+    return p_ring->head - p_ring->tail;
+}
+
+/**
+    @brief Free place, exact for producer, lower bound for consumer
+*/
+__STATIC_INLINE uint32_t my_ring_free(my_ring_t const * p_ring) {
+    return my_ring_size(p_ring) - (p_ring->head - p_ring->tail);
+}
+
+/**
+    @brief Copy between ring and linear buffer, starting at free running index
+*/
+__STATIC_INLINE void my_ring_copy(my_ring_t const * p_ring, uint32_t index, void * p_data,
+                                  uint32_t count, bool to_ring) {
+
+    uint32_t  size  = p_ring->elem_size;
+    uint32_t  pos   = index & p_ring->mask;
+    uint32_t  first = my_ring_size(p_ring) - pos;
+    uint8_t * p_ring_data = &p_ring->p_buf[pos * size];
+
+    if (first > count)
+        first = count;
+
+    if (to_ring)
+        memcpy(p_ring_data, p_data, first * size);
+    else
+        memcpy(p_data, p_ring_data, first * size);
+
+    /// the rest is wrapped to start of buffer
+    if (first == count)
+        return;
+    if (to_ring)
+        memcpy(p_ring->p_buf, (uint8_t *)p_data + first * size, (count - first) * size);
+    else
+        memcpy((uint8_t *)p_data + first * size, p_ring->p_buf, (count - first) * size);
+}
+
+/**
+    @brief Producer: push all elements or nothing
+    @return false if there is no place for all of them
+*/
+__STATIC_INLINE bool my_ring_push(my_ring_t * p_ring, void const * p_data, uint32_t count) {
+
+    uint32_t head = p_ring->head;
+
+    if ((my_ring_size(p_ring) - (head - p_ring->tail)) < count)
+        return false;
+
+    my_ring_copy(p_ring, head, (void *)p_data, count, true);
+    /// elements are in memory before consumer sees them
+    __DMB();
+    p_ring->head = head + count;
+    return true;
+}
+
+/**
+    @brief Producer: place for count elements in place, consumer sees them after my_ring_commit()
+    @param[out] spans - place at head in spans[0], wrapped place in spans[1]
+    @return false if there is no place for all of them
+*/
+__STATIC_INLINE bool my_ring_reserve(my_ring_t const * p_ring, uint32_t count, my_ring_span_t spans[2]) {
+
+    uint32_t head  = p_ring->head;
+    uint32_t pos   = head & p_ring->mask;
+    uint32_t first = my_ring_size(p_ring) - pos;
+
+    if ((my_ring_size(p_ring) - (head - p_ring->tail)) < count)
+        return false;
+    if (first > count)
+        first = count;
+
+    spans[0].p_data = &p_ring->p_buf[pos * p_ring->elem_size];
+    spans[0].count  = first;
+    spans[1].p_data = p_ring->p_buf;
+    spans[1].count  = count - first;
+    return true;
+}
+
+/**
+    @brief Producer: publish elements written in place, count must not exceed reserved one
+*/
+__STATIC_INLINE void my_ring_commit(my_ring_t * p_ring, uint32_t count) {
+
+    /// elements are in memory before consumer sees them
+    __DMB();
+    p_ring->head = p_ring->head + count;
+}
+
+/**
+    @brief Consumer: copy of up to max_count elements, they stay in ring
+    @param[in] offset - count of elements skipped from tail
+    @return count of copied elements
+*/
+__STATIC_INLINE uint32_t my_ring_read(my_ring_t const * p_ring, uint32_t offset, void * p_data, uint32_t max_count) {
+
+    uint32_t tail  = p_ring->tail;
+    uint32_t count = p_ring->head - tail;
+
+    if (offset >= count)
+        return 0;
+    count -= offset;
+    if (count > max_count)
+        count = max_count;
+
+    /// head is read before elements
+    __DMB();
+    my_ring_copy(p_ring, tail + offset, p_data, count, false);
+    return count;
+}
+
+/**
+    @brief Consumer: elements in place, they stay in ring until my_ring_skip()
+    @param[out] spans - the oldest elements in spans[0], wrapped ones in spans[1]
+    @return count of elements in both spans
+*/
+__STATIC_INLINE uint32_t my_ring_peek(my_ring_t const * p_ring, my_ring_span_t spans[2]) {
+
+    uint32_t tail  = p_ring->tail;
+    uint32_t count = p_ring->head - tail;
+    uint32_t pos   = tail & p_ring->mask;
+    uint32_t first = my_ring_size(p_ring) - pos;
+
+    if (first > count)
+        first = count;
+
+    __DMB();
+    spans[0].p_data = &p_ring->p_buf[pos * p_ring->elem_size];
+    spans[0].count  = first;
+    spans[1].p_data = p_ring->p_buf;
+    spans[1].count  = count - first;
+    return count;
+}
+
+/**
+    @brief Consumer: release elements, count must not exceed my_ring_count()
+*/
+__STATIC_INLINE void my_ring_skip(my_ring_t * p_ring, uint32_t count) {
+
+    /// elements are read before producer overwrites them
+    __DMB();
+    p_ring->tail = p_ring->tail + count;
+}
+
+/**
+    @brief Consumer: take up to max_count elements
+    @return count of taken elements
+*/
+__STATIC_INLINE uint32_t my_ring_pop(my_ring_t * p_ring, void * p_data, uint32_t max_count) {
+
+    uint32_t count = my_ring_read(p_ring, 0, p_data, max_count);
+
+    my_ring_skip(p_ring, count);
+    return count;
+}
+
+#endif
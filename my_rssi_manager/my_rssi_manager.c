@@ -1,44 +1,74 @@
 /**
-    @brief This module used to measure rssi. This measuring starts
-    in main.c, after every connect event and stops after disconnect.
+    @brief This module used to measure rssi. This measuring is started
+    by sq-service handler, when central enables notification of RSSI.
     Every change of rssi value begin RSSI_CHANGED_EVENT. 
     This module is the handler for this event.
+    
+    Every link has own buffer of values, buffer is taken by first value
+    of link and released after disconnect. Buffer is ring of the last
+    RSSI_BUFFER_SIZE values (my_ring_manager.h), the oldest value is taken
+    out when ring is full, so average is kept by running sum.
   
 */
 
 /* ==================================================================== */
 /* ========================== include files =========================== */
 /* ==================================================================== */
+#include <stdbool.h>
+#include <string.h>
 #include "my_rssi_manager.h"
+#include "my_ring_manager.h"
+#include "custom_board.h"
 
 /* ==================================================================== */
 /* ============================ constants ============================= */
 /* ==================================================================== */
-#define RSSI_BUFFER_SIZE    64U
+#define RSSI_BUFFER_SIZE    64U     /**< power of 2 */
 
 /* ==================================================================== */
 /* ============================== data ================================ */
 /* ==================================================================== */
-static int8_t rssi_buffer[RSSI_BUFFER_SIZE] = {0x00};
-static uint8_t current_offset = 0x00;
+
+/**
+    @brief Values of one link
+*/
+typedef struct {
+    bool      used;
+    uint16_t  conn_handle;
+    int32_t   sum;                          /**< sum of values in ring */
+    my_ring_t ring;
+    int8_t    rssi_buffer[RSSI_BUFFER_SIZE];
+} rssi_link_t;
+
+static rssi_link_t m_rssi_links[PERIPHERAL_LINK_MAX];
 
 /* ==================================================================== */
 /* ==================== function prototypes =========================== */
 /* ==================================================================== */
 
-static int8_t process_buffer(void);
+static rssi_link_t * link_find(bool used, uint16_t conn_handle);
+static int8_t process_buffer(rssi_link_t const * p_link);
 
-static int8_t process_buffer(void) {
-    
-    int32_t sum = 0x00;
-    uint8_t count_of_non_zero_values = 0x00;
+/**
+    @brief Buffer of link or free buffer (used == false), NULL if it isn't found
+*/
+static rssi_link_t * link_find(bool used, uint16_t conn_handle) {
     
-    for (uint8_t i = 0; i < RSSI_BUFFER_SIZE; i++) {
-        sum += rssi_buffer[i];
-        if (rssi_buffer[i] != 0)
-            count_of_non_zero_values += 1;
+    for (uint8_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        if ( (m_rssi_links[i].used == used)
+              && ((used == false) || (m_rssi_links[i].conn_handle == conn_handle)) )
+            return &m_rssi_links[i];
     }
-    return sum / count_of_non_zero_values;    
+    return NULL;
+}
+
+static int8_t process_buffer(rssi_link_t const * p_link) {
+    
+    uint32_t count = my_ring_count(&p_link->ring);
+    
+    if (count == 0)
+        return 0;
+    return (int8_t)(p_link->sum / (int32_t)count);
 }
 
 /* ==================================================================== */
@@ -46,19 +76,51 @@ static int8_t process_buffer(void) {
 /* ==================================================================== */
 
 /**
-    @brief return average value of rssi buffer
+    @brief return average value of rssi buffer of link, 0 if link has no values
 */
-int8_t my_rssi_get_value(void) {
-    return process_buffer();
+int8_t my_rssi_get_value(uint16_t conn_handle) {
+    
+    rssi_link_t const * p_link = link_find(true, conn_handle);
+    
+    if (p_link == NULL)
+        return 0;
+    return process_buffer(p_link);
+}
+
+/**
+* @brief Add new value to rsi values buffer of link
+*/
+void my_rssi_push_value(uint16_t conn_handle, const int8_t new_value) {
+    
+    rssi_link_t * p_link = link_find(true, conn_handle);
+    
+    if (p_link == NULL) {
+        p_link = link_find(false, 0);
+        if (p_link == NULL)
+            return;
+        memset(p_link, 0, sizeof(rssi_link_t));
+        (void)my_ring_init(&p_link->ring, p_link->rssi_buffer, sizeof(int8_t), RSSI_BUFFER_SIZE);
+        p_link->used        = true;
+        p_link->conn_handle = conn_handle;
+    }
+    
+    /// values are pushed and taken out by the same BLE event handler
+    if (my_ring_free(&p_link->ring) == 0) {
+        int8_t oldest;
+        (void)my_ring_pop(&p_link->ring, &oldest, 1);
+        p_link->sum -= oldest;
+    }
+    (void)my_ring_push(&p_link->ring, &new_value, 1);
+    p_link->sum += new_value;
 }
 
 /**
-* @brief Add new value to rsi values buffer
+    @brief Release buffer of disconnected link
 */
-void my_rssi_push_value(const int8_t new_value) {
-    rssi_buffer[0] = new_value;
-    *(rssi_buffer + current_offset) = new_value;
-    current_offset += 1;
-    if (current_offset == RSSI_BUFFER_SIZE)
-        current_offset = 0;
+void my_rssi_link_remove(uint16_t conn_handle) {
+    
+    rssi_link_t * p_link = link_find(true, conn_handle);
+    
+    if (p_link != NULL)
+        p_link->used = false;
 }
@@ -3,7 +3,8 @@
 
 #include "stdint.h"
 
-int8_t my_rssi_get_value(void);
-void my_rssi_push_value(const int8_t new_value);
+int8_t my_rssi_get_value(uint16_t conn_handle);
+void my_rssi_push_value(uint16_t conn_handle, const int8_t new_value);
+void my_rssi_link_remove(uint16_t conn_handle);
 
 #endif
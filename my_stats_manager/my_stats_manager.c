@@ -0,0 +1,149 @@
+/**
+    @brief Runtime statistics, see my_stats_manager.h
+
+    Counters are incremented by handlers of different priorities, so the
+    increment is exclusive (LDREX/STREX). Every histogram is written only by
+    its handler. Snapshot is copied in critical region.
+
+    Uptime is taken from device timebase of my_time_manager.h at snapshot.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stddef.h>
+#include <string.h>
+#include "my_stats_manager.h"
+#include "nrf.h"
+#include "nordic_common.h"
+#include "app_util_platform.h"
+#include "my_time_manager.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+/// Bucket 0 is below 2^10 cycles: 16 us at 64 MHz
+#define STATS_HIST_FIRST_LOG2   10U
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+#ifdef RUNTIME_STATS
+
+static my_stats_t m_stats;
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Clear statistics
+*/
+uint32_t my_stats_init(void) {
+
+    memset(&m_stats, 0, sizeof(m_stats));
+    m_stats.version       = STATS_VERSION;
+    m_stats.counter_count = STATS_COUNTER_COUNT;
+    m_stats.handler_count = STATS_HANDLER_COUNT;
+    m_stats.bucket_count  = STATS_HIST_BUCKETS;
+
+    return NRF_SUCCESS;
+}
+
+/**
+    @brief Increment counter, it can be called from any priority
+*/
+void my_stats_increment(stats_counter_t counter) {
+
+    volatile uint32_t * p_counter = &m_stats.counters[counter];
+    uint32_t            value;
+
+    do {
+        value = __LDREXW(p_counter);
+    } while (__STREXW(value + 1, p_counter) != 0);
+}
+
+/**
+    @brief Value of gauge, 32-bit write is atomic
+*/
+void my_stats_set(stats_counter_t counter, uint32_t value) {
+    m_stats.counters[counter] = value;
+}
+
+/**
+    @brief Cycles at entry of handler
+*/
+uint32_t my_stats_cycles_get(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+    @brief Count run of handler in bucket of its duration
+    @param[in] handler - measured handler
+    @param[in] enter_cycles - my_stats_cycles_get() at entry of handler
+*/
+void my_stats_latency_record(stats_handler_t handler, uint32_t enter_cycles) {
+
+    uint32_t cycles = DWT->CYCCNT - enter_cycles;
+    uint32_t log2   = 31 - __CLZ(cycles | 1);
+    uint32_t bucket = 0;
+
+    if (log2 >= STATS_HIST_FIRST_LOG2)
+        bucket = MIN(log2 - STATS_HIST_FIRST_LOG2 + 1, STATS_HIST_BUCKETS - 1);
+
+    m_stats.latency[handler][bucket]++;
+}
+
+/**
+    @brief Copy of statistics for read of characteristic
+    @param[out] p_buf - buffer of sizeof(my_stats_t) bytes
+    @return length of value
+*/
+uint16_t my_stats_snapshot(uint8_t * p_buf) {
+
+    uint32_t uptime_s = (uint32_t)(my_time_ticks_get() / TIME_TICKS_PER_S);
+
+    CRITICAL_REGION_ENTER();
+    m_stats.uptime_s = uptime_s;
+    memcpy(p_buf, &m_stats, sizeof(m_stats));
+    CRITICAL_REGION_EXIT();
+
+    return sizeof(m_stats);
+}
+
+#else
+
+uint32_t my_stats_init(void) {
+    return NRF_SUCCESS;
+}
+
+void my_stats_increment(stats_counter_t counter) {
+}
+
+void my_stats_set(stats_counter_t counter, uint32_t value) {
+}
+
+uint32_t my_stats_cycles_get(void) {
+    return 0;
+}
+
+void my_stats_latency_record(stats_handler_t handler, uint32_t enter_cycles) {
+}
+
+/**
+    @brief Statistics are off: header without counters
+*/
+uint16_t my_stats_snapshot(uint8_t * p_buf) {
+
+    my_stats_t stats;
+
+    memset(&stats, 0, sizeof(stats));
+    stats.version = STATS_VERSION;
+    memcpy(p_buf, &stats, offsetof(my_stats_t, counters));
+
+    return offsetof(my_stats_t, counters);
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*!
+    @brief Module of runtime statistics for telemetry without debugger.
+           All counters are in one structure, it is read by central from
+           statistics characteristic of sq-service: read request is
+           authorized by application, which copies structure to reply by one
+           memcpy, so every read is consistent snapshot.
+
+           Layout of value (version 2), little-endian 32-bit words after
+           4-byte header, new counters are only added at the end of arrays:
+               0 - version
+               1 - count of counters (STATS_COUNTER_COUNT)
+               2 - count of handlers (STATS_HANDLER_COUNT)
+               3 - count of buckets of latency histogram
+               4 - uptime, s
+               8 - counters
+               .. latency histograms, buckets of every handler
+
+           Gauges are in array of counters too, they hold the last value.
+
+           Versions:
+               1 - counters up to STATS_COUNTER_CONNECTIONS
+               2 - counters and gauges of flash storage appended, uptime
+                   is device time
+
+           Bucket 0 counts handler runs shorter than 16 us, every next bucket
+           is twice longer, the last one counts all longer runs. Time is
+           measured by DWT cycle counter started by my_boot_start().
+
+           Statistics are compiled in when RUNTIME_STATS is defined in
+           custom_board.h, otherwise macros are empty.
+*/
+
+#ifndef __MY_STATS_MANAGER__
+#define __MY_STATS_MANAGER__
+
+#include <stdint.h>
+#include "custom_board.h"
+
+/**
+    @brief Registry of counters
+*/
+typedef enum {
+    STATS_COUNTER_NOTIFY_SENT = 0,      /**< notifications queued in stack */
+    STATS_COUNTER_NOTIFY_DROPPED,       /**< notifications rejected while client is subscribed */
+    STATS_COUNTER_NO_TX_PACKETS,        /**< rejected because of BLE_ERROR_NO_TX_PACKETS */
+    STATS_COUNTER_RSSI_UPDATES,         /**< reports of changed RSSI */
+    STATS_COUNTER_SAADC_CONVERSIONS,    /**< finished SAADC conversions */
+    STATS_COUNTER_BLE_EVENTS,           /**< all events of stack */
+    STATS_COUNTER_CONNECTIONS,          /**< established connections */
+    STATS_COUNTER_FLASH_WRITES,         /**< finished writes of configuration record */
+    STATS_COUNTER_FLASH_GC,             /**< finished garbage collections of FDS */
+    STATS_COUNTER_FLASH_RETRIES,        /**< FDS operations retried because FDS was busy */
+    STATS_COUNTER_FLASH_WORDS_USED,     /**< gauge: words used in FDS pages, valid and dirty */
+    STATS_COUNTER_FLASH_WORDS_FREEABLE, /**< gauge: words of dirty records, freed by GC */
+    STATS_COUNTER_COUNT
+} stats_counter_t;
+
+/**
+    @brief Handlers with latency histogram
+*/
+typedef enum {
+    STATS_HANDLER_BLE_EVT = 0,          /**< dispatch of BLE event */
+    STATS_HANDLER_SAADC,                /**< SAADC event handler */
+    STATS_HANDLER_ADC_TIMER,            /**< timer of ADC measurement */
+    STATS_HANDLER_INPUT_TIMER,          /**< debounce timer of inputs */
+    STATS_HANDLER_STORAGE_FDS,          /**< FDS event handler */
+    STATS_HANDLER_COUNT
+} stats_handler_t;
+
+#define STATS_VERSION           2U     /**< raised when counters are appended or meaning changes */
+#define STATS_HIST_BUCKETS      8U
+
+/**
+    @brief Statistics, value of characteristic
+*/
+typedef struct {
+    uint8_t  version;                                       /**< STATS_VERSION */
+    uint8_t  counter_count;                                 /**< STATS_COUNTER_COUNT */
+    uint8_t  handler_count;                                 /**< STATS_HANDLER_COUNT */
+    uint8_t  bucket_count;                                  /**< STATS_HIST_BUCKETS */
+    uint32_t uptime_s;                                      /**< device time, see my_time_manager.h */
+    uint32_t counters[STATS_COUNTER_COUNT];
+    uint32_t latency[STATS_HANDLER_COUNT][STATS_HIST_BUCKETS];
+} my_stats_t;
+
+#ifdef RUNTIME_STATS
+
+#define MY_STATS_INC(COUNTER)           my_stats_increment(COUNTER)
+#define MY_STATS_SET(COUNTER, VALUE)    my_stats_set((COUNTER), (VALUE))
+/// Start of measured handler, it declares variable, so it is used once in function
+#define MY_STATS_HANDLER_ENTER()        uint32_t const stats_enter_cycles = my_stats_cycles_get()
+#define MY_STATS_HANDLER_EXIT(HANDLER)  my_stats_latency_record((HANDLER), stats_enter_cycles)
+
+#else
+
+#define MY_STATS_INC(COUNTER)           do { } while (0)
+#define MY_STATS_SET(COUNTER, VALUE)    do { } while (0)
+#define MY_STATS_HANDLER_ENTER()        do { } while (0)
+#define MY_STATS_HANDLER_EXIT(HANDLER)  do { } while (0)
+
+#endif
+
+uint32_t my_stats_init(void);
+
+void my_stats_increment(stats_counter_t counter);
+
+void my_stats_set(stats_counter_t counter, uint32_t value);
+
+uint32_t my_stats_cycles_get(void);
+
+void my_stats_latency_record(stats_handler_t handler, uint32_t enter_cycles);
+
+uint16_t my_stats_snapshot(uint8_t * p_buf);
+
+#endif
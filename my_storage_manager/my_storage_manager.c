@@ -0,0 +1,384 @@
+/**
+    @brief This module used to store output registers and configuration
+    in flash with Flash Data Storage (FDS), shared with peer manager.
+
+    Configuration is kept in RAM, every change only marks it dirty and starts
+    single-shot timer. When timer expires, the newest configuration is
+    written by one FDS operation, so burst of GATT writes costs one flash write.
+    Updates leave dirty records in flash, garbage collection for them is
+    started when there is no connection, so page erase doesn't compete with
+    connection events. GC is started at once only if flash is full, for
+    this module or for peer manager, then SoftDevice puts page erases
+    between radio events.
+
+    FDS is shared with peer manager, so operations can be rejected while
+    its queue is full. Rejected write and GC stay pending and are retried
+    by the delayed write timer and after every FDS event. Usage of flash
+    is counted in runtime statistics.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <string.h>
+#include "my_storage_manager.h"
+#include "fds.h"
+#include "app_error.h"
+#include "my_energy_manager.h"
+#include "my_stats_manager.h"
+#include "my_trace_manager.h"
+
+#define NRF_LOG_MODULE_NAME "STORAGE"
+#include "nrf_log.h"
+#include "nrf_log_ctrl.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define CONFIG_SIZE_WORDS   (sizeof(my_config_t) / sizeof(uint32_t))
+#define RECORD_HEADER_WORDS 3U      /**< header of FDS record, written with data */
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+APP_TIMER_DEF(m_storage_timer_id); /**< timer of delayed write. */
+
+/** @brief actual configuration
+*/
+static my_config_t m_config = {
+    .out_reg1        = STORAGE_DEFAULT_OUT_REG1,
+    .out_reg2        = STORAGE_DEFAULT_OUT_REG2,
+    .adc_interval_ms = STORAGE_DEFAULT_ADC_INTERVAL_MS,
+    .adv_interval_ms = STORAGE_DEFAULT_ADV_INTERVALS_MS,
+    .adv_timeout_s   = STORAGE_DEFAULT_ADV_TIMEOUTS_S,
+};
+
+/** @brief copy of configuration which is written now, FDS uses it until write is finished
+*/
+static my_config_t m_config_flash;
+
+static fds_record_desc_t m_config_desc;                 /**< descriptor of record in flash */
+static my_storage_loaded_handler_t m_loaded_handler = NULL;
+
+static bool    m_fds_ready          = false;    /**< FDS is initialized */
+static bool    m_record_exists      = false;    /**< record is found or written */
+static bool    m_dirty              = false;    /**< configuration is changed after last write */
+static bool    m_timer_active       = false;    /**< delayed write is scheduled */
+static bool    m_write_in_progress  = false;    /**< FDS write/update is queued */
+static bool    m_gc_pending         = false;    /**< GC is needed */
+static bool    m_gc_force           = false;    /**< GC is needed even with connections: flash is full */
+static bool    m_gc_in_progress     = false;    /**< GC is queued */
+static uint8_t m_conn_count         = 0;        /**< count of active connections */
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void storage_fds_evt_handler(fds_evt_t const * const p_evt);
+static void storage_timer_callback(void * p_context);
+static void storage_write_schedule(void);
+static void storage_write(void);
+static void storage_config_load(void);
+static void storage_gc_run(void);
+static void storage_gc_check(void);
+static void storage_stat_update(fds_stat_t * p_stat);
+
+/** @brief Load configuration from flash over default values
+*/
+static void storage_config_load(void) {
+
+    fds_flash_record_t flash_record;
+    fds_find_token_t   token;
+
+    memset(&token, 0, sizeof(token));
+
+    if (fds_record_find(STORAGE_FILE_ID, STORAGE_CONFIG_REC_KEY, &m_config_desc, &token) != FDS_SUCCESS) {
+        NRF_LOG_INFO("no stored configuration, defaults are used\r\n");
+        return;
+    }
+
+    m_record_exists = true;
+
+    if (fds_record_open(&m_config_desc, &flash_record) == FDS_SUCCESS) {
+        /// record of older version is shorter, new fields keep default values
+        uint32_t len = flash_record.p_header->tl.length_words * sizeof(uint32_t);
+        memcpy(&m_config, flash_record.p_data, MIN(len, sizeof(m_config)));
+
+        uint32_t err_code = fds_record_close(&m_config_desc);
+        APP_ERROR_CHECK(err_code);
+
+        NRF_LOG_INFO("configuration restored, out_reg1 = 0x%x\r\n", m_config.out_reg1);
+    }
+}
+
+/** @brief Start timer of delayed write, if it isn't started yet
+*/
+static void storage_write_schedule(void) {
+
+    if (m_timer_active == false) {
+        uint32_t err_code = app_timer_start(m_storage_timer_id, STORAGE_WRITE_DELAY, NULL);
+        APP_ERROR_CHECK(err_code);
+        m_timer_active = true;
+    }
+}
+
+/** @brief Write actual configuration to flash.
+           If FDS is busy, write is done after end of current operation.
+*/
+static void storage_write(void) {
+
+    if ((m_dirty == false) || (m_fds_ready == false) ||
+        m_write_in_progress || m_gc_in_progress)
+        return;
+
+    fds_record_chunk_t chunk;
+    fds_record_t       record;
+    ret_code_t         err_code;
+
+    m_config_flash = m_config;
+
+    chunk.p_data       = &m_config_flash;
+    chunk.length_words = CONFIG_SIZE_WORDS;
+
+    record.file_id         = STORAGE_FILE_ID;
+    record.key             = STORAGE_CONFIG_REC_KEY;
+    record.data.p_chunks   = &chunk;
+    record.data.num_chunks = 1;
+
+    if (m_record_exists)
+        err_code = fds_record_update(&m_config_desc, &record);
+    else
+        err_code = fds_record_write(&m_config_desc, &record);
+
+    switch (err_code)
+    {
+        case FDS_SUCCESS:
+            m_dirty             = false;
+            m_write_in_progress = true;
+            break;
+
+        case FDS_ERR_NO_SPACE_IN_FLASH:
+            /// write again after GC
+            NRF_LOG_WARNING("flash is full, GC is started\r\n");
+            my_storage_gc_request(true);
+            break;
+
+        case FDS_ERR_NO_SPACE_IN_QUEUES:
+        case FDS_ERR_BUSY:
+            /// FDS is used by peer manager - try later
+            MY_STATS_INC(STATS_COUNTER_FLASH_RETRIES);
+            storage_write_schedule();
+            break;
+
+        default:
+            APP_ERROR_CHECK(err_code);
+            break;
+    }
+}
+
+/** @brief Start GC if it is needed, without connections or if flash is full
+*/
+static void storage_gc_run(void) {
+
+    if ((m_gc_pending == false) || m_gc_in_progress || m_write_in_progress || (m_fds_ready == false))
+        return;
+
+    if ((m_conn_count != 0) && (m_gc_force == false))
+        return;     /// GC is started after disconnect
+
+    ret_code_t err_code = fds_gc();
+    if (err_code == FDS_SUCCESS) {
+        m_gc_pending     = false;
+        m_gc_force       = false;
+        m_gc_in_progress = true;
+    } else if ((err_code == FDS_ERR_BUSY) || (err_code == FDS_ERR_NO_SPACE_IN_QUEUES)) {
+        /// GC stays pending, it is started after next FDS event or by timer
+        MY_STATS_INC(STATS_COUNTER_FLASH_RETRIES);
+        storage_write_schedule();
+    } else {
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/** @brief Usage of flash to statistics
+*/
+static void storage_stat_update(fds_stat_t * p_stat) {
+
+    if (fds_stat(p_stat) != FDS_SUCCESS) {
+        memset(p_stat, 0, sizeof(*p_stat));
+        return;
+    }
+    MY_STATS_SET(STATS_COUNTER_FLASH_WORDS_USED, p_stat->words_used);
+    MY_STATS_SET(STATS_COUNTER_FLASH_WORDS_FREEABLE, p_stat->freeable_words);
+}
+
+/** @brief Request GC if there are many dirty records in flash
+*/
+static void storage_gc_check(void) {
+
+    fds_stat_t stat;
+
+    storage_stat_update(&stat);
+    if (stat.dirty_records >= STORAGE_GC_DIRTY_RECORDS) {
+        m_gc_pending = true;
+    }
+    storage_gc_run();
+}
+
+/** @brief Callback of delayed write timer
+*/
+static void storage_timer_callback(void * p_context) {
+
+    UNUSED_PARAMETER(p_context);
+    MY_TRACE_ENTER(TRACE_POINT_STORAGE_TIMER);
+    MY_ENERGY_WAKEUP(ENERGY_FEATURE_STORAGE);
+
+    m_timer_active = false;
+    storage_write();
+    storage_gc_run();
+    MY_TRACE_EXIT(TRACE_POINT_STORAGE_TIMER);
+}
+
+/** @brief Handler of FDS events, there are events of peer manager too
+*/
+static void storage_fds_evt_handler(fds_evt_t const * const p_evt) {
+
+    MY_STATS_HANDLER_ENTER();
+    MY_TRACE_VALUE(TRACE_POINT_STORAGE_FDS, p_evt->id);
+
+    switch (p_evt->id)
+    {
+        case FDS_EVT_INIT:
+            if (p_evt->result == FDS_SUCCESS) {
+                m_fds_ready = true;
+                storage_config_load();
+                if (m_loaded_handler != NULL)
+                    m_loaded_handler(&m_config);
+                if (m_dirty)
+                    storage_write_schedule();
+            }
+            break;
+
+        case FDS_EVT_WRITE:
+        case FDS_EVT_UPDATE:
+            if (p_evt->write.file_id == STORAGE_FILE_ID) {
+                m_write_in_progress = false;
+                if (p_evt->result == FDS_SUCCESS) {
+                    m_record_exists = true;
+                    MY_STATS_INC(STATS_COUNTER_FLASH_WRITES);
+                    MY_ENERGY_FLASH_WRITE(CONFIG_SIZE_WORDS + RECORD_HEADER_WORDS);
+                } else {
+                    /// write again
+                    m_dirty = true;
+                }
+                if (m_dirty)
+                    storage_write_schedule();
+            }
+            storage_gc_check();
+            break;
+
+        case FDS_EVT_GC:
+            m_gc_in_progress = false;
+            if (p_evt->result == FDS_SUCCESS) {
+                MY_STATS_INC(STATS_COUNTER_FLASH_GC);
+                MY_ENERGY_FLASH_GC();
+            }
+            storage_gc_check();
+            /// write could wait for free space
+            storage_write();
+            break;
+
+        default:
+            storage_gc_run();
+            break;
+    }
+    MY_TRACE_EXIT(TRACE_POINT_STORAGE_FDS);
+    MY_STATS_HANDLER_EXIT(STATS_HANDLER_STORAGE_FDS);
+}
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Init storage. Must be called after SoftDevice is enabled and
+           before peer manager, which initializes FDS too.
+    @param[in] loaded_handler - called when configuration is loaded from flash
+*/
+uint32_t my_storage_init(my_storage_loaded_handler_t loaded_handler) {
+
+    STATIC_ASSERT((sizeof(my_config_t) % sizeof(uint32_t)) == 0);
+
+    uint32_t err_code;
+
+    m_loaded_handler = loaded_handler;
+
+    err_code = app_timer_create(&m_storage_timer_id,
+                                APP_TIMER_MODE_SINGLE_SHOT,
+                                storage_timer_callback);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    err_code = fds_register(storage_fds_evt_handler);
+    if (err_code != FDS_SUCCESS)
+        return err_code;
+
+    return fds_init();
+}
+
+/**
+    @brief return actual configuration
+*/
+my_config_t const * my_storage_config_get(void) {
+    return &m_config;
+}
+
+/**
+    @brief Save new configuration, it is written to flash after delay
+*/
+void my_storage_config_save(my_config_t const * p_config) {
+
+    if (memcmp(&m_config, p_config, sizeof(m_config)) == 0)
+        return;
+
+    m_config = *p_config;
+    m_dirty  = true;
+    storage_write_schedule();
+}
+
+/**
+    @brief Event handler to track connections, GC is started without connections
+*/
+void my_storage_on_ble_evt(ble_evt_t * p_ble_evt) {
+
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+            m_conn_count++;
+            break;
+
+        case BLE_GAP_EVT_DISCONNECTED:
+            if (m_conn_count > 0)
+                m_conn_count--;
+            storage_gc_run();
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+    @brief Request GC of FDS, it is shared with peer manager
+    @param[in] force - flash is full: GC is started even with connections,
+                       otherwise it waits for disconnection
+*/
+void my_storage_gc_request(bool force) {
+
+    m_gc_pending = true;
+    if (force)
+        m_gc_force = true;
+    storage_gc_run();
+}
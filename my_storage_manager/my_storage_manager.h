@@ -0,0 +1,65 @@
+/*!
+    @brief Module for storing of output registers and configuration in flash (FDS).
+           All values are stored in one record. Changes are written after delay,
+           so many changes (GATT writes) in short time cost one flash write.
+           Garbage collection is started when there is no active connection,
+           or at once when flash is full. Operations rejected by busy FDS are
+           retried.
+*/
+
+#ifndef __MY_STORAGE_MANAGER__
+#define __MY_STORAGE_MANAGER__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ble.h"
+#include "app_timer.h"
+#include "custom_board.h"
+
+#define STORAGE_FILE_ID             0x5100      /**< FDS file of application, peer manager uses 0xC000 and above */
+#define STORAGE_CONFIG_REC_KEY      0x0001      /**< FDS record of configuration */
+
+/// Delay from first change to write of record, all changes in this time are coalesced
+#define STORAGE_WRITE_DELAY         APP_TIMER_TICKS(2000, APP_TIMER_PRESCALER)
+
+/// GC is requested when count of dirty (replaced) records reaches this value
+#define STORAGE_GC_DIRTY_RECORDS    16
+
+/// Default values of configuration
+#define STORAGE_DEFAULT_OUT_REG1        0x00
+#define STORAGE_DEFAULT_OUT_REG2        0x00
+#define STORAGE_DEFAULT_ADC_INTERVAL_MS 1000
+
+/// Count of phases of advertising schedule, see my_adv_manager.h
+#define STORAGE_ADV_PHASES              4
+/// Default schedule: burst, fast, slow, beacon; beacon lasts until connection
+#define STORAGE_DEFAULT_ADV_INTERVALS_MS    {20, 188, 1000, 5000}
+#define STORAGE_DEFAULT_ADV_TIMEOUTS_S      {10, 170, 600, 0}
+
+/**
+    @brief Stored configuration. New fields must be added to the end,
+           record of older version is loaded over default values.
+           Size must be multiple of 4 bytes (size of FDS word).
+*/
+typedef struct {
+    uint8_t  out_reg1;              /**< Output register 1 */
+    uint8_t  out_reg2;              /**< Output register 2 */
+    uint16_t adc_interval_ms;       /**< Interval of ADC measurements */
+    uint16_t adv_interval_ms[STORAGE_ADV_PHASES];   /**< Advertising interval of every phase */
+    uint16_t adv_timeout_s[STORAGE_ADV_PHASES];     /**< Duration of every phase, 0 - until connection */
+} my_config_t;
+
+/**@brief Handler called when configuration is loaded from flash. */
+typedef void (*my_storage_loaded_handler_t)(my_config_t const * p_config);
+
+uint32_t my_storage_init(my_storage_loaded_handler_t loaded_handler);
+
+my_config_t const * my_storage_config_get(void);
+
+void my_storage_config_save(my_config_t const * p_config);
+
+void my_storage_on_ble_evt(ble_evt_t * p_ble_evt);
+
+void my_storage_gc_request(bool force);
+
+#endif
@@ -0,0 +1,200 @@
+/**
+    @brief Device timebase and sync, see my_time_manager.h
+
+    Ticks are read by handlers of different priorities, so extension of
+    counter is done in critical region. Sync is handled at priority of BLE
+    events only.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <stdbool.h>
+#include <string.h>
+#include "my_time_manager.h"
+#include "nordic_common.h"
+#include "app_util.h"
+#include "app_util_platform.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define TIME_WRAP_INTERVAL      APP_TIMER_TICKS(256000, APP_TIMER_PRESCALER)
+#define TIME_US_PER_S           1000000LL
+#define TIME_PPB                1000000000LL
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+APP_TIMER_DEF(m_time_timer_id);     /**< timer of wraps of RTC1 */
+
+static uint64_t m_ticks = 0;        /**< device ticks at m_last_cnt */
+static uint32_t m_last_cnt = 0;     /**< RTC1 counter at last read */
+
+#ifdef TIME_SYNC
+
+/** @brief The first sync of link, drift is measured from it
+*/
+typedef struct {
+    bool     used;
+    uint16_t conn_handle;
+    uint64_t ticks;                 /**< device ticks */
+    uint64_t central_us;            /**< time of central */
+} time_link_t;
+
+static time_link_t m_time_links[PERIPHERAL_LINK_MAX];
+
+#endif
+
+/* ==================================================================== */
+/* ==================== function prototypes =========================== */
+/* ==================================================================== */
+
+static void time_timer_callback(void * p_context);
+#ifdef TIME_SYNC
+static time_link_t * time_link_find(bool used, uint16_t conn_handle);
+#endif
+
+/** @brief Callback of wrap timer, ticks are updated by read
+*/
+static void time_timer_callback(void * p_context) {
+
+    UNUSED_PARAMETER(p_context);
+    (void)my_time_ticks_get();
+}
+
+#ifdef TIME_SYNC
+
+/**
+    @brief Sync of link or free entry (used == false), NULL if it isn't found
+*/
+static time_link_t * time_link_find(bool used, uint16_t conn_handle) {
+
+    for (uint8_t i = 0; i < PERIPHERAL_LINK_MAX; i++) {
+        if ( (m_time_links[i].used == used)
+              && ((used == false) || (m_time_links[i].conn_handle == conn_handle)) )
+            return &m_time_links[i];
+    }
+    return NULL;
+}
+
+#endif
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Start of timebase, app_timer must be initialized
+*/
+uint32_t my_time_init(void) {
+
+    uint32_t err_code;
+
+    m_ticks = 0;
+    (void)app_timer_cnt_get(&m_last_cnt);
+
+    err_code = app_timer_create(&m_time_timer_id, APP_TIMER_MODE_REPEATED, time_timer_callback);
+    if (err_code != NRF_SUCCESS)
+        return err_code;
+
+    return app_timer_start(m_time_timer_id, TIME_WRAP_INTERVAL, NULL);
+}
+
+/**
+    @brief Device time, it can be called from any priority
+    @return ticks from my_time_init()
+*/
+uint64_t my_time_ticks_get(void) {
+
+    uint32_t now;
+    uint32_t diff;
+    uint64_t ticks;
+
+    CRITICAL_REGION_ENTER();
+    (void)app_timer_cnt_get(&now);
+    (void)app_timer_cnt_diff_compute(now, m_last_cnt, &diff);
+    m_last_cnt = now;
+    m_ticks   += diff;
+    ticks      = m_ticks;
+    CRITICAL_REGION_EXIT();
+
+    return ticks;
+}
+
+#ifdef TIME_SYNC
+
+/**
+    @brief Stamp of sample, TIME_STAMP_SIZE bytes
+*/
+void my_time_stamp_put(uint8_t * p_out, uint64_t ticks) {
+
+    p_out[0] = (uint8_t)(ticks);
+    p_out[1] = (uint8_t)(ticks >> 8);
+    p_out[2] = (uint8_t)(ticks >> 16);
+}
+
+/**
+    @brief Sync written by central
+    @param[in] conn_handle - link of central
+    @param[in] p_write - time of central, TIME_SYNC_WRITE_LEN bytes
+    @param[out] p_reply - buffer of TIME_SYNC_REPLY_LEN bytes
+    @return length of reply
+*/
+uint16_t my_time_sync(uint16_t conn_handle, uint8_t const * p_write, uint8_t * p_reply) {
+
+    uint64_t      ticks = my_time_ticks_get();
+    uint64_t      central_us = uint32_decode(p_write) | ((uint64_t)uint32_decode(p_write + 4) << 32);
+    int32_t       drift_ppb = 0;
+    time_link_t * p_link = time_link_find(true, conn_handle);
+
+    if (p_link == NULL) {
+        p_link = time_link_find(false, 0);
+        if (p_link != NULL) {
+            p_link->used        = true;
+            p_link->conn_handle = conn_handle;
+            p_link->ticks       = ticks;
+            p_link->central_us  = central_us;
+        }
+    } else if ((ticks - p_link->ticks) >= (uint64_t)TIME_DRIFT_MIN_S * TIME_TICKS_PER_S) {
+        int64_t device_us  = (int64_t)((ticks - p_link->ticks) * TIME_US_PER_S / TIME_TICKS_PER_S);
+        int64_t central_d  = (int64_t)(central_us - p_link->central_us);
+        if (central_d > 0) {
+            int64_t drift = (device_us - central_d) * TIME_PPB / central_d;
+            drift_ppb     = (int32_t)MAX(MIN(drift, INT32_MAX), INT32_MIN);
+        }
+    }
+
+    (void)uint32_encode((uint32_t)ticks, &p_reply[0]);
+    (void)uint32_encode((uint32_t)(ticks >> 32), &p_reply[4]);
+    memcpy(&p_reply[8], p_write, TIME_SYNC_WRITE_LEN);
+    (void)uint32_encode((uint32_t)drift_ppb, &p_reply[16]);
+
+    return TIME_SYNC_REPLY_LEN;
+}
+
+/**
+    @brief Drift of next central is measured from its own first sync
+*/
+void my_time_link_remove(uint16_t conn_handle) {
+
+    time_link_t * p_link = time_link_find(true, conn_handle);
+    if (p_link != NULL)
+        p_link->used = false;
+}
+
+#else
+
+void my_time_stamp_put(uint8_t * p_out, uint64_t ticks) {
+}
+
+uint16_t my_time_sync(uint16_t conn_handle, uint8_t const * p_write, uint8_t * p_reply) {
+    return 0;
+}
+
+void my_time_link_remove(uint16_t conn_handle) {
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*!
+    @brief Module of device timebase and its sync with centrals.
+           Time of device is RTC1 tick (TIME_TICKS_PER_S) extended to 64 bits
+           from start of app_timer. 24-bit RTC1 wraps after 512 s, timer of
+           this module adds elapsed ticks every 256 s and at every read.
+
+           Samples of sq-service (ADC, RSSI, input events) carry stamp: low
+           24 bits of device ticks, little-endian. Central expands stamp by
+           device ticks of the last sync: delta = (stamp - sync) mod 2^24, it
+           is valid for samples up to 256 s around sync.
+
+           Sync by time sync characteristic of sq-service:
+               central writes its time, us, 8 bytes little-endian;
+               device replies by value, it is notified to this central:
+                   0..7   - device ticks at reception of write
+                   8..15  - time of central from write
+                   16..19 - drift of device against central, ppb, signed,
+                            from the first sync of link, 0 before
+                            TIME_DRIFT_MIN_S
+           Device ticks correspond to central time between written time and
+           reception of reply, so central takes offset from the shortest
+           round trip. Error of drift is jitter of write latency divided by
+           time from the first sync.
+
+           Sync and stamps are compiled in when TIME_SYNC is defined in
+           custom_board.h, otherwise samples are sent without stamps.
+*/
+
+#ifndef __MY_TIME_MANAGER__
+#define __MY_TIME_MANAGER__
+
+#include <stdint.h>
+#include "app_timer.h"
+#include "custom_board.h"
+
+#define TIME_TICKS_PER_S        (APP_TIMER_CLOCK_FREQ / (APP_TIMER_PRESCALER + 1))
+#define TIME_SYNC_WRITE_LEN     8U
+#define TIME_SYNC_REPLY_LEN     20U
+/// Drift is reported after this time from the first sync of link
+#define TIME_DRIFT_MIN_S        10U
+
+#ifdef TIME_SYNC
+#define TIME_STAMP_SIZE         3U
+#else
+#define TIME_STAMP_SIZE         0U
+#endif
+
+uint32_t my_time_init(void);
+
+uint64_t my_time_ticks_get(void);
+
+void my_time_stamp_put(uint8_t * p_out, uint64_t ticks);
+
+uint16_t my_time_sync(uint16_t conn_handle, uint8_t const * p_write, uint8_t * p_reply);
+
+void my_time_link_remove(uint16_t conn_handle);
+
+#endif
@@ -0,0 +1,194 @@
+/**
+    @brief Event trace in retained RAM, see my_trace_manager.h
+
+    Index of ring is free running, it is moved by LDREX/STREX, so writer
+    interrupted by other writer just takes next slot. Record costs one read
+    of RTC1 counter, exclusive increment and two stores.
+
+    my_trace_init() is called before any other init: trace of previous run
+    is copied to diagnostic value, then ring is cleared for this boot. After
+    power-on content of retained RAM is random, ring is valid only with magic.
+
+    Fault handlers of SDK (app_error_weak.c, hardfault_implementation.c) are
+    replaced: reason of fault is recorded before reset.
+*/
+
+/* ==================================================================== */
+/* ========================== include files =========================== */
+/* ==================================================================== */
+#include <string.h>
+#include "my_trace_manager.h"
+#include "retained_ram.h"
+#include "sq_service.h"
+#include "nrf.h"
+#include "app_error.h"
+#include "app_timer.h"
+#include "app_util.h"
+#include "hardfault.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define TRACE_RECORD_MASK       (TRACE_RECORD_COUNT - 1U)
+#define TRACE_TICKS_MASK        0x00FFFFFFU
+#define TRACE_TYPE_POS          24U
+
+/* ==================================================================== */
+/* ============================== data ================================ */
+/* ==================================================================== */
+
+#ifdef EVENT_TRACE
+
+/**
+    @brief Ring of records, it isn't cleared by reset
+*/
+typedef struct {
+    uint32_t          magic;                            /**< RETAINED_RAM_MAGIC_TRACE if ring is valid */
+    volatile uint32_t index;                            /**< free running index of next record */
+    uint32_t          records[TRACE_RECORD_COUNT][2];
+} trace_ring_t;
+
+static trace_ring_t m_trace RETAINED_RAM;
+
+/** @brief Trace of previous run, value of diagnostic characteristic
+*/
+static uint8_t  m_trace_diag[TRACE_DIAG_LEN];
+static uint16_t m_trace_diag_len = 0;
+
+/* ==================================================================== */
+/* ============================ functions ============================= */
+/* ==================================================================== */
+
+/**
+    @brief Expose trace of previous run and start new trace,
+           must be called first in main(), before any record
+    @param[in] reset_reason - RESETREAS of this boot
+*/
+void my_trace_init(uint32_t reset_reason) {
+
+    STATIC_ASSERT(TRACE_DIAG_LEN <= SQS_TRACE_DIAG_MAX_LEN);
+
+    if (m_trace.magic != RETAINED_RAM_MAGIC_TRACE) {
+        memset(&m_trace, 0, sizeof(m_trace));
+        m_trace.magic = RETAINED_RAM_MAGIC_TRACE;
+    }
+
+    m_trace_diag_len = my_trace_encode(m_trace_diag);
+
+    m_trace.index = 0;
+    my_trace_record(TRACE_TYPE_BOOT, reset_reason);
+}
+
+/**
+    @brief Add record to ring, the oldest record is overwritten
+    @param[in] type - type of record
+    @param[in] value - id and value (TRACE_WORD) or raw value
+*/
+void my_trace_record(trace_type_t type, uint32_t value) {
+
+    uint32_t ticks;
+    uint32_t index;
+
+    (void)app_timer_cnt_get(&ticks);
+
+    do {
+        index = __LDREXW(&m_trace.index);
+    } while (__STREXW(index + 1, &m_trace.index) != 0);
+
+    uint32_t * p_record = m_trace.records[index & TRACE_RECORD_MASK];
+    p_record[0] = (ticks & TRACE_TICKS_MASK) | ((uint32_t)type << TRACE_TYPE_POS);
+    p_record[1] = value;
+}
+
+/**
+    @brief Encode ring, the newest records from the oldest one
+    @param[out] p_buf - buffer of TRACE_DIAG_LEN bytes
+    @return length of encoded data
+*/
+uint16_t my_trace_encode(uint8_t * p_buf) {
+
+    uint32_t index = m_trace.index;
+    uint32_t count = (index < TRACE_RECORD_COUNT - 1) ? index : (TRACE_RECORD_COUNT - 1);
+    uint16_t len = 0;
+
+    p_buf[len++] = TRACE_DIAG_VERSION;
+    p_buf[len++] = (uint8_t)count;
+    len += uint16_encode(0, &p_buf[len]);
+    len += uint32_encode(index, &p_buf[len]);
+
+    for (uint32_t i = index - count; i != index; i++) {
+        len += uint32_encode(m_trace.records[i & TRACE_RECORD_MASK][0], &p_buf[len]);
+        len += uint32_encode(m_trace.records[i & TRACE_RECORD_MASK][1], &p_buf[len]);
+    }
+    return len;
+}
+
+/**
+    @brief Trace of previous run encoded by my_trace_init()
+    @param[out] pp_data - pointer to value, it stays valid
+    @return length of value
+*/
+uint16_t my_trace_diag_get(uint8_t ** pp_data) {
+
+    *pp_data = m_trace_diag;
+    return m_trace_diag_len;
+}
+
+/**
+    @brief Error handler of application (APP_ERROR_CHECK), replaces weak
+           handler of SDK: error is recorded, then system is reset
+*/
+void app_error_fault_handler(uint32_t id, uint32_t pc, uint32_t info) {
+
+    if (id == NRF_FAULT_ID_SDK_ERROR) {
+        error_info_t const * p_info = (error_info_t const *)(uintptr_t)info;
+        my_trace_record(TRACE_TYPE_ERROR, TRACE_WORD(p_info->line_num, p_info->err_code));
+        my_trace_record(TRACE_TYPE_ERROR_FILE, (uint32_t)(uintptr_t)p_info->p_file_name);
+    } else {
+        /// assert of SDK or fault of SoftDevice: id instead of error code
+        my_trace_record(TRACE_TYPE_ERROR, TRACE_WORD(0, id));
+        my_trace_record(TRACE_TYPE_FAULT_PC, pc);
+    }
+
+#ifndef DEBUG
+    NVIC_SystemReset();
+#else
+    app_error_save_and_stop(id, pc, info);
+#endif
+}
+
+/**
+    @brief Hard fault handler of hardfault library, replaces weak handler
+    @param[in] p_stack - stacked registers, NULL if stack pointer was invalid
+*/
+void HardFault_process(HardFault_stack_t * p_stack) {
+
+    if (p_stack != NULL) {
+        my_trace_record(TRACE_TYPE_FAULT_PC, p_stack->pc);
+        my_trace_record(TRACE_TYPE_FAULT_LR, p_stack->lr);
+    }
+    my_trace_record(TRACE_TYPE_FAULT_CFSR, SCB->CFSR);
+
+    NVIC_SystemReset();
+}
+
+#else
+
+void my_trace_init(uint32_t reset_reason) {
+}
+
+void my_trace_record(trace_type_t type, uint32_t value) {
+}
+
+uint16_t my_trace_encode(uint8_t * p_buf) {
+    return 0;
+}
+
+uint16_t my_trace_diag_get(uint8_t ** pp_data) {
+
+    *pp_data = NULL;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*!
+    @brief Module of event trace for post-mortem analysis. Fixed ring of
+           64 records in retained RAM keeps last BLE events, entry and exit
+           of hot handlers and key values. Ring survives soft reset, so after
+           reset from app_error_fault_handler or HardFault_process (they add
+           error or fault record and reset) trace of previous run is exposed
+           by diagnostic characteristic of sq-service and decoded by host
+           tool (host/trace).
+
+           Format of record, two 32-bit words:
+               0 - bits 0..23 RTC1 ticks, bits 24..31 type (trace_type_t)
+               1 - bits 16..31 id, bits 0..15 value, or 32-bit value
+                   for types with raw value
+
+           Record takes slot by exclusive access of index and stores two
+           words, handlers of any priority can record without lock.
+
+           Trace is compiled in when EVENT_TRACE is defined in
+           custom_board.h, otherwise macros are empty.
+*/
+
+#ifndef __MY_TRACE_MANAGER__
+#define __MY_TRACE_MANAGER__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "custom_board.h"
+
+/**
+    @brief Types of records
+*/
+typedef enum {
+    TRACE_TYPE_BOOT = 1,        /**< raw value: RESETREAS of this boot */
+    TRACE_TYPE_BLE_EVT,         /**< id: event ID, value: connection handle */
+    TRACE_TYPE_ENTER,           /**< id: trace point */
+    TRACE_TYPE_EXIT,            /**< id: trace point */
+    TRACE_TYPE_VALUE,           /**< id: trace point, value: 16-bit value */
+    TRACE_TYPE_ERROR,           /**< id: line, value: error code */
+    TRACE_TYPE_ERROR_FILE,      /**< raw value: address of file name of error */
+    TRACE_TYPE_FAULT_PC,        /**< raw value: stacked PC of hard fault */
+    TRACE_TYPE_FAULT_LR,        /**< raw value: stacked LR of hard fault */
+    TRACE_TYPE_FAULT_CFSR,      /**< raw value: configurable fault status register */
+} trace_type_t;
+
+/**
+    @brief Trace points of handlers and values
+*/
+typedef enum {
+    TRACE_POINT_BLE_DISPATCH = 1,   /**< dispatch of BLE event */
+    TRACE_POINT_SAADC,              /**< SAADC event handler */
+    TRACE_POINT_ADC_TIMER,          /**< timer of ADC measurement */
+    TRACE_POINT_LED_TIMER,          /**< timer of LED blinking */
+    TRACE_POINT_INPUT_GPIOTE,       /**< GPIOTE handler of inputs */
+    TRACE_POINT_INPUT_TIMER,        /**< debounce timer of inputs */
+    TRACE_POINT_STORAGE_TIMER,      /**< delayed write timer */
+    TRACE_POINT_STORAGE_FDS,        /**< FDS event handler, value: event ID */
+    TRACE_POINT_RSSI_START,         /**< value: result of sd_ble_gap_rssi_start */
+    TRACE_POINT_RSSI_STOP,          /**< value: result of sd_ble_gap_rssi_stop */
+    TRACE_POINT_OUT_REG1,           /**< value: written output register 1 */
+    TRACE_POINT_ADC_MV,             /**< value: measured ADC voltage, mV */
+    TRACE_POINT_TX_POWER,           /**< value: set TX power, dBm */
+} trace_point_t;
+
+#define TRACE_RECORD_COUNT      64U         /**< size of ring, power of 2 */
+#define TRACE_DIAG_VERSION      1U
+#define TRACE_DIAG_HEADER_LEN   8U          /**< version, count, reserved, index */
+#define TRACE_DIAG_RECORD_LEN   8U
+/// Diagnostic value holds all records except the oldest one
+#define TRACE_DIAG_LEN          (TRACE_DIAG_HEADER_LEN + (TRACE_RECORD_COUNT - 1) * TRACE_DIAG_RECORD_LEN)
+
+#define TRACE_WORD(ID, VALUE)   ((((uint32_t)(ID) & 0xFFFF) << 16) | ((uint32_t)(VALUE) & 0xFFFF))
+
+#ifdef EVENT_TRACE
+
+#define MY_TRACE_BLE_EVT(EVT_ID, CONN_HANDLE) \
+    my_trace_record(TRACE_TYPE_BLE_EVT, TRACE_WORD(EVT_ID, CONN_HANDLE))
+#define MY_TRACE_ENTER(POINT)           my_trace_record(TRACE_TYPE_ENTER, TRACE_WORD(POINT, 0))
+#define MY_TRACE_EXIT(POINT)            my_trace_record(TRACE_TYPE_EXIT, TRACE_WORD(POINT, 0))
+#define MY_TRACE_VALUE(POINT, VALUE)    my_trace_record(TRACE_TYPE_VALUE, TRACE_WORD(POINT, VALUE))
+
+#else
+
+#define MY_TRACE_BLE_EVT(EVT_ID, CONN_HANDLE)   do { } while (0)
+#define MY_TRACE_ENTER(POINT)                   do { } while (0)
+#define MY_TRACE_EXIT(POINT)                    do { } while (0)
+#define MY_TRACE_VALUE(POINT, VALUE)            do { } while (0)
+
+#endif
+
+void my_trace_init(uint32_t reset_reason);
+
+void my_trace_record(trace_type_t type, uint32_t value);
+
+uint16_t my_trace_encode(uint8_t * p_buf);
+
+uint16_t my_trace_diag_get(uint8_t ** pp_data);
+
+#endif
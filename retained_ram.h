@@ -0,0 +1,36 @@
+/*
+    File to define variables in retained RAM.
+    Such variables are not initialized by startup code, so they keep value
+    after soft reset, watchdog reset and reset from fault handler.
+    After power-on value is random - every user must check it (magic, checksum).
+*/
+
+#ifndef __RETAINED_RAM__
+#define __RETAINED_RAM__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__CC_ARM)
+    /// Keil: section is placed in UNINIT execution region of ble_app_template_pca10056_s132.sct
+    #define RETAINED_RAM    __attribute__((section(".noinit"), zero_init))
+#elif defined(__ICCARM__)
+    /// IAR: .noinit is "do not initialize" in ble_app_template_iar_nRF5x.icf
+    #define RETAINED_RAM    __no_init
+#elif defined(__GNUC__)
+    /// GCC: .noinit is NOLOAD section in ble_app_template_gcc_nrf52.ld
+    #define RETAINED_RAM    __attribute__((section(".noinit")))
+#else
+    #define RETAINED_RAM
+#endif
+
+/// Magic values of retained structures
+#define RETAINED_RAM_MAGIC_BOOT     0x424F4F54      /**< "BOOT" */
+#define RETAINED_RAM_MAGIC_TRACE    0x54524143      /**< "TRAC" */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
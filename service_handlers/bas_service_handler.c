@@ -6,10 +6,10 @@
 #include "app_timer.h"
 
 #include "custom_board.h"
+#include "my_adc_manager.h"
 
 
 static ble_bas_t m_bas;                                   /**< Structure used to identify the battery service. */    
-APP_TIMER_DEF(m_battery_timer_id);                        /**< Timer to send notifications of BAS service. */
 
 
 /* ==================================================================== */
@@ -32,13 +32,13 @@ static void on_bas_evt(ble_bas_t * p_bas, ble_bas_evt_t * p_evt) {
     switch (p_evt->evt_type)
     {
         case BLE_BAS_EVT_NOTIFICATION_ENABLED:
-            // Start battery timer
-            err_code = app_timer_start(m_battery_timer_id, BATTERY_LEVEL_MEAS_INTERVAL, NULL);
+            /// battery level is measured by ADC timer with interval of BAS
+            err_code = my_adc_consumer_set(ADC_CONSUMER_BAS, true);
             APP_ERROR_CHECK(err_code);
             break; // BLE_BAS_EVT_NOTIFICATION_ENABLED
 
         case BLE_BAS_EVT_NOTIFICATION_DISABLED:
-            err_code = app_timer_stop(m_battery_timer_id);
+            err_code = my_adc_consumer_set(ADC_CONSUMER_BAS, false);
             APP_ERROR_CHECK(err_code);
             break; // BLE_BAS_EVT_NOTIFICATION_DISABLED
 
@@ -75,6 +75,13 @@ uint32_t bas_service_init() {
 }
 
 void bas_on_ble_evt(ble_evt_t * p_ble_evt) {
+    
+    /// BAS doesn't report disabled notification, when its link is gone
+    if ((p_ble_evt->header.evt_id == BLE_GAP_EVT_DISCONNECTED) &&
+        (p_ble_evt->evt.gap_evt.conn_handle == m_bas.conn_handle)) {
+        uint32_t err_code = my_adc_consumer_set(ADC_CONSUMER_BAS, false);
+        APP_ERROR_CHECK(err_code);
+    }
     ble_bas_on_ble_evt(&m_bas, p_ble_evt);  
 }
 
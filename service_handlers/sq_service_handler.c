@@ -8,6 +8,20 @@
 
 #include <string.h>
 #include "sq_service_handler.h"
+#include "my_storage_manager.h"
+#include "my_input_manager.h"
+#include "my_trace_manager.h"
+#include "my_adc_manager.h"
+#include "my_time_manager.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
+
+/* ==================================================================== */
+/* ============================ constants ============================= */
+/* ==================================================================== */
+
+#define INPUT_EVT_FIFO_SIZE     32U     /**< Count of input events stored until they are sent, power of two */
+#define INPUT_EVT_FIFO_MASK     (INPUT_EVT_FIFO_SIZE - 1)
 
 /* ==================================================================== */
 /* ============================== data ================================ */
@@ -15,20 +29,152 @@
 
 static ble_sq_t m_sqs;   /**< Structure used to identify the custom (sq_) service. */
 
+/**
+    @brief One transition of input register
+*/
+typedef struct {
+    uint32_t ticks;         /**< RTC1 counter value at detection */
+    uint8_t  input_reg;     /**< value of input register after transition */
+    uint8_t  event;         /**< code of event - @ref SQ_INPUT_EVT_CODE */
+} sq_input_evt_t;
+
+/** @brief FIFO of input events, which are not sent yet.
+           Every link has own tail (ble_sq_link_t), sequence number of event is
+           low byte of its index. Overflow drops the oldest event, central see it
+           by gap in sequence numbers.
+*/
+static sq_input_evt_t m_input_evt_fifo[INPUT_EVT_FIFO_SIZE];
+static uint32_t       m_input_evt_head = 0;     /**< index of next pushed event */
+static uint32_t       m_input_evt_base = 0;     /**< tail of new link: first event not sent to some link */
+
 
 /* ==================================================================== */
 /* ==================== function prototypes =========================== */
 /* ==================================================================== */
 
 static void on_sq_evt(ble_sq_t * p_bas, ble_sq_evt_t * p_evt);
+static uint32_t input_evt_tail_get(ble_sq_link_t const * p_link);
+static void input_evt_base_update(void);
+static void input_events_link_flush(ble_sq_link_t * p_link);
 
 /**
-    @brief Event handler for sq-service
+    @brief Event handler for sq-service: producers run only for subscribed centrals
 */
 static void on_sq_evt(ble_sq_t * p_bas, ble_sq_evt_t * p_evt) {
     
-    /// There are no special events of this service to handle it
+    uint32_t err_code;
+    bool     enabled = (p_evt->evt_type == BLE_SQ_EVT_NOTIFICATION_ENABLED);
+    
+    switch (p_evt->notify_char)
+    {
+        case SQS_NOTIFY_ADC:
+            /// ADC value is measured only while somebody is subscribed
+            err_code = my_adc_consumer_set(ADC_CONSUMER_SQS, sqs_notify_count(p_bas, SQS_NOTIFY_ADC) != 0);
+            APP_ERROR_CHECK(err_code);
+            break;
+        
+        case SQS_NOTIFY_RSSI:
+#ifdef TX_POWER_CONTROL
+            /// RSSI is measured on every link for control of TX power, see my_link_manager.h
+            break;
+#else
+            /// RSSI is measured only for link, which gets it
+            if (enabled) {
+                err_code = sd_ble_gap_rssi_start(p_evt->conn_handle, 0, 0);
+                MY_TRACE_VALUE(TRACE_POINT_RSSI_START, err_code);
+                APP_ERROR_CHECK(err_code);
+            } else {
+                /// link could be already gone, then SoftDevice rejects handle
+                err_code = sd_ble_gap_rssi_stop(p_evt->conn_handle);
+                MY_TRACE_VALUE(TRACE_POINT_RSSI_STOP, err_code);
+                if (err_code != BLE_ERROR_INVALID_CONN_HANDLE)
+                    APP_ERROR_CHECK(err_code);
+            }
+            break;
+#endif
+        
+        case SQS_NOTIFY_IN_EVT:
+            if (enabled) {
+                ble_sq_link_t * p_link = sqs_link_get(p_bas, p_evt->conn_handle);
+                if (p_link != NULL)
+                    input_events_link_flush(p_link);
+            }
+            break;
+        
+        default:
+            break;
+    }
+}
+
+/**
+    @brief Tail of link, events overwritten by overflow are skipped
+*/
+static uint32_t input_evt_tail_get(ble_sq_link_t const * p_link) {
+    
+    if ((m_input_evt_head - p_link->input_evt_tail) > INPUT_EVT_FIFO_SIZE)
+        return m_input_evt_head - INPUT_EVT_FIFO_SIZE;
+    return p_link->input_evt_tail;
+}
+
+/**
+    @brief Base is the oldest tail of links, it stays when there are no links,
+           so events of offline time are sent to next central
+*/
+static void input_evt_base_update(void) {
+    
+    if (m_sqs.link_count == 0)
+        return;
+    
+    CRITICAL_REGION_ENTER();
+    uint32_t base = input_evt_tail_get(&m_sqs.links[0]);
+    for (uint8_t i = 1; i < m_sqs.link_count; i++) {
+        uint32_t tail = input_evt_tail_get(&m_sqs.links[i]);
+        if ((int32_t)(tail - base) < 0)
+            base = tail;
+    }
+    m_input_evt_base = base;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+    @brief Send stored input events to one link, several events in one notification.
+           Events stay in FIFO until the stack accepts notification with them.
+*/
+static void input_events_link_flush(ble_sq_link_t * p_link) {
+    
+    uint8_t  packet[SQS_INPUT_EVT_MAX_LEN];
+    uint32_t err_code = NRF_SUCCESS;
     
+    while (err_code == NRF_SUCCESS) {
+        
+        uint32_t tail;
+        uint32_t count;
+        
+        CRITICAL_REGION_ENTER();
+        tail  = input_evt_tail_get(p_link);
+        count = MIN(m_input_evt_head - tail, SQS_INPUT_EVT_MAX_COUNT);
+        packet[0] = (uint8_t)tail;
+        for (uint32_t i = 0; i < count; i++) {
+            sq_input_evt_t const * p_evt = &m_input_evt_fifo[(tail + i) & INPUT_EVT_FIFO_MASK];
+            uint8_t * p_out = &packet[1 + i * SQS_INPUT_EVT_SIZE];
+            p_out[0] = (uint8_t)(p_evt->ticks);
+            p_out[1] = (uint8_t)(p_evt->ticks >> 8);
+            p_out[2] = (uint8_t)(p_evt->ticks >> 16);
+            p_out[3] = p_evt->input_reg;
+            p_out[4] = p_evt->event;
+        }
+        CRITICAL_REGION_EXIT();
+        
+        if (count == 0)
+            break;
+        
+        err_code = sqs_send_input_events(&m_sqs, p_link->conn_handle, packet,
+                                         (uint16_t)(1 + count * SQS_INPUT_EVT_SIZE));
+        if (err_code == NRF_SUCCESS) {
+            /// events dropped by overflow while notification was sent are skipped by next get
+            p_link->input_evt_tail = tail + count;
+        }
+    }
 }
 
 /* ==================================================================== */
@@ -45,11 +191,17 @@ uint32_t sq_service_init(void) {
     ble_sq_init_t    sqs_init;    
     memset(&sqs_init, 0, sizeof(ble_sq_init_t));
     
+    /// output registers are restored from flash, others are actual values
+    my_config_t const * p_config = my_storage_config_get();
+    
     sqs_init.evt_handler = on_sq_evt;
-    sqs_init.in_reg_value   = 0xCC;
-    sqs_init.out_reg1_value = 0xAA;
-    sqs_init.out_reg2_value = 0xBB;
-    sqs_init.rssi_reg_value = 0xDD;
+    sqs_init.in_reg_value   = my_input_get_reg();
+    sqs_init.out_reg1_value = p_config->out_reg1;
+    sqs_init.out_reg2_value = p_config->out_reg2;
+    sqs_init.adc_reg_value  = 0x0000;
+    sqs_init.adc_interval_value = p_config->adc_interval_ms;
+    sqs_init.rssi_reg_value = 0x00;
+    sqs_init.trace_diag_len = my_trace_diag_get(&sqs_init.p_trace_diag);
 
     err_code = ble_sqs_init(&m_sqs, &sqs_init);
     
@@ -61,14 +213,57 @@ uint32_t sq_service_init(void) {
     @brief BLE-event handler of sq-service
 */
 void sq_on_ble_evt(ble_evt_t * p_ble_evt) {
+    
+    /// events not sent to disconnected link are kept for next central
+    if (p_ble_evt->header.evt_id == BLE_GAP_EVT_DISCONNECTED)
+        input_evt_base_update();
+    
     ble_sqs_on_ble_evt(&m_sqs, p_ble_evt);    
+    
+    switch (p_ble_evt->header.evt_id)
+    {
+        case BLE_GAP_EVT_CONNECTED:
+        {
+            ble_sq_link_t * p_link = sqs_link_get(&m_sqs, p_ble_evt->evt.gap_evt.conn_handle);
+            if (p_link != NULL)
+                p_link->input_evt_tail = m_input_evt_base;
+            break;
+        }
+        
+        case BLE_EVT_TX_COMPLETE:
+        {
+            /// buffers of this link are free, pending values are already resent by service
+            ble_sq_link_t * p_link = sqs_link_get(&m_sqs, p_ble_evt->evt.common_evt.conn_handle);
+            if (p_link != NULL)
+                input_events_link_flush(p_link);
+            break;
+        }
+        
+        default:
+            break;
+    }
+}
+
+/**
+    @brief Callback to update output register 1 in database, e.g. after restore from flash
+*/
+uint32_t sq_service_update_out_reg1_value(const uint8_t new_value) {
+    return sqs_update_out_reg1_characteristic(&m_sqs, new_value);
+}
+
+/**
+    @brief Callback to update ADC interval in database, e.g. after restore from flash
+*/
+uint32_t sq_service_update_adc_interval_value(const uint16_t interval_ms) {
+    return sqs_update_adc_interval_characteristic(&m_sqs, interval_ms);
 }
 
 /**
     @brief Callback to update adc value characteristic in database
 */
 uint32_t sq_service_update_adc_characteristic(const uint16_t adc_value) {
-    return sqs_update_adc_characteristic(&m_sqs, adc_value);
+    /// value is converted in handler of SAADC, so it is stamped now
+    return sqs_update_adc_characteristic(&m_sqs, adc_value, my_time_ticks_get());
 }
 
 /**
@@ -80,9 +275,48 @@ uint32_t sq_service_update_input_characteristic(uint8_t new_value) {
 
 /**
     @brief Callback to update rssi value characteristic in database
+    @param[in] conn_handle - link, which rssi is measured
+    @param[in] rssi_val - filtered rssi of link
 */
-uint32_t sq_service_update_rssi_value(const int8_t rssi_val) {
+uint32_t sq_service_update_rssi_value(uint16_t conn_handle, const int8_t rssi_val) {
     uint8_t val = (uint8_t)rssi_val;
-    return sqs_update_rssi_characteristic(&m_sqs, val);        
+    return sqs_update_rssi_characteristic(&m_sqs, conn_handle, val, my_time_ticks_get());        
 }
 
+/**
+    @brief Callback to update diagnostic value with timing of boot
+*/
+uint32_t sq_service_update_boot_diag(uint8_t * p_data, uint16_t len) {
+    return sqs_update_boot_diag_characteristic(&m_sqs, p_data, len);
+}
+
+/**
+    @brief Store transition of input register with current RTC timestamp
+    @param[in] input_reg - new value of input register
+    @param[in] event - code of event, made by @ref SQ_INPUT_EVT_CODE
+*/
+void sq_service_push_input_event(uint8_t input_reg, uint8_t event) {
+    
+    uint32_t ticks = 0;
+    app_timer_cnt_get(&ticks);
+    
+    /// when FIFO is full, the oldest event is overwritten
+    CRITICAL_REGION_ENTER();
+    sq_input_evt_t * p_evt = &m_input_evt_fifo[m_input_evt_head & INPUT_EVT_FIFO_MASK];
+    p_evt->ticks     = ticks;
+    p_evt->input_reg = input_reg;
+    p_evt->event     = event;
+    m_input_evt_head++;
+    CRITICAL_REGION_EXIT();
+}
+
+/**
+    @brief Send all stored input events to every link
+*/
+void sq_service_input_events_flush(void) {
+    
+    for (uint8_t i = 0; i < m_sqs.link_count; i++)
+        input_events_link_flush(&m_sqs.links[i]);
+    
+    input_evt_base_update();
+}
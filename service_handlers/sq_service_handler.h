@@ -12,7 +12,18 @@ uint32_t sq_service_init(void);
 
 void sq_on_ble_evt(ble_evt_t * p_ble_evt);
 
+uint32_t sq_service_update_out_reg1_value(const uint8_t new_value);
+uint32_t sq_service_update_adc_interval_value(const uint16_t interval_ms);
 uint32_t sq_service_update_adc_characteristic(const uint16_t adc_value);
 uint32_t sq_service_update_input_characteristic(uint8_t new_value);
-uint32_t sq_service_update_rssi_value(const int8_t rssi_val);
+uint32_t sq_service_update_rssi_value(uint16_t conn_handle, const int8_t rssi_val);
+uint32_t sq_service_update_boot_diag(uint8_t * p_data, uint16_t len);
+
+/**
+    @brief Code of input event: number of input in high nibble, gesture in low nibble
+*/
+#define SQ_INPUT_EVT_CODE(input, gesture)   ((uint8_t)(((input) << 4) | ((gesture) & 0x0F)))
+
+void sq_service_push_input_event(uint8_t input_reg, uint8_t event);
+void sq_service_input_events_flush(void);
 #endif
@@ -53,3 +53,12 @@ void tps_on_ble_evt(ble_evt_t * p_ble_evt) {
     ble_tps_on_ble_evt(&m_tps, p_ble_evt);    
 }
 
+
+/**
+    @brief Update value of TX power level characteristic
+    @param[in] tx_power - actual TX power, dBm
+*/
+uint32_t tps_service_tx_power_set(int8_t tx_power) {
+    return ble_tps_tx_power_level_set(&m_tps, tx_power);
+}
+
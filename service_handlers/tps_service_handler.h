@@ -5,5 +5,6 @@
 
 uint32_t tps_service_init(void);
 void tps_on_ble_evt(ble_evt_t * p_ble_evt);
+uint32_t tps_service_tx_power_set(int8_t tx_power);
 
 #endif
\ No newline at end of file
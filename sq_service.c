@@ -4,7 +4,11 @@
             2) 1 byte to control another output register;
             3) 1 byte to control input register;
             4) 1 byte to check the adc-input;
-            5) 1 byte to store RSII of current connection.
+            5) 1 byte to store RSII of connection, every central gets own RSSI;
+            6) notifications with several timestamped events of input register;
+            7) read only diagnostic value with timing of boot;
+            8) sync of time with central, ADC and RSSI are stamped, see my_time_manager.h;
+            9) 2 bytes of ADC interval in ms, written value is stored in flash.
             
             To create was used this tutorial - https://devzone.nordicsemi.com/tutorials/8/
 */
@@ -13,6 +17,11 @@
 #include "app_error.h"
 #include "string.h"
 #include "my_gpio_manager.h"
+#include "my_adc_manager.h"
+#include "my_energy_manager.h"
+#include "my_log_manager.h"
+#include "my_trace_manager.h"
+#include "my_stats_manager.h"
 
 #define NRF_LOG_MODULE_NAME "CSERV"
 #include "nrf_log.h"
@@ -23,28 +32,322 @@
 #define BLE_UUID_REG_IN_CHARACTERISTC_UUID      0x08
 #define BLE_UUID_REG_ADC_CHARACTERISTC_UUID     0x0F
 #define BLE_UUID_REG_RSSI_CHARACTERISTC_UUID    0x20
+#define BLE_UUID_REG_IN_EVT_CHARACTERISTC_UUID  0x40
+#define BLE_UUID_BOOT_DIAG_CHARACTERISTC_UUID   0x80
+#define BLE_UUID_TRACE_DIAG_CHARACTERISTC_UUID  0x0100
+#define BLE_UUID_STATS_CHARACTERISTC_UUID       0x0200
+#define BLE_UUID_TIME_SYNC_CHARACTERISTC_UUID   0x0400
+#define BLE_UUID_ADC_INTERVAL_CHARACTERISTC_UUID    0x0800
+
+static void sqs_notify_state_set(ble_sq_t * p_sqs, uint16_t conn_handle, uint8_t * p_enabled,
+                                 sqs_notify_char_t notify_char, bool enabled);
 
 
 /**@brief Function for handling the Connect event.
+ *
+ * @details New link is added at the end of array of links.
  *
  * @param[in]   p_sqs       Battery Service structure.
  * @param[in]   p_ble_evt   Event received from the BLE stack.
  */
 static void on_connect(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt)
 {
-    p_sqs->conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+    if (p_sqs->link_count == SQS_LINK_MAX)
+    {
+        return;     /// SoftDevice doesn't accept more links
+    }
+
+    ble_sq_link_t * p_link = &p_sqs->links[p_sqs->link_count++];
+
+    memset(p_link, 0, sizeof(ble_sq_link_t));
+    p_link->conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
 }
 
 
 /**@brief Function for handling the Disconnect event.
+ *
+ * @details The last link is moved to place of removed one, so links stay packed.
+ *          Notifications of removed link are reported as disabled.
  *
  * @param[in]   p_sqs       Battery Service structure.
  * @param[in]   p_ble_evt   Event received from the BLE stack.
  */
 static void on_disconnect(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt)
 {
-    UNUSED_PARAMETER(p_ble_evt);
-    p_sqs->conn_handle = BLE_CONN_HANDLE_INVALID;
+    uint16_t        conn_handle = p_ble_evt->evt.gap_evt.conn_handle;
+    ble_sq_link_t * p_link      = sqs_link_get(p_sqs, conn_handle);
+
+    if (p_link == NULL)
+    {
+        return;
+    }
+
+    uint8_t enabled = p_link->notify_enabled;
+    *p_link = p_sqs->links[--p_sqs->link_count];
+
+    /// application counts subscribers without removed link
+    for (uint8_t i = 0; i < SQS_NOTIFY_COUNT; i++)
+    {
+        sqs_notify_state_set(p_sqs, conn_handle, &enabled, (sqs_notify_char_t)i, false);
+    }
+}
+
+
+/**@brief Function for counting result of notification.
+ *
+ * @param[in]   err_code    Result of sd_ble_gatts_hvx().
+ * @param[in]   feature     Feature, which is charged for sent packet.
+ */
+static void sqs_hvx_account(uint32_t err_code, energy_feature_t feature)
+{
+    if (err_code == NRF_SUCCESS)
+    {
+        MY_ENERGY_TX_PACKET(feature);
+        MY_STATS_INC(STATS_COUNTER_NOTIFY_SENT);
+    }
+    else if ( (err_code != NRF_ERROR_INVALID_STATE)
+               && (err_code != BLE_ERROR_GATTS_SYS_ATTR_MISSING) )
+    {
+        /// client is subscribed, but value isn't queued
+        MY_STATS_INC(STATS_COUNTER_NOTIFY_DROPPED);
+        if (err_code == BLE_ERROR_NO_TX_PACKETS)
+        {
+            MY_STATS_INC(STATS_COUNTER_NO_TX_PACKETS);
+        }
+    }
+}
+
+
+/**@brief Feature charged for notification and length of value of characteristics,
+ *        index is @ref sqs_notify_char_t. Length of input events is variable.
+ */
+static energy_feature_t const m_notify_feature[SQS_NOTIFY_COUNT] = {
+    ENERGY_FEATURE_INPUT, ENERGY_FEATURE_ADC, ENERGY_FEATURE_RSSI, ENERGY_FEATURE_INPUT, ENERGY_FEATURE_BLE
+};
+static uint16_t const m_notify_len[SQS_NOTIFY_COUNT] = {
+    sizeof(uint8_t), SQS_ADC_LEN, SQS_RSSI_LEN, 0, TIME_SYNC_REPLY_LEN
+};
+
+
+/**@brief Function for getting handles of characteristic with notification.
+ */
+static ble_gatts_char_handles_t const * sqs_notify_handles(ble_sq_t const * p_sqs,
+                                                           sqs_notify_char_t notify_char)
+{
+    switch (notify_char)
+    {
+        case SQS_NOTIFY_IN:
+            return &p_sqs->sqs_reg_in_handles;
+        case SQS_NOTIFY_ADC:
+            return &p_sqs->sqs_adc_handles;
+        case SQS_NOTIFY_RSSI:
+            return &p_sqs->sqs_rssi_handles;
+        case SQS_NOTIFY_TIME_SYNC:
+            return &p_sqs->sqs_time_sync_handles;
+        default:
+            return &p_sqs->sqs_input_evt_handles;
+    }
+}
+
+
+/**@brief Function for changing state of CCCD in link, application gets event
+ *        only when state is changed.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   conn_handle Link of central.
+ * @param[in]   p_enabled   SQS_NOTIFY_BIT of enabled characteristics in link.
+ * @param[in]   notify_char Characteristic of CCCD.
+ * @param[in]   enabled     New state of notification.
+ */
+static void sqs_notify_state_set(ble_sq_t * p_sqs, uint16_t conn_handle, uint8_t * p_enabled,
+                                 sqs_notify_char_t notify_char, bool enabled)
+{
+    uint8_t bit = SQS_NOTIFY_BIT(notify_char);
+
+    if (((*p_enabled & bit) != 0) == enabled)
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        *p_enabled |= bit;
+    }
+    else
+    {
+        *p_enabled &= (uint8_t)~bit;
+    }
+
+    if (p_sqs->evt_handler != NULL)
+    {
+        ble_sq_evt_t evt;
+
+        evt.evt_type    = enabled ? BLE_SQ_EVT_NOTIFICATION_ENABLED : BLE_SQ_EVT_NOTIFICATION_DISABLED;
+        evt.notify_char = notify_char;
+        evt.conn_handle = conn_handle;
+        p_sqs->evt_handler(p_sqs, &evt);
+    }
+}
+
+
+/**@brief Function for sending notification of value to one link.
+ *
+ * @details Value, which can't be queued because of full TX buffers, is marked
+ *          as pending in the link and it is sent again by on_tx_complete().
+ *          Only the last value is kept, so the cost doesn't grow with rate of updates.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   p_link      Connected central.
+ * @param[in]   notify_char Characteristic of value.
+ * @param[in]   p_data      Value or NULL to send value from database.
+ *
+ * @return      Result of sd_ble_gatts_hvx(), NRF_ERROR_INVALID_STATE without call
+ *              of stack if central didn't enable notification.
+ */
+static uint32_t sqs_link_notify(ble_sq_t * p_sqs, ble_sq_link_t * p_link,
+                                sqs_notify_char_t notify_char, uint8_t const * p_data)
+{
+    ble_gatts_hvx_params_t hvx_params;
+    uint16_t               hvx_len = m_notify_len[notify_char];
+
+    if ((p_link->notify_enabled & SQS_NOTIFY_BIT(notify_char)) == 0)
+    {
+        p_link->notify_pending &= (uint8_t)~SQS_NOTIFY_BIT(notify_char);
+        return NRF_ERROR_INVALID_STATE;
+    }
+
+    memset(&hvx_params, 0, sizeof(hvx_params));
+
+    hvx_params.handle = sqs_notify_handles(p_sqs, notify_char)->value_handle;
+    hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+    hvx_params.offset = 0;
+    hvx_params.p_len  = &hvx_len;
+    hvx_params.p_data = p_data;
+
+    uint32_t err_code = sd_ble_gatts_hvx(p_link->conn_handle, &hvx_params);
+    sqs_hvx_account(err_code, m_notify_feature[notify_char]);
+
+    if (err_code == BLE_ERROR_NO_TX_PACKETS)
+    {
+        p_link->notify_pending |= SQS_NOTIFY_BIT(notify_char);
+    }
+    else
+    {
+        p_link->notify_pending &= (uint8_t)~SQS_NOTIFY_BIT(notify_char);
+    }
+    return err_code;
+}
+
+
+/**@brief Function for sending notification of shared value to every connected central.
+ *
+ * @details Value is already set once in database for all links (BLE_CONN_HANDLE_INVALID),
+ *          so the stack takes it from database and nothing is prepared per link.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   notify_char Characteristic of value, SQS_NOTIFY_IN or SQS_NOTIFY_ADC.
+ *
+ * @return      NRF_ERROR_INVALID_STATE without links, otherwise error of the last
+ *              failed link or NRF_SUCCESS. Value rejected with BLE_ERROR_NO_TX_PACKETS
+ *              is sent later, unless newer value replaces it.
+ */
+static uint32_t sqs_notify_links(ble_sq_t * p_sqs, sqs_notify_char_t notify_char)
+{
+    uint32_t result = NRF_ERROR_INVALID_STATE;
+
+    for (uint8_t i = 0; i < p_sqs->link_count; i++)
+    {
+        uint32_t err_code = sqs_link_notify(p_sqs, &p_sqs->links[i], notify_char, NULL);
+        if ((i == 0) || (err_code != NRF_SUCCESS))
+        {
+            result = err_code;
+        }
+    }
+    return result;
+}
+
+
+/**@brief Function for handling the TX complete event.
+ *
+ * @details Pending values of link are sent while the stack has free buffers.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
+ */
+static void on_tx_complete(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt)
+{
+    ble_sq_link_t * p_link = sqs_link_get(p_sqs, p_ble_evt->evt.common_evt.conn_handle);
+
+    if (p_link == NULL)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; (i < SQS_NOTIFY_IN_EVT) && (p_link->notify_pending != 0); i++)
+    {
+        if ((p_link->notify_pending & SQS_NOTIFY_BIT(i)) == 0)
+        {
+            continue;
+        }
+
+        /// RSSI of link isn't in shared database value
+        uint8_t const * p_data = (i == SQS_NOTIFY_RSSI) ? p_link->reg_rssi : NULL;
+        if (sqs_link_notify(p_sqs, p_link, (sqs_notify_char_t)i, p_data) == BLE_ERROR_NO_TX_PACKETS)
+        {
+            break;
+        }
+    }
+}
+
+
+/**@brief Function for replying to sync of time, see my_time_manager.h.
+ *
+ * @details Reply is set to database for central without notification and it is
+ *          notified to the writer. Reply rejected because of full TX buffers
+ *          isn't resent, central repeats sync.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   p_link      Central, which wrote its time.
+ * @param[in]   p_write     Written time of central.
+ */
+static void on_time_sync(ble_sq_t * p_sqs, ble_sq_link_t * p_link, uint8_t const * p_write)
+{
+    uint8_t           reply[TIME_SYNC_REPLY_LEN];
+    ble_gatts_value_t gatts_value;
+
+    memset(&gatts_value, 0, sizeof(gatts_value));
+    gatts_value.len     = my_time_sync(p_link->conn_handle, p_write, reply);
+    gatts_value.offset  = 0;
+    gatts_value.p_value = reply;
+
+    uint32_t err_code = sd_ble_gatts_value_set(p_link->conn_handle,
+                                               p_sqs->sqs_time_sync_handles.value_handle,
+                                               &gatts_value);
+    if (err_code == NRF_SUCCESS)
+    {
+        (void)sqs_link_notify(p_sqs, p_link, SQS_NOTIFY_TIME_SYNC, reply);
+    }
+}
+
+
+/**@brief Function for setting value of ADC interval characteristic in database.
+ *
+ * @param[in]   p_sqs         sq service structure.
+ * @param[in]   interval_ms   Interval of ADC measurements.
+ */
+static uint32_t adc_interval_value_set(ble_sq_t * p_sqs, uint16_t interval_ms)
+{
+    uint8_t           value[sizeof(uint16_t)];
+    ble_gatts_value_t gatts_value;
+    memset(&gatts_value, 0, sizeof(gatts_value));
+
+    gatts_value.len     = uint16_encode(interval_ms, value);
+    gatts_value.offset  = 0;
+    gatts_value.p_value = value;
+
+    return sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
+                                  p_sqs->sqs_adc_interval_handles.value_handle,
+                                  &gatts_value);
 }
 
 
@@ -60,10 +363,206 @@ static void on_write(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt)
     if ( (p_evt_write->handle == p_sqs->sqs_reg_out1_handles.value_handle)
           && (p_evt_write->len == 1) )
     {
-        NRF_LOG_INFO("WRITE 0x%x to REG_OUT1\r\n", p_evt_write->data[0]);
+        MY_LOG("WRITE 0x%x to REG_OUT1", p_evt_write->data[0]);
+        MY_TRACE_VALUE(TRACE_POINT_OUT_REG1, p_evt_write->data[0]);
+        p_sqs->reg_out1 = p_evt_write->data[0];
         my_gpio_out_change_state(GPIO_OUT_REG1, p_evt_write->data[0]);
+        return;
+    }
+
+    if ( (p_evt_write->handle == p_sqs->sqs_adc_interval_handles.value_handle)
+          && (p_evt_write->len == sizeof(uint16_t)) )
+    {
+        uint16_t interval_ms = uint16_decode(p_evt_write->data);
+        MY_LOG("WRITE %d ms to ADC_INTERVAL", interval_ms);
+        if (my_adc_interval_store(interval_ms) == NRF_SUCCESS)
+        {
+            p_sqs->adc_interval = interval_ms;
+        }
+        else
+        {
+            /// database holds rejected interval, it is replaced by the running one
+            uint32_t err_code = adc_interval_value_set(p_sqs, p_sqs->adc_interval);
+            APP_ERROR_CHECK(err_code);
+        }
+        return;
+    }
+
+    ble_sq_link_t * p_link = sqs_link_get(p_sqs, p_ble_evt->evt.gatts_evt.conn_handle);
+
+    if ( (p_link != NULL) && (p_evt_write->handle == p_sqs->sqs_time_sync_handles.value_handle)
+          && (p_evt_write->len == TIME_SYNC_WRITE_LEN) )
+    {
+        on_time_sync(p_sqs, p_link, p_evt_write->data);
+        return;
+    }
+
+    if ((p_link == NULL) || (p_evt_write->len != BLE_CCCD_VALUE_LEN))
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < SQS_NOTIFY_COUNT; i++)
+    {
+        if (p_evt_write->handle == sqs_notify_handles(p_sqs, (sqs_notify_char_t)i)->cccd_handle)
+        {
+            sqs_notify_state_set(p_sqs, p_link->conn_handle, &p_link->notify_enabled, (sqs_notify_char_t)i,
+                                 ble_srv_is_notification_enabled(p_evt_write->data));
+            break;
+        }
+    }
+}
+
+
+/**@brief Function for handling the Connection Security Update event.
+ *
+ * @details CCCDs of bonded central are restored by Peer Manager without write
+ *          events, so state of link is read from database.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
+ */
+static void on_conn_sec_update(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt)
+{
+    ble_sq_link_t * p_link = sqs_link_get(p_sqs, p_ble_evt->evt.gap_evt.conn_handle);
+
+    if (p_link == NULL)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < SQS_NOTIFY_COUNT; i++)
+    {
+        uint8_t           cccd[BLE_CCCD_VALUE_LEN];
+        ble_gatts_value_t gatts_value;
+
+        /// characteristic can be compiled out
+        if (sqs_notify_handles(p_sqs, (sqs_notify_char_t)i)->cccd_handle == BLE_GATT_HANDLE_INVALID)
+        {
+            continue;
+        }
+
+        memset(&gatts_value, 0, sizeof(gatts_value));
+        gatts_value.len     = sizeof(cccd);
+        gatts_value.offset  = 0;
+        gatts_value.p_value = cccd;
+
+        uint32_t err_code = sd_ble_gatts_value_get(p_link->conn_handle,
+                                                   sqs_notify_handles(p_sqs, (sqs_notify_char_t)i)->cccd_handle,
+                                                   &gatts_value);
+        sqs_notify_state_set(p_sqs, p_link->conn_handle, &p_link->notify_enabled, (sqs_notify_char_t)i,
+                             (err_code == NRF_SUCCESS) && ble_srv_is_notification_enabled(cccd));
     }
-    
+}
+
+/**@brief Function for handling the Read authorization request of statistics and RSSI.
+ *
+ * @details First request of long read (offset 0) replaces value by snapshot of
+ *          statistics, next requests read the rest of the same snapshot.
+ *          Value of RSSI in database is shared by links, so read is answered
+ *          by RSSI of link of reader.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   p_ble_evt   Event received from the BLE stack.
+ */
+static void on_rw_authorize_request(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt)
+{
+    ble_gatts_evt_rw_authorize_request_t const * p_req = &p_ble_evt->evt.gatts_evt.params.authorize_request;
+    ble_gatts_rw_authorize_reply_params_t        reply;
+    uint8_t                                      snapshot[sizeof(my_stats_t)];
+    uint16_t                                     conn_handle = p_ble_evt->evt.gatts_evt.conn_handle;
+
+    if (p_req->type != BLE_GATTS_AUTHORIZE_TYPE_READ)
+    {
+        return;
+    }
+
+    memset(&reply, 0, sizeof(reply));
+    reply.type                    = BLE_GATTS_AUTHORIZE_TYPE_READ;
+    reply.params.read.gatt_status = BLE_GATT_STATUS_SUCCESS;
+
+    if (p_req->request.read.handle == p_sqs->sqs_stats_handles.value_handle)
+    {
+        if (p_req->request.read.offset == 0)
+        {
+            reply.params.read.update = 1;
+            reply.params.read.len    = my_stats_snapshot(snapshot);
+            reply.params.read.p_data = snapshot;
+        }
+    }
+    else if (p_req->request.read.handle == p_sqs->sqs_rssi_handles.value_handle)
+    {
+        ble_sq_link_t * p_link = sqs_link_get(p_sqs, conn_handle);
+
+        /// link without measurement reads zero value
+        memset(snapshot, 0, SQS_RSSI_LEN);
+        reply.params.read.update = 1;
+        reply.params.read.len    = SQS_RSSI_LEN;
+        reply.params.read.p_data = (p_link != NULL) ? p_link->reg_rssi : snapshot;
+    }
+    else
+    {
+        return;
+    }
+
+    uint32_t err_code = sd_ble_gatts_rw_authorize_reply(conn_handle, &reply);
+    /// link can be lost before reply
+    if (err_code != BLE_ERROR_INVALID_CONN_HANDLE)
+    {
+        APP_ERROR_CHECK(err_code);
+    }
+}
+
+/**@brief Function for adding characteristic with open permissions to the sq service.
+ *
+ * @param[in]   p_sqs       sq service structure.
+ * @param[in]   uuid_type   Type of vendor specific base UUID.
+ * @param[in]   uuid        16-bit UUID of characteristic.
+ * @param[in]   p_props     Properties of characteristic.
+ * @param[in]   max_len     Max length of value, value has variable length if max_len != init_len.
+ * @param[in]   init_len    Length of initial value.
+ * @param[in]   p_value     Initial value.
+ * @param[in]   vloc        BLE_GATTS_VLOC_STACK or BLE_GATTS_VLOC_USER - value stays at p_value.
+ * @param[in]   rd_auth     Read is authorized by application, see on_rw_authorize_request().
+ * @param[out]  p_handles   Handles of added characteristic.
+ */
+static uint32_t sqs_char_add(ble_sq_t * p_sqs, uint8_t uuid_type, uint16_t uuid,
+                             ble_gatt_char_props_t const * p_props,
+                             uint16_t max_len, uint16_t init_len, uint8_t * p_value,
+                             uint8_t vloc, bool rd_auth, ble_gatts_char_handles_t * p_handles)
+{
+    ble_uuid_t          char_uuid;
+    ble_gatts_attr_md_t attr_md;
+    ble_gatts_attr_t    attr_char_value;
+    ble_gatts_char_md_t char_md;
+
+    char_uuid.uuid = uuid;
+    char_uuid.type = uuid_type;
+
+    memset(&attr_md, 0, sizeof(attr_md));
+    attr_md.vloc    = vloc;
+    attr_md.rd_auth = rd_auth ? 1 : 0;
+    attr_md.vlen = (max_len != init_len) ? 1 : 0;
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.read_perm);
+    if (p_props->write || p_props->write_wo_resp)
+    {
+        BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.write_perm);
+    }
+
+    memset(&char_md, 0, sizeof(char_md));
+    char_md.char_props = *p_props;
+
+    memset(&attr_char_value, 0, sizeof(attr_char_value));
+    attr_char_value.p_uuid      = &char_uuid;
+    attr_char_value.p_attr_md   = &attr_md;
+    attr_char_value.max_len     = max_len;
+    attr_char_value.init_len    = init_len;
+    attr_char_value.p_value     = p_value;
+
+    return sd_ble_gatts_characteristic_add(p_sqs->service_handle,
+                                           &char_md,
+                                           &attr_char_value,
+                                           p_handles);
 }
 
 /**
@@ -82,16 +581,22 @@ uint32_t ble_sqs_init(ble_sq_t * p_sqs, ble_sq_init_t * p_sqs_init) {
         
     uint32_t err_code;
     
-    /// Connection handle to invalid value
-    p_sqs->conn_handle = BLE_CONN_HANDLE_INVALID;
+    /// no connected centrals
+    p_sqs->link_count = 0;
         
     /// OUR_JOB: Declare 16-bit service and 128-bit base UUIDs and add them to the BLE stack
     ble_uuid_t        service_uuid;
-    ble_uuid128_t     base_uuid = BLE_BASE_UUID_SQ_SERVICE;
+    ble_uuid128_t     base_uuid = { .uuid128 = BLE_BASE_UUID_SQ_SERVICE };
     service_uuid.uuid = BLE_UUID_SQ_SERVICE;
     
     p_sqs->evt_handler = p_sqs_init->evt_handler;    
-    p_sqs->conn_handle = BLE_CONN_HANDLE_INVALID;
+    
+    /// values in database are equal to initial values
+    p_sqs->reg_out1 = p_sqs_init->out_reg1_value;
+    p_sqs->reg_out2 = p_sqs_init->out_reg2_value;
+    p_sqs->reg_in   = p_sqs_init->in_reg_value;
+    p_sqs->reg_adc  = p_sqs_init->adc_reg_value;
+    p_sqs->adc_interval = p_sqs_init->adc_interval_value;
                 
     err_code = sd_ble_uuid_vs_add(&base_uuid, &service_uuid.type);
     if (err_code != NRF_SUCCESS)
@@ -216,10 +721,14 @@ uint32_t ble_sqs_init(ble_sq_t * p_sqs, ble_sq_init_t * p_sqs_init) {
     /// Set read/write permissions to our characteristic
     BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.read_perm);
     
-    /// Set characteristic length
-    attr_char_value.max_len     = 2;
-    attr_char_value.init_len    = 2;
-    attr_char_value.p_value     = &(p_sqs_init->adc_reg_value);
+    /// Set characteristic length, value is stamped with time of sample
+    uint8_t adc_init[SQS_ADC_LEN];
+    memset(adc_init, 0, sizeof(adc_init));
+    adc_init[0] = (uint8_t)(p_sqs_init->adc_reg_value);
+    adc_init[1] = (uint8_t)(p_sqs_init->adc_reg_value >> 8);
+    attr_char_value.max_len     = SQS_ADC_LEN;
+    attr_char_value.init_len    = SQS_ADC_LEN;
+    attr_char_value.p_value     = adc_init;
         
     /// Add the new characteristic to the service
     err_code = sd_ble_gatts_characteristic_add(p_sqs->service_handle,
@@ -237,9 +746,10 @@ uint32_t ble_sqs_init(ble_sq_t * p_sqs, ble_sq_init_t * p_sqs_init) {
     err_code = sd_ble_uuid_vs_add(&base_uuid, &char_uuid.type);
     APP_ERROR_CHECK(err_code);
 
-    /// Configure the Attribute Metadata    
+    /// Configure the Attribute Metadata, every link reads own RSSI by authorized read
     memset(&attr_md, 0, sizeof(attr_md));
-    attr_md.vloc = BLE_GATTS_VLOC_STACK;
+    attr_md.vloc    = BLE_GATTS_VLOC_STACK;
+    attr_md.rd_auth = 1;
     
     /// Configure the Characteristic Value Attribute
     memset(&attr_char_value, 0, sizeof(attr_char_value));    
@@ -254,10 +764,13 @@ uint32_t ble_sqs_init(ble_sq_t * p_sqs, ble_sq_init_t * p_sqs_init) {
     /// Set read/write permissions to our characteristic
     BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attr_md.read_perm);
     
-    /// Set characteristic length
-    attr_char_value.max_len     = 1;
-    attr_char_value.init_len    = 1;
-    attr_char_value.p_value     = &(p_sqs_init->rssi_reg_value);
+    /// Set characteristic length, value is stamped with time of measurement
+    uint8_t rssi_init[SQS_RSSI_LEN];
+    memset(rssi_init, 0, sizeof(rssi_init));
+    rssi_init[0] = p_sqs_init->rssi_reg_value;
+    attr_char_value.max_len     = SQS_RSSI_LEN;
+    attr_char_value.init_len    = SQS_RSSI_LEN;
+    attr_char_value.p_value     = rssi_init;
         
     /// Add the new characteristic to the service
     err_code = sd_ble_gatts_characteristic_add(p_sqs->service_handle,
@@ -266,6 +779,97 @@ uint32_t ble_sqs_init(ble_sq_t * p_sqs, ble_sq_init_t * p_sqs_init) {
                                    &p_sqs->sqs_rssi_handles);
     APP_ERROR_CHECK(err_code);           
     
+    /*****************
+    *  INPUT_EVENTS  *
+    ******************/
+    
+    ble_gatt_char_props_t props;
+    memset(&props, 0, sizeof(props));
+    props.read   = 1;
+    props.notify = 1;
+    
+    /// no events at start - only sequence number
+    uint8_t input_evt_init = 0x00;
+    err_code = sqs_char_add(p_sqs, service_uuid.type, BLE_UUID_REG_IN_EVT_CHARACTERISTC_UUID,
+                            &props, SQS_INPUT_EVT_MAX_LEN, sizeof(input_evt_init), &input_evt_init,
+                            BLE_GATTS_VLOC_STACK, false, &p_sqs->sqs_input_evt_handles);
+    APP_ERROR_CHECK(err_code);
+    
+    /***************
+    *  BOOT_DIAG   *
+    ****************/
+    
+    memset(&props, 0, sizeof(props));
+    props.read = 1;
+    
+    /// value is set after end of boot
+    uint8_t boot_diag_init = 0x00;
+    err_code = sqs_char_add(p_sqs, service_uuid.type, BLE_UUID_BOOT_DIAG_CHARACTERISTC_UUID,
+                            &props, SQS_BOOT_DIAG_MAX_LEN, sizeof(boot_diag_init), &boot_diag_init,
+                            BLE_GATTS_VLOC_STACK, false, &p_sqs->sqs_boot_diag_handles);
+    APP_ERROR_CHECK(err_code);
+    
+    /***************
+    *  TRACE_DIAG  *
+    ****************/
+    
+    /// trace of previous run doesn't change - stack reads it from application memory
+    if (p_sqs_init->p_trace_diag != NULL)
+    {
+        err_code = sqs_char_add(p_sqs, service_uuid.type, BLE_UUID_TRACE_DIAG_CHARACTERISTC_UUID,
+                                &props, SQS_TRACE_DIAG_MAX_LEN, p_sqs_init->trace_diag_len,
+                                p_sqs_init->p_trace_diag,
+                                BLE_GATTS_VLOC_USER, false, &p_sqs->sqs_trace_diag_handles);
+        APP_ERROR_CHECK(err_code);
+    }
+    
+    /***************
+    *    STATS     *
+    ****************/
+    
+    /// every read is authorized - value is replaced by snapshot of statistics
+    STATIC_ASSERT(sizeof(my_stats_t) <= SQS_STATS_MAX_LEN);
+    uint8_t  stats_init[sizeof(my_stats_t)];
+    uint16_t stats_len = my_stats_snapshot(stats_init);
+    err_code = sqs_char_add(p_sqs, service_uuid.type, BLE_UUID_STATS_CHARACTERISTC_UUID,
+                            &props, SQS_STATS_MAX_LEN, stats_len, stats_init,
+                            BLE_GATTS_VLOC_STACK, true, &p_sqs->sqs_stats_handles);
+    APP_ERROR_CHECK(err_code);
+    
+#ifdef TIME_SYNC
+    /***************
+    *  TIME_SYNC   *
+    ****************/
+    
+    memset(&props, 0, sizeof(props));
+    props.read   = 1;
+    props.write  = 1;
+    props.notify = 1;
+    
+    /// central writes its time, reply of device has other length
+    uint8_t time_sync_init[TIME_SYNC_WRITE_LEN];
+    memset(time_sync_init, 0, sizeof(time_sync_init));
+    err_code = sqs_char_add(p_sqs, service_uuid.type, BLE_UUID_TIME_SYNC_CHARACTERISTC_UUID,
+                            &props, TIME_SYNC_REPLY_LEN, sizeof(time_sync_init), time_sync_init,
+                            BLE_GATTS_VLOC_STACK, false, &p_sqs->sqs_time_sync_handles);
+    APP_ERROR_CHECK(err_code);
+#endif
+    
+    /****************
+    * ADC_INTERVAL  *
+    *****************/
+    
+    memset(&props, 0, sizeof(props));
+    props.read   = 1;
+    props.write  = 1;
+    
+    uint8_t adc_interval_init[sizeof(uint16_t)];
+    (void)uint16_encode(p_sqs->adc_interval, adc_interval_init);
+    err_code = sqs_char_add(p_sqs, service_uuid.type, BLE_UUID_ADC_INTERVAL_CHARACTERISTC_UUID,
+                            &props, sizeof(adc_interval_init), sizeof(adc_interval_init), adc_interval_init,
+                            BLE_GATTS_VLOC_STACK, false, &p_sqs->sqs_adc_interval_handles);
+    APP_ERROR_CHECK(err_code);
+    
     return err_code;
 }
 #pragma pop /* Restore original optimization level */
@@ -293,18 +897,87 @@ void ble_sqs_on_ble_evt(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt) {
             on_write(p_sqs, p_ble_evt);
             break;
         
+        case BLE_EVT_TX_COMPLETE:
+            on_tx_complete(p_sqs, p_ble_evt);
+            break;
+        
+        case BLE_GAP_EVT_CONN_SEC_UPDATE:
+            on_conn_sec_update(p_sqs, p_ble_evt);
+            break;
+        
+        case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+            on_rw_authorize_request(p_sqs, p_ble_evt);
+            break;
+        
         default:
             // No implementation needed.
             break;
     }    
 }
 
+/**
+    @brief update value of output register 1 in database, without notification.
+           Used when output register is restored from flash.
+    @param[in] p_sqs - sq service handler
+    @param[in] value - new value of output register
+*/
+uint32_t sqs_update_out_reg1_characteristic(ble_sq_t * p_sqs, uint8_t value) {
+    
+    if (p_sqs == NULL)
+        return NRF_ERROR_NULL;
+    
+    if (p_sqs->sqs_reg_out1_handles.value_handle == BLE_GATT_HANDLE_INVALID)
+        return NRF_ERROR_INVALID_STATE;     /// service isn't added yet
+    
+    if (p_sqs->reg_out1 == value)
+        return NRF_SUCCESS;
+    
+    ble_gatts_value_t gatts_value;
+    memset(&gatts_value, 0, sizeof(gatts_value));
+    
+    gatts_value.len     = sizeof(uint8_t);
+    gatts_value.offset  = 0;
+    gatts_value.p_value = &value;
+    
+    uint32_t err_code = sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
+                                               p_sqs->sqs_reg_out1_handles.value_handle,
+                                               &gatts_value);
+    if (err_code == NRF_SUCCESS)
+        p_sqs->reg_out1 = value;
+    
+    return err_code;
+}
+
+/**
+    @brief update value of ADC interval in database, e.g. after restore from flash
+    @param[in] p_sqs - sq service handler
+    @param[in] interval_ms - interval of ADC measurements
+*/
+uint32_t sqs_update_adc_interval_characteristic(ble_sq_t * p_sqs, uint16_t interval_ms) {
+    
+    if (p_sqs == NULL)
+        return NRF_ERROR_NULL;
+    
+    if (p_sqs->sqs_adc_interval_handles.value_handle == BLE_GATT_HANDLE_INVALID)
+        return NRF_ERROR_INVALID_STATE;     /// service isn't added yet
+    
+    if (p_sqs->adc_interval == interval_ms)
+        return NRF_SUCCESS;
+    
+    uint32_t err_code = adc_interval_value_set(p_sqs, interval_ms);
+    if (err_code == NRF_SUCCESS)
+        p_sqs->adc_interval = interval_ms;
+    
+    return err_code;
+}
+
 /**
     @brief update adc registers characteristic of sq_service with new value
     @param[in] p_sqs - sq service handler
     @param[in] value - new value of adc
+    @param[in] ticks - device time of sample, see my_time_manager.h
 */
-uint32_t sqs_update_adc_characteristic(ble_sq_t * p_sqs, uint16_t adc_value) {
+uint32_t sqs_update_adc_characteristic(ble_sq_t * p_sqs, uint16_t adc_value, uint64_t ticks) {
     
     if (p_sqs != NULL) {
         if (p_sqs->reg_adc != adc_value) {
@@ -318,16 +991,17 @@ uint32_t sqs_update_adc_characteristic(ble_sq_t * p_sqs, uint16_t adc_value) {
             // Initialize value struct.
             memset(&gatts_value, 0, sizeof(gatts_value));
     
-            uint8_t adc_val[sizeof(uint16_t)];
+            uint8_t adc_val[SQS_ADC_LEN];
             adc_val[0] = (adc_value & 0x00FF);
             adc_val[1] = (adc_value & 0xFF00)  >> 8;
+            my_time_stamp_put(&adc_val[sizeof(uint16_t)], ticks);
             
-            gatts_value.len     = sizeof(uint16_t);
+            gatts_value.len     = SQS_ADC_LEN;
             gatts_value.offset  = 0;
             gatts_value.p_value = &adc_val[0];
             
             // Update database.
-            err_code = sd_ble_gatts_value_set(p_sqs->conn_handle,
+            err_code = sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
                                             p_sqs->sqs_adc_handles.value_handle,
                                             &gatts_value);
             if (err_code == NRF_SUCCESS)
@@ -340,29 +1014,9 @@ uint32_t sqs_update_adc_characteristic(ble_sq_t * p_sqs, uint16_t adc_value) {
             }
             
             /**
-                send notification of changed rssi:
+                send notification of changed adc to every central:
             */                               
-            if (p_sqs->conn_handle != BLE_CONN_HANDLE_INVALID)
-            {
-                ble_gatts_hvx_params_t hvx_params;
-            
-                memset(&hvx_params, 0, sizeof(hvx_params));
-            
-                hvx_params.handle = p_sqs->sqs_adc_handles.value_handle;
-                hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
-                hvx_params.offset = gatts_value.offset;
-                hvx_params.p_len  = &gatts_value.len;
-                hvx_params.p_data = gatts_value.p_value;
-            
-                err_code = sd_ble_gatts_hvx(p_sqs->conn_handle, &hvx_params);
-                return err_code;
-            }
-            else
-            {
-                err_code = NRF_ERROR_INVALID_STATE;
-            }
-            
-            return err_code;
+            return sqs_notify_links(p_sqs, SQS_NOTIFY_ADC);
         }
         return NRF_SUCCESS;
     }
@@ -394,12 +1048,12 @@ uint32_t sqs_update_input_characteristic(ble_sq_t * p_sqs, uint8_t value) {
             gatts_value.p_value = &value;
             
             // Update database.
-            err_code = sd_ble_gatts_value_set(p_sqs->conn_handle,
+            err_code = sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
                                             p_sqs->sqs_reg_in_handles.value_handle,
                                             &gatts_value);
             if (err_code == NRF_SUCCESS)
             {
-                p_sqs->reg_adc = value;
+                p_sqs->reg_in = value;
             }
             else
             {
@@ -407,29 +1061,9 @@ uint32_t sqs_update_input_characteristic(ble_sq_t * p_sqs, uint8_t value) {
             }
             
             /**
-                send notification of changed rssi:
+                send notification of changed inputs to every central:
             */                               
-            if (p_sqs->conn_handle != BLE_CONN_HANDLE_INVALID)
-            {
-                ble_gatts_hvx_params_t hvx_params;
-            
-                memset(&hvx_params, 0, sizeof(hvx_params));
-            
-                hvx_params.handle = p_sqs->sqs_reg_in_handles.value_handle;
-                hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
-                hvx_params.offset = gatts_value.offset;
-                hvx_params.p_len  = &gatts_value.len;
-                hvx_params.p_data = gatts_value.p_value;
-            
-                err_code = sd_ble_gatts_hvx(p_sqs->conn_handle, &hvx_params);
-                return err_code;
-            }
-            else
-            {
-                err_code = NRF_ERROR_INVALID_STATE;
-            }
-            
-            return err_code;
+            return sqs_notify_links(p_sqs, SQS_NOTIFY_IN);
         }
         return NRF_SUCCESS;
     }
@@ -439,67 +1073,126 @@ uint32_t sqs_update_input_characteristic(ble_sq_t * p_sqs, uint8_t value) {
 }
 
 /**
-    @brief update rssi characteristic of sq_service with new value
+    @brief update rssi characteristic of sq_service with new value of link,
+           value is notified only to this link
     @param[in] p_sqs - sq service handler
+    @param[in] conn_handle - link, which rssi is measured
     @param[in] value - new value of rssi
+    @param[in] ticks - device time of measurement, see my_time_manager.h
 */
-uint32_t sqs_update_rssi_characteristic(ble_sq_t * p_sqs, uint8_t value) {
+uint32_t sqs_update_rssi_characteristic(ble_sq_t * p_sqs, uint16_t conn_handle, uint8_t value, uint64_t ticks) {
     
     if (p_sqs != NULL) {
-        if (p_sqs->reg_rssi != value) {
+        ble_sq_link_t * p_link = sqs_link_get(p_sqs, conn_handle);
+        if (p_link == NULL)
+            return NRF_ERROR_INVALID_STATE;
+        
+        if (p_link->reg_rssi[0] != value) {
             /**
-                update value in local database
+                value of link is kept in service, value in database is shared
+                by links, so read is answered from it, see on_rw_authorize_request()
             */
-            
-            uint32_t err_code = NRF_SUCCESS;
-            ble_gatts_value_t gatts_value;
-            
-            // Initialize value struct.
-            memset(&gatts_value, 0, sizeof(gatts_value));
-    
-            gatts_value.len     = sizeof(uint8_t);
-            gatts_value.offset  = 0;
-            gatts_value.p_value = &value;
-    
-            // Update database.
-            err_code = sd_ble_gatts_value_set(p_sqs->conn_handle,
-                                            p_sqs->sqs_rssi_handles.value_handle,
-                                            &gatts_value);
-            if (err_code == NRF_SUCCESS)
-            {
-                p_sqs->reg_rssi = value;
-            }
-            else
-            {
-                return err_code;
-            }
+            p_link->reg_rssi[0] = value;
+            my_time_stamp_put(&p_link->reg_rssi[sizeof(uint8_t)], ticks);
             
             /**
-                send notification of changed rssi:
+                send notification of changed rssi only to this link:
             */                               
-            if (p_sqs->conn_handle != BLE_CONN_HANDLE_INVALID)
-            {
-                ble_gatts_hvx_params_t hvx_params;
-            
-                memset(&hvx_params, 0, sizeof(hvx_params));
-            
-                hvx_params.handle = p_sqs->sqs_rssi_handles.value_handle;
-                hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
-                hvx_params.offset = gatts_value.offset;
-                hvx_params.p_len  = &gatts_value.len;
-                hvx_params.p_data = gatts_value.p_value;
-            
-                err_code = sd_ble_gatts_hvx(p_sqs->conn_handle, &hvx_params);
-                return err_code;
-            }
-            else
-            {
-                err_code = NRF_ERROR_INVALID_STATE;
-            }
-            return err_code;
+            return sqs_link_notify(p_sqs, p_link, SQS_NOTIFY_RSSI, p_link->reg_rssi);
         }
         return NRF_SUCCESS;
     }
     else 
         return NRF_ERROR_NULL;
 }
+
+/**
+    @brief send notification with packed input events to one link
+    @param[in] p_sqs - sq service handler
+    @param[in] conn_handle - link, every link gets events from own position in FIFO
+    @param[in] p_data - sequence number and events, see @ref SQS_INPUT_EVT_SIZE
+    @param[in] len - length of data
+    @return NRF_SUCCESS if notification is queued in the stack, 
+            otherwise events must be sent again later
+*/
+uint32_t sqs_send_input_events(ble_sq_t * p_sqs, uint16_t conn_handle, uint8_t * p_data, uint16_t len) {
+    
+    if (p_sqs == NULL)
+        return NRF_ERROR_NULL;
+    
+    /// events stay in FIFO until central enables notification
+    ble_sq_link_t * p_link = sqs_link_get(p_sqs, conn_handle);
+    if ((p_link == NULL) || ((p_link->notify_enabled & SQS_NOTIFY_BIT(SQS_NOTIFY_IN_EVT)) == 0))
+        return NRF_ERROR_INVALID_STATE;
+    
+    ble_gatts_hvx_params_t hvx_params;
+    
+    memset(&hvx_params, 0, sizeof(hvx_params));
+    
+    hvx_params.handle = p_sqs->sqs_input_evt_handles.value_handle;
+    hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+    hvx_params.offset = 0;
+    hvx_params.p_len  = &len;
+    hvx_params.p_data = p_data;
+    
+    uint32_t err_code = sd_ble_gatts_hvx(conn_handle, &hvx_params);
+    sqs_hvx_account(err_code, ENERGY_FEATURE_INPUT);
+    return err_code;
+}
+
+/**
+    @brief update diagnostic value with timing of boot, without notification
+    @param[in] p_sqs - sq service handler
+    @param[in] p_data - encoded timing of boot
+    @param[in] len - length of data, up to SQS_BOOT_DIAG_MAX_LEN
+*/
+uint32_t sqs_update_boot_diag_characteristic(ble_sq_t * p_sqs, uint8_t * p_data, uint16_t len) {
+    
+    if (p_sqs == NULL)
+        return NRF_ERROR_NULL;
+    
+    if (len > SQS_BOOT_DIAG_MAX_LEN)
+        return NRF_ERROR_INVALID_LENGTH;
+    
+    ble_gatts_value_t gatts_value;
+    memset(&gatts_value, 0, sizeof(gatts_value));
+    
+    gatts_value.len     = len;
+    gatts_value.offset  = 0;
+    gatts_value.p_value = p_data;
+    
+    return sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
+                                  p_sqs->sqs_boot_diag_handles.value_handle,
+                                  &gatts_value);
+}
+
+/**
+    @brief state of connected central
+    @param[in] p_sqs - sq service handler
+    @param[in] conn_handle - handle of connection
+    @return state of link, NULL if link isn't connected
+*/
+ble_sq_link_t * sqs_link_get(ble_sq_t * p_sqs, uint16_t conn_handle) {
+    
+    for (uint8_t i = 0; i < p_sqs->link_count; i++) {
+        if (p_sqs->links[i].conn_handle == conn_handle)
+            return &p_sqs->links[i];
+    }
+    return NULL;
+}
+
+/**
+    @brief count of links, which enabled notification of characteristic
+    @param[in] p_sqs - sq service handler
+    @param[in] notify_char - characteristic with notification
+*/
+uint8_t sqs_notify_count(ble_sq_t const * p_sqs, sqs_notify_char_t notify_char) {
+    
+    uint8_t count = 0;
+    
+    for (uint8_t i = 0; i < p_sqs->link_count; i++) {
+        if ((p_sqs->links[i].notify_enabled & SQS_NOTIFY_BIT(notify_char)) != 0)
+            count++;
+    }
+    return count;
+}
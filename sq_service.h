@@ -5,23 +5,62 @@
 #include <stdbool.h>
 #include "ble.h"
 #include "ble_srv_common.h"
+#include "custom_board.h"
+#include "my_time_manager.h"
 
 #define BLE_BASE_UUID_SQ_SERVICE     {(uint8_t)0x45, (uint8_t)0x56, (uint8_t)0x74, (uint8_t)0x46, \
                                       (uint8_t)0x0a, (uint8_t)0xbf, (uint8_t)0x48, (uint8_t)0x11, \
                                       (uint8_t)0x98, (uint8_t)0x32, (uint8_t)0x95, (uint8_t)0x2e, \
-                                      (uint8_t)0x90, (uint8_t)0x8e, (uint8_t)0xbb, (uint8_t)0xcc};
+                                      (uint8_t)0x90, (uint8_t)0x8e, (uint8_t)0xbb, (uint8_t)0xcc}
 
 #define BLE_UUID_SQ_SERVICE     (0x7446)     /*    https://www.uuidgenerator.net/ 
                                                 45567446-0abf-4811-9832-952e908ebbcc
                                             */
 
+/// Size of one input event in notification: 3 bytes of RTC ticks, input_reg, event code
+#define SQS_INPUT_EVT_SIZE          5
+/// Max count of input events in one notification, first byte of notification is sequence number
+#define SQS_INPUT_EVT_MAX_COUNT     ((GATT_MTU_SIZE_DEFAULT - 3 - 1) / SQS_INPUT_EVT_SIZE)
+#define SQS_INPUT_EVT_MAX_LEN       (1 + SQS_INPUT_EVT_MAX_COUNT * SQS_INPUT_EVT_SIZE)
+
+/// Max length of boot diagnostic value, it is read by long read
+#define SQS_BOOT_DIAG_MAX_LEN       64
+/// Max length of trace diagnostic value, it is read by long read
+#define SQS_TRACE_DIAG_MAX_LEN      512
+/// Max length of statistics value, see my_stats_manager.h
+#define SQS_STATS_MAX_LEN           256
+
+/// Value of ADC: mV, then stamp of sample, see my_time_manager.h
+#define SQS_ADC_LEN                 (sizeof(uint16_t) + TIME_STAMP_SIZE)
+/// Value of RSSI: dBm, then stamp of measurement
+#define SQS_RSSI_LEN                (sizeof(uint8_t) + TIME_STAMP_SIZE)
+
+/// Max count of connected centrals, service keeps state of every link
+#define SQS_LINK_MAX                PERIPHERAL_LINK_MAX
+
+
+/**
+    @brief Characteristics with notification, bit of characteristic in state of link
+*/
+typedef enum
+{
+    SQS_NOTIFY_IN = 0,                                           /**< Input register, value is shared by links */
+    SQS_NOTIFY_ADC,                                              /**< ADC value, value is shared by links */
+    SQS_NOTIFY_RSSI,                                             /**< RSSI, every link has own value */
+    SQS_NOTIFY_IN_EVT,                                           /**< Input events, they are resent from FIFO of handler */
+    SQS_NOTIFY_TIME_SYNC,                                        /**< Reply to sync of time, it is sent only to writer */
+    SQS_NOTIFY_COUNT
+} sqs_notify_char_t;
+
+#define SQS_NOTIFY_BIT(CHAR)        ((uint8_t)(1U << (CHAR)))
+
 /**
     @brief sq service event type. 
 */
 typedef enum
 {
-    BLE_SQ_EVT_NOTIFICATION_ENABLED,                             /**< Battery value notification enabled event. */
-    BLE_SQ_EVT_NOTIFICATION_DISABLED                             /**< Battery value notification disabled event. */
+    BLE_SQ_EVT_NOTIFICATION_ENABLED,                             /**< Central enabled notification of characteristic. */
+    BLE_SQ_EVT_NOTIFICATION_DISABLED                             /**< Central disabled notification or disconnected. */
 } ble_sq_evt_type_t;
 
 /**
@@ -30,8 +69,20 @@ typedef enum
 typedef struct
 {
     ble_sq_evt_type_t evt_type;                                  /**< Type of event. */
+    sqs_notify_char_t notify_char;                               /**< Characteristic, which CCCD is changed. */
+    uint16_t          conn_handle;                               /**< Link of central. */
 } ble_sq_evt_t;
 
+/**@brief State of one connected central. */
+typedef struct
+{
+    uint16_t                      conn_handle;                    /**< Handle of connection. */
+    uint8_t                       reg_rssi[SQS_RSSI_LEN];         /**< Last RSSI of this link with stamp, it is notified only to this link */
+    uint8_t                       notify_enabled;                 /**< SQS_NOTIFY_BIT of characteristics with enabled CCCD */
+    uint8_t                       notify_pending;                 /**< SQS_NOTIFY_BIT of values, which wait for free TX buffer of this link */
+    uint32_t                      input_evt_tail;                 /**< Index of first input event, which isn't sent to this link, see sq_service_handler.c */
+} ble_sq_link_t;
+
 // Forward declaration of the ble_sq_t type.
 typedef struct ble_sq_s ble_sq_t;
 
@@ -48,8 +99,11 @@ typedef struct
     uint8_t                       out_reg1_value;                 /**< Initial values of output registers */
     uint8_t                       out_reg2_value;                 /**< Initial values of output registers */
     uint8_t                       in_reg_value;                 /**< Initial values of output registers */
-    uint8_t                       adc_reg_value;                 /**< Initial values of output registers */
+    uint16_t                      adc_reg_value;                 /**< Initial values of output registers */
+    uint16_t                      adc_interval_value;             /**< Initial interval of ADC measurements, ms */
     uint8_t                       rssi_reg_value;                 /**< Initial values of output registers */
+    uint8_t *                     p_trace_diag;                   /**< Trace of previous run, value stays in application memory, NULL if trace is off */
+    uint16_t                      trace_diag_len;                 /**< Length of trace of previous run */
     ble_srv_cccd_security_mode_t  sq_level_char_attr_md;     /**< Initial security level for sq characteristics attribute */
     ble_gap_conn_sec_mode_t       sq_level_report_read_perm; /**< Initial security level for sq report read attribute */
 } ble_sq_init_t;
@@ -67,13 +121,20 @@ struct ble_sq_s
     ble_gatts_char_handles_t      sqs_reg_in_handles;              /**< Handles related to the characteristics. */
     ble_gatts_char_handles_t      sqs_adc_handles;              /**< Handles related to the characteristics. */
     ble_gatts_char_handles_t      sqs_rssi_handles;              /**< Handles related to the characteristics. */
+    ble_gatts_char_handles_t      sqs_input_evt_handles;         /**< Handles related to the characteristics. */
+    ble_gatts_char_handles_t      sqs_boot_diag_handles;         /**< Handles related to the characteristics. */
+    ble_gatts_char_handles_t      sqs_trace_diag_handles;        /**< Handles related to the characteristics. */
+    ble_gatts_char_handles_t      sqs_stats_handles;             /**< Handles related to the characteristics. */
+    ble_gatts_char_handles_t      sqs_time_sync_handles;         /**< Handles related to the characteristics. */
+    ble_gatts_char_handles_t      sqs_adc_interval_handles;      /**< Handles related to the characteristics. */
         
     uint8_t                       reg_out1;                       /**< Last value of registers */
     uint8_t                       reg_out2;                       /**< Last value of registers */
     uint8_t                       reg_in;                         /**< Last value of registers */
     uint16_t                      reg_adc;                        /**< Last value of registers */
-    uint8_t                       reg_rssi;                       /**< Last value of registers */
-    uint16_t                      conn_handle;                    /**< Handle of the current connection (as provided by the BLE stack, is BLE_CONN_HANDLE_INVALID if not in a connection). */    
+    uint16_t                      adc_interval;                   /**< Interval of ADC measurements in database, ms */
+    ble_sq_link_t                 links[SQS_LINK_MAX];            /**< Connected centrals, they are packed at start of array */
+    uint8_t                       link_count;                     /**< Count of connected centrals */
 };
 
 
@@ -81,7 +142,13 @@ uint32_t ble_sqs_init(ble_sq_t * p_sqs, ble_sq_init_t * p_sqs_init);
 
 void ble_sqs_on_ble_evt(ble_sq_t * p_sqs, ble_evt_t * p_ble_evt);
 
-uint32_t sqs_update_adc_characteristic(ble_sq_t * p_sqs, uint16_t adc_value);
+uint32_t sqs_update_out_reg1_characteristic(ble_sq_t * p_sqs, uint8_t value);
+uint32_t sqs_update_adc_characteristic(ble_sq_t * p_sqs, uint16_t adc_value, uint64_t ticks);
+uint32_t sqs_update_adc_interval_characteristic(ble_sq_t * p_sqs, uint16_t interval_ms);
 uint32_t sqs_update_input_characteristic(ble_sq_t * p_sqs, uint8_t value);
-uint32_t sqs_update_rssi_characteristic(ble_sq_t * p_sqs, uint8_t value);
+uint32_t sqs_update_rssi_characteristic(ble_sq_t * p_sqs, uint16_t conn_handle, uint8_t value, uint64_t ticks);
+uint32_t sqs_send_input_events(ble_sq_t * p_sqs, uint16_t conn_handle, uint8_t * p_data, uint16_t len);
+ble_sq_link_t * sqs_link_get(ble_sq_t * p_sqs, uint16_t conn_handle);
+uint8_t sqs_notify_count(ble_sq_t const * p_sqs, sqs_notify_char_t notify_char);
+uint32_t sqs_update_boot_diag_characteristic(ble_sq_t * p_sqs, uint8_t * p_data, uint16_t len);
 #endif